@@ -1,34 +1,34 @@
 //#pragma once
 //
 ///*!
-// *	\biref	 ޽  ޽ Ѵ.
+// *	\biref	두 메쉬의 합집합 메쉬를 계산한다.
 // *
-// *	\param	A[in]			ù ° ޽
-// *	\param	B[in]			 ° ޽
-// *	\param	Fairing[in]		 ,  Fairing 
+// *	\param	A[in]			첫 번째 메쉬
+// *	\param	B[in]			두 번째 메쉬
+// *	\param	Fairing[in]		연산 후, 교차영역의 Fairing 여부
 // *
-// *	\return	 ޽  ޽ ȯѴ.
+// *	\return	두 메쉬의 합집합 메쉬를 반환한다.
 // */
 //DgVolume* DgBooleanUnion(const DgMesh& A, const DgMesh& B, bool Fairing);
 //
 ///*!
-// *	\biref	 ޽  ޽ Ѵ.
+// *	\biref	두 메쉬의 교집합 메쉬를 계산한다.
 // *
-// *	\param	A[in]			ù ° ޽
-// *	\param	B[in]			 ° ޽
-// *	\param	Fairing[in]		 ,  Fairing 
+// *	\param	A[in]			첫 번째 메쉬
+// *	\param	B[in]			두 번째 메쉬
+// *	\param	Fairing[in]		연산 후, 교차영역의 Fairing 여부
 // *
-// *	\return	 ޽  ޽ ȯѴ.
+// *	\return	두 메쉬의 교집합 메쉬를 반환한다.
 // */
 //DgVolume* DgBooleanIntersection(const DgMesh& A, const DgMesh& B, bool Fairing);
 //
 ///*!
-// *	\biref	 ޽ (A - B) ޽ Ѵ.
+// *	\biref	두 메쉬의 차집합(A - B) 메쉬를 계산한다.
 // *
-// *	\param	A[in]			ù ° ޽
-// *	\param	B[in]			 ° ޽
-// *	\param	Fairing[in]		 ,  Fairing 
+// *	\param	A[in]			첫 번째 메쉬
+// *	\param	B[in]			두 번째 메쉬
+// *	\param	Fairing[in]		연산 후, 교차영역의 Fairing 여부
 // *
-// *	\return	 ޽  ޽ ȯѴ.
+// *	\return	두 메쉬의 차집합 메쉬를 반환한다.
 // */
 //DgVolume* DgBooleanDifference(const DgMesh& A, const DgMesh& B, bool Fairing);
\ No newline at end of file
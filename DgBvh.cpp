@@ -1,241 +1,1348 @@
 #include "DgViewer.h"
 
-using Dist2BV = std::pair<double, DgBvh::AaBb*>; // Ÿ, 
+using Dist2Ref = std::pair<double, int>; // 거리, 자식 참조(0 이상: 노드, 음수: 리프 슬롯)
 
-/********************/
-/* AaBb Ŭ  */
-/********************/
-DgBvh::AaBb::AaBb()
+/*!
+*	\brief	double 좌표를 내림하여 float로 변환(경계 상자의 최소 좌표용)
+*/
+static float round_down(double x)
 {
-	mMesh = NULL;
-	mMin = DgPos(DBL_MAX, DBL_MAX, DBL_MAX);
-	mMax = DgPos(-DBL_MAX, -DBL_MAX, -DBL_MAX);
-	mDepth = -1;
-	mIsLeaf = false;
+	float f = (float)x;
+	return ((double)f > x) ? std::nextafter(f, -FLT_MAX) : f;
 }
 
-DgBvh::AaBb::AaBb(DgMesh* pMesh, std::vector<DgFace*>& Faces, const int Depth)
+/*!
+*	\brief	double 좌표를 올림하여 float로 변환(경계 상자의 최대 좌표용)
+*/
+static float round_up(double x)
 {
-	//  ޽ ﰢ Ʈ Ѵ.
-	mMesh = pMesh;
-	mFaces = Faces;
+	float f = (float)x;
+	return ((double)f < x) ? std::nextafter(f, FLT_MAX) : f;
+}
 
-	// ﰢ Ʈ ϴ AaBb Ÿ  ڸ Ѵ.
-	mMin = DgPos(DBL_MAX, DBL_MAX, DBL_MAX);
-	mMax = DgPos(-DBL_MAX, -DBL_MAX, -DBL_MAX);
-	for (DgFace* f : mFaces)
+/*!
+*	\brief	점과 노드의 4개 자식 경계 상자 사이의 최단 거리 제곱을 계산
+*	\note	점이 경계 상자 내부에 포함되었다면 0을 반환
+*			바깥쪽으로 반올림된 float 경계를 double로 넓혀 계산하므로 거리 하한을 과대 추정하지 않음
+*/
+static void box_sqr_dist4(const DgBvh::Node& node, const DgPos& p, double d[4])
+{
+	for (int c = 0; c < 4; ++c)
 	{
-		for (int i = 0; i < 3; ++i)
+		double dx = MAX(MAX((double)node.mMin[0][c] - p[0], p[0] - (double)node.mMax[0][c]), 0.0);
+		double dy = MAX(MAX((double)node.mMin[1][c] - p[1], p[1] - (double)node.mMax[1][c]), 0.0);
+		double dz = MAX(MAX((double)node.mMin[2][c] - p[2], p[2] - (double)node.mMax[2][c]), 0.0);
+		d[c] = dx * dx + dy * dy + dz * dz;
+	}
+}
+
+/*!
+*	\brief	거리 제곱이 bound 이하인 자식을 먼 순서로 스택에 추가(가장 가까운 자식이 스택의 top)
+*	\return	추가 후 스택의 크기를 반환
+*/
+static int push_children_sorted(const DgBvh::Node& node, int nodeIdx, const double d[4], double bound, Dist2Ref* stack, int top)
+{
+	// 방문할 자식을 모으고
+	Dist2Ref child[4];
+	int n = 0;
+	for (int c = 0; c < 4; ++c)
+	{
+		if (d[c] > bound)
+			continue;
+		if (node.mChild[c] >= 0)
+			child[n++] = Dist2Ref(d[c], node.mChild[c]);
+		else if (node.mCount[c] > 0)
+			child[n++] = Dist2Ref(d[c], -(nodeIdx * 4 + c) - 1);
+	}
+
+	// 거리의 내림차순으로 삽입 정렬하여 스택에 넣는다.
+	for (int i = 1; i < n; ++i)
+	{
+		Dist2Ref x = child[i];
+		int j = i - 1;
+		while (j >= 0 && child[j].first < x.first)
 		{
-			DgPos p = f->getVertexPos(i);
-			mMin[0] = MIN(mMin[0], p[0]);
-			mMin[1] = MIN(mMin[1], p[1]);
-			mMin[2] = MIN(mMin[2], p[2]);
-			mMax[0] = MAX(mMax[0], p[0]);
-			mMax[1] = MAX(mMax[1], p[1]);
-			mMax[2] = MAX(mMax[2], p[2]);
+			child[j + 1] = child[j];
+			--j;
 		}
+		child[j + 1] = x;
 	}
+	for (int i = 0; i < n; ++i)
+		stack[top++] = child[i];
+	return top;
+}
 
-	//    θ Ѵ.
-	mDepth = Depth;
-	mIsLeaf = (mDepth == MAX_BVH_DEPTH || Faces.size() < 6) ? true : false;
+/*!
+*	\brief	10비트 정수의 비트 사이에 0을 두 개씩 끼워 넣음(모튼 코드용)
+*/
+static unsigned int expand_bits10(unsigned int v)
+{
+	v = (v * 0x00010001u) & 0xFF0000FFu;
+	v = (v * 0x00000101u) & 0x0F00F00Fu;
+	v = (v * 0x00000011u) & 0xC30C30C3u;
+	v = (v * 0x00000005u) & 0x49249249u;
+	return v;
+}
 
-	//  尡 ƴ϶   ڸ 4 Ѵ.
-	if (!mIsLeaf)
-		divide();
+/*!
+*	\brief	21비트 정수의 비트 사이에 0을 두 개씩 끼워 넣음(63비트 모튼 코드용)
+*/
+static unsigned long long expand_bits21(unsigned long long v)
+{
+	v &= 0x1FFFFFull;
+	v = (v | (v << 32)) & 0x1F00000000FFFFull;
+	v = (v | (v << 16)) & 0x1F0000FF0000FFull;
+	v = (v | (v << 8)) & 0x100F00F00F00F00Full;
+	v = (v | (v << 4)) & 0x10C30C30C30C30C3ull;
+	v = (v | (v << 2)) & 0x1249249249249249ull;
+	return v;
 }
 
-DgBvh::AaBb::~AaBb()
+/*!
+*	\brief	[0, 1]^3 범위의 좌표에 대한 63비트 모튼 코드를 계산
+*/
+static unsigned long long morton_code63(double x, double y, double z)
 {
-	for (AaBb* pNode : mChildNodes)
-		delete pNode;
+	const double scale = (double)(1 << 21);
+	unsigned long long ix = (unsigned long long)MIN(MAX(x * scale, 0.0), scale - 1.0);
+	unsigned long long iy = (unsigned long long)MIN(MAX(y * scale, 0.0), scale - 1.0);
+	unsigned long long iz = (unsigned long long)MIN(MAX(z * scale, 0.0), scale - 1.0);
+	return (expand_bits21(ix) << 2) | (expand_bits21(iy) << 1) | expand_bits21(iz);
 }
 
-void DgBvh::AaBb::divide()
+/*!
+*	\brief	64비트 정수의 최상위 비트부터 연속된 0의 개수(0이면 64)
+*/
+static int count_leading_zeros(unsigned long long x)
 {
-	//     ̸ Ͽ
-	double dx = mMax[0] - mMin[0];
-	double dy = mMax[1] - mMin[1];
-	double dz = mMax[2] - mMin[2];
+	if (x == 0)
+		return 64;
+	int n = 0;
+	if ((x >> 32) == 0) { n += 32; x <<= 32; }
+	if ((x >> 48) == 0) { n += 16; x <<= 16; }
+	if ((x >> 56) == 0) { n += 8; x <<= 8; }
+	if ((x >> 60) == 0) { n += 4; x <<= 4; }
+	if ((x >> 62) == 0) { n += 2; x <<= 2; }
+	if ((x >> 63) == 0) { n += 1; }
+	return n;
+}
 
-	//   (axis0, axis1) ߽(c0, c1) Ѵ.
-	int axis0 = 1, axis1 = 2;
-	if (dy < dx && dy < dz)
+/*!
+*	\brief	(키, 값) 쌍을 키의 하위 numBits 비트에 대하여 8비트 단위 LSD 기수 정렬(안정 정렬)
+*	\note	스레드별로 연속 구간의 히스토그램을 구한 후, (자릿값, 스레드) 순서의 누적합으로 분산 위치를 정함
+*/
+static void radix_sort_pairs(std::vector<unsigned long long>& keys, std::vector<int>& vals, int numBits)
+{
+	int n = NUM(keys);
+	int maxThreads = omp_get_max_threads();
+	std::vector<unsigned long long> tmpKeys(n);
+	std::vector<int> tmpVals(n);
+	std::vector<int> hist(maxThreads * 256);
+	for (int shift = 0; shift < numBits; shift += 8)
 	{
-		axis0 = 2;
-		axis1 = 0;
+		std::fill(hist.begin(), hist.end(), 0);
+#pragma omp parallel num_threads(maxThreads)
+		{
+			int tid = omp_get_thread_num();
+			int nt = omp_get_num_threads();
+			int i0 = (int)((long long)n * tid / nt);
+			int i1 = (int)((long long)n * (tid + 1) / nt);
+			int* h = &hist[tid * 256];
+			for (int i = i0; i < i1; ++i)
+				h[(keys[i] >> shift) & 255]++;
+#pragma omp barrier
+#pragma omp single
+			{
+				int offset = 0;
+				for (int digit = 0; digit < 256; ++digit)
+				{
+					for (int t = 0; t < nt; ++t)
+					{
+						int cnt = hist[t * 256 + digit];
+						hist[t * 256 + digit] = offset;
+						offset += cnt;
+					}
+				}
+			}
+			for (int i = i0; i < i1; ++i)
+			{
+				int pos = h[(keys[i] >> shift) & 255]++;
+				tmpKeys[pos] = keys[i];
+				tmpVals[pos] = vals[i];
+			}
+		}
+		keys.swap(tmpKeys);
+		vals.swap(tmpVals);
 	}
-	else if (dz < dx && dz < dy)
+}
+
+/*!
+*	\brief	[0, 1]^3 범위의 좌표에 대한 30비트 모튼 코드를 계산
+*/
+static unsigned int morton_code30(double x, double y, double z)
+{
+	unsigned int ix = (unsigned int)MIN(MAX(x * 1024.0, 0.0), 1023.0);
+	unsigned int iy = (unsigned int)MIN(MAX(y * 1024.0, 0.0), 1023.0);
+	unsigned int iz = (unsigned int)MIN(MAX(z * 1024.0, 0.0), 1023.0);
+	return (expand_bits10(ix) << 2) | (expand_bits10(iy) << 1) | expand_bits10(iz);
+}
+
+/*!
+*	\struct	RayData
+*	\brief	watertight 광선/삼각형 교차와 광선/상자 교차를 위해 미리 계산한 광선 정보
+*/
+struct RayData
+{
+	double org[3], dir[3], inv[3];
+	int kx, ky, kz;
+	double Sx, Sy, Sz;
+};
+
+/*!
+*	\brief	광선의 역방향과 watertight 교차를 위한 축 순서(kz: 방향 성분이 가장 큰 축)와 전단 계수를 계산
+*/
+static void init_ray(RayData& r, const DgPos& org, const DgVec3& dir)
+{
+	for (int a = 0; a < 3; ++a)
 	{
-		axis0 = 0;
-		axis1 = 1;
+		r.org[a] = org[a];
+		r.dir[a] = dir[a];
+		r.inv[a] = 1.0 / dir[a];
 	}
-	double c0 = (mMin[axis0] + mMax[axis0]) / 2.0;
-	double c1 = (mMin[axis1] + mMax[axis1]) / 2.0;
-
-	// ﰢ Ʈ 4  Ѵ.
-	std::vector<DgFace*> Faces0;
-	std::vector<DgFace*> Faces1;
-	std::vector<DgFace*> Faces2;
-	std::vector<DgFace*> Faces3;
-	for (DgFace* f : mFaces)
-	{
-		DgPos p = f->getVertexPos(0);
-		if (p[axis0] <= c0 && p[axis1] <= c1)
-			Faces0.push_back(f);
-		else if (p[axis0] > c0 && p[axis1] <= c1)
-			Faces1.push_back(f);
-		else if (p[axis0] > c0 && p[axis1] > c1)
-			Faces2.push_back(f);
-		else if (p[axis0] <= c0 && p[axis1] > c1)
-			Faces3.push_back(f);
-		else
-			printf("BVH construction error...\n");
-	}
-
-	// 4     ڸ Ѵ.
-	mChildNodes.push_back(new AaBb(mMesh, Faces0, mDepth + 1));
-	mChildNodes.push_back(new AaBb(mMesh, Faces1, mDepth + 1));
-	mChildNodes.push_back(new AaBb(mMesh, Faces2, mDepth + 1));
-	mChildNodes.push_back(new AaBb(mMesh, Faces3, mDepth + 1));
+	r.kz = (ABS(dir[0]) > ABS(dir[1])) ? ((ABS(dir[0]) > ABS(dir[2])) ? 0 : 2) : ((ABS(dir[1]) > ABS(dir[2])) ? 1 : 2);
+	r.kx = (r.kz + 1) % 3;
+	r.ky = (r.kx + 1) % 3;
+	if (dir[r.kz] < 0.0)
+		std::swap(r.kx, r.ky);
+	r.Sx = dir[r.kx] / dir[r.kz];
+	r.Sy = dir[r.ky] / dir[r.kz];
+	r.Sz = 1.0 / dir[r.kz];
 }
 
-double DgBvh::AaBb::getSqrDist(const DgPos& p)
+/*!
+*	\brief	광선과 삼각형(p0, p1, p2)의 watertight 교차(Woop, Benthin, Wald 2013)
+*	\return	(0, tmax] 구간에서 교차하면 true를 반환하고 t에 광선 파라미터를 저장
+*/
+static bool intersect_ray_tri(const RayData& r, const DgPos& p0, const DgPos& p1, const DgPos& p2, double tmax, double& t)
 {
-	DgPos Mid = ::lerp(mMin, mMax, 0.5);
-	double dx = ABS(Mid[0] - p[0]) - (mMax[0] - mMin[0]) / 2.0;
-	double dy = ABS(Mid[1] - p[1]) - (mMax[1] - mMin[1]) / 2.0;
-	double dz = ABS(Mid[2] - p[2]) - (mMax[2] - mMin[2]) / 2.0;
-	bool bx = (dx < 0.0) ? true : false;
-	bool by = (dy < 0.0) ? true : false;
-	bool bz = (dz < 0.0) ? true : false;
+	// 광선 시작점 기준의 정점을 광선 방향이 +z가 되도록 전단 변환한다.
+	double A[3], B[3], C[3];
+	for (int a = 0; a < 3; ++a)
+	{
+		A[a] = p0[a] - r.org[a];
+		B[a] = p1[a] - r.org[a];
+		C[a] = p2[a] - r.org[a];
+	}
+	double Ax = A[r.kx] - r.Sx * A[r.kz], Ay = A[r.ky] - r.Sy * A[r.kz];
+	double Bx = B[r.kx] - r.Sx * B[r.kz], By = B[r.ky] - r.Sy * B[r.kz];
+	double Cx = C[r.kx] - r.Sx * C[r.kz], Cy = C[r.ky] - r.Sy * C[r.kz];
 
-	//    ̶ 0 ȯѴ.
-	if (bx && by && bz)
-		return 0.0;
+	// 에지 함수의 부호가 섞여 있으면 교차하지 않는다(0은 경계로 포함).
+	double U = Cx * By - Cy * Bx;
+	double V = Ax * Cy - Ay * Cx;
+	double W = Bx * Ay - By * Ax;
+	if ((U < 0.0 || V < 0.0 || W < 0.0) && (U > 0.0 || V > 0.0 || W > 0.0))
+		return false;
+	double det = U + V + W;
+	if (det == 0.0)
+		return false;
 
-	// Ÿ  ȯѴ.
-	dx = bx ? 0.0 : dx;
-	dy = by ? 0.0 : dy;
-	dz = bz ? 0.0 : dz;
-	return (dx * dx + dy * dy + dz * dz);
+	// 교차점의 거리를 det로 나누지 않은 채 구간 검사를 한다.
+	double T = U * r.Sz * A[r.kz] + V * r.Sz * B[r.kz] + W * r.Sz * C[r.kz];
+	if ((det > 0.0 && (T <= 0.0 || T > tmax * det)) || (det < 0.0 && (T >= 0.0 || T < tmax * det)))
+		return false;
+	t = T / det;
+	return true;
 }
 
-bool DgBvh::AaBb::intersectWithTri(const DgPos& p0, const DgPos& p1, const DgPos& p2)
+/*!
+*	\brief	광선과 노드의 4개 자식 경계 상자의 교차 구간 시작 파라미터를 계산
+*	\note	교차하지 않거나 빈 자식은 HUGE_VAL(어떤 상한보다도 큼)을 저장하며, float 상자의 오차를 고려하여 tfar를 조금 늘림
+*/
+static void ray_box4(const DgBvh::Node& node, const RayData& r, double tmax, double tnear[4])
 {
-	return ::intersect_tri_box(p0, p1, p2, mMin, mMax);
+	for (int c = 0; c < 4; ++c)
+	{
+		double t0 = 0.0, t1 = tmax;
+		for (int a = 0; a < 3; ++a)
+		{
+			double tn = (node.mMin[a][c] - r.org[a]) * r.inv[a];
+			double tf = (node.mMax[a][c] - r.org[a]) * r.inv[a];
+			if (tn > tf)
+				std::swap(tn, tf);
+			tf *= 1.0 + 1.0e-12;
+
+			// 방향 성분이 0이고 시작점이 슬랩 경계에 놓이면 NaN이 되므로 비교식으로 무시한다.
+			t0 = (tn > t0) ? tn : t0;
+			t1 = (tf < t1) ? tf : t1;
+		}
+		tnear[c] = (t0 <= t1 && !(node.mChild[c] < 0 && node.mCount[c] == 0)) ? t0 : HUGE_VAL;
+	}
 }
 
 /*********************/
-/* DgBvh Ŭ  */
+/* DgBvh 클래스 구현 */
 /*********************/
 DgBvh::DgBvh()
 {
 	mMesh = NULL;
-	mRoot = NULL;
 	mCopy = false;
+	mBuildType = BUILD_MIDPOINT;
+	mDepth = 0;
+	mBuildCost = mCost = 0.0;
 }
 
-DgBvh::DgBvh(DgMesh* pMesh)
+DgBvh::DgBvh(DgMesh* pMesh, TypeBuild type)
 {
 	clock_t st = clock();
 	mMesh = pMesh;
-	//mRoot = new AaBb(pMesh, pMesh->mFaces, 0);
-	std::vector<DgFace*> facePtrs;
-	for (auto& f : pMesh->mFaces)
-		facePtrs.push_back(&f);
-	mRoot = new AaBb(pMesh, facePtrs, 0);
+	mBuildType = (NUM(pMesh->mFaces) >= BVH_LBVH_THRESHOLD) ? BUILD_LBVH : type;
+	mFaceIdxs.resize(pMesh->mFaces.size());
+	std::iota(mFaceIdxs.begin(), mFaceIdxs.end(), 0);
+	build();
+	updatePseudoNormals();
 	mCopy = false;
 	clock_t ed = clock();
 	//printf("BVH construction time = %u ms \n", ed - st);
 }
 
-DgBvh::DgBvh(std::vector<DgFace*>& subFaces)
+DgBvh::DgBvh(DgMesh* pMesh, const char* cacheFile, TypeBuild type)
+{
+	mMesh = pMesh;
+	mCopy = false;
+	mBuildType = (NUM(pMesh->mFaces) >= BVH_LBVH_THRESHOLD) ? BUILD_LBVH : type;
+
+	// 유효한 캐시가 있다면 그대로 사용하고
+	bool bCache = (cacheFile != NULL && cacheFile[0] != '\0');
+	if (bCache && load(cacheFile))
+	{
+		updatePseudoNormals();
+		return;
+	}
+
+	// 없거나 오래되었다면 새로 생성하여 저장한다.
+	mFaceIdxs.resize(pMesh->mFaces.size());
+	std::iota(mFaceIdxs.begin(), mFaceIdxs.end(), 0);
+	build();
+	updatePseudoNormals();
+	if (bCache && !save(cacheFile))
+		printf("Failed to write BVH cache: %s\n", cacheFile);
+}
+
+DgBvh::DgBvh(DgMesh* pMesh, std::vector<DgFace*>& subFaces, TypeBuild type)
 {
-	mMesh = subFaces.front()->getMesh();
-	mRoot = new AaBb(mMesh, subFaces, 0);
+	mMesh = pMesh;
+	mBuildType = (NUM(subFaces) >= BVH_LBVH_THRESHOLD) ? BUILD_LBVH : type;
+	for (DgFace* f : subFaces)
+		mFaceIdxs.push_back(getFaceIdx(f));
+	build();
+	updatePseudoNormals();
 	mCopy = false;
 }
 
 DgBvh::DgBvh(std::vector<DgPos>& Verts, std::vector<int>& Faces)
 {
-	// ޽  Ͽ
+	// 메쉬를 직접 생성하여
 	mCopy = true;
+	mBuildType = BUILD_MIDPOINT;
 	mMesh = new DgMesh();
 	mMesh->mName = "Target Mesh";
 
-	//  ߰Ѵ.
+	// 정점과 삼각형을 인덱스 배열로 추가한다.
+	mMesh->mVerts.reserve(Verts.size());
 	for (DgPos& p : Verts)
-		mMesh->addVertex(::create_vertex(p[0], p[1], p[2]));
-
-	// ﰢ ߰Ѵ.
-	for (int i = 0; i < (int)Faces.size(); i += 3)
-	{
-		DgVertex* v0 = &mMesh->mVerts[Faces[i]];
-		DgVertex* v1 = &mMesh->mVerts[Faces[i + 1]];
-		DgVertex* v2 = &mMesh->mVerts[Faces[i + 2]];
-		mMesh->addFace(::create_face(v0, v1, v2));
-	}
-
-	// ޽   ʱȭ Ѵ.
-	mMesh->updateEdgeMate();
+		mMesh->mVerts.emplace_back(p[0], p[1], p[2]);
+	mMesh->mFaces.reserve(Faces.size() / 3);
+	for (int i = 0; i + 2 < (int)Faces.size(); i += 3)
+		mMesh->mFaces.emplace_back(Faces[i], Faces[i + 1], Faces[i + 2], -1, -1, -1, -1);
 	mMesh->updateBndBox();
-	mMesh->updateNormal(DgMesh::NORMAL_FACE);
 
-	// BVH Ѵ.
+	// BVH를 생성한다.
 	clock_t st = clock();
-	//mRoot = new AaBb(mMesh, mMesh->mFaces, 0);
-	std::vector<DgFace*> facePtrs;
-	for (auto& f : mMesh->mFaces)
-		facePtrs.push_back(&f);
-	mRoot = new AaBb(mMesh, facePtrs, 0);
+	mFaceIdxs.resize(mMesh->mFaces.size());
+	std::iota(mFaceIdxs.begin(), mFaceIdxs.end(), 0);
+	build();
+	updatePseudoNormals();
 	clock_t ed = clock();
 	printf("BVH construction time = %u ms \n", ed - st);
 }
 
 DgBvh::~DgBvh()
 {
-	if (mRoot != NULL)
-		delete mRoot;
-	mRoot = NULL;
-
 	if (mCopy)
 		delete mMesh;
 	mMesh = NULL;
 }
 
+void DgBvh::build()
+{
+	mNodes.clear();
+	mDipoles.clear();
+	mLevels.clear();
+
+	// 삼각형이 적다면 하나의 리프만 갖는 루트 노드를 생성한다.
+	int numFaces = (int)mFaceIdxs.size();
+	if (numFaces < 6)
+	{
+		mNodes.emplace_back();
+		mDipoles.resize(4);
+		setChild(mNodes, mDipoles, 0, 0, 0, numFaces, -1);
+		for (int c = 1; c < 4; ++c)
+			setChild(mNodes, mDipoles, 0, c, numFaces, 0, -1);
+	}
+	else if (mBuildType == BUILD_MIDPOINT)
+		buildMidpoint(0, numFaces, 0);
+	else if (mBuildType == BUILD_LBVH)
+		buildLBVH();
+	else
+	{
+		// 삼각형별 경계 상자와 무게중심을 구한다.
+		std::vector<float> bounds(9 * mMesh->mFaces.size());
+#pragma omp parallel for
+		for (int i = 0; i < numFaces; ++i)
+		{
+			DgFace* f = getFace(i);
+			float* b = &bounds[9 * mFaceIdxs[i]];
+			DgPos p0, p1, p2;
+			getFacePos(f, p0, p1, p2);
+			for (int a = 0; a < 3; ++a)
+			{
+				b[a] = (float)MIN(p0[a], MIN(p1[a], p2[a]));
+				b[3 + a] = (float)MAX(p0[a], MAX(p1[a], p2[a]));
+				b[6 + a] = (float)((p0[a] + p1[a] + p2[a]) / 3.0);
+			}
+		}
+
+		// 상위 레벨은 직렬로 생성하고, grain개 이하의 삼각형을 갖는 하위 트리는 지연시켜
+		int numThreads = omp_get_max_threads();
+		int grain = MAX(numFaces / (numThreads * 8), 1024);
+		std::vector<int> pending;
+		buildSAH(mNodes, mDipoles, 0, numFaces, bounds, &pending, grain);
+
+		// 지연된 하위 트리를 스레드별로 독립된 배열에 병렬로 생성한 후
+		int numTasks = (int)pending.size() / 3;
+		std::vector<std::vector<Node>> subNodes(numTasks);
+		std::vector<std::vector<Dipole>> subDipoles(numTasks);
+#pragma omp parallel for schedule(dynamic, 1) num_threads(numThreads)
+		for (int t = 0; t < numTasks; ++t)
+			buildSAH(subNodes[t], subDipoles[t], pending[3 * t + 1], pending[3 * t + 2], bounds, NULL, 0);
+
+		// 전체 노드 배열에 이어 붙이고 부모의 자식 참조를 연결한다.
+		for (int t = 0; t < numTasks; ++t)
+		{
+			int offset = NUM(mNodes);
+			for (Node& node : subNodes[t])
+				for (int c = 0; c < 4; ++c)
+					if (node.mChild[c] >= 0)
+						node.mChild[c] += offset;
+			mNodes.insert(mNodes.end(), subNodes[t].begin(), subNodes[t].end());
+			mDipoles.insert(mDipoles.end(), subDipoles[t].begin(), subDipoles[t].end());
+
+			int slot = pending[3 * t];
+			mNodes[slot >> 2].mChild[slot & 3] = offset;
+		}
+
+		// 하위 트리가 연속된 깊이 우선 순서가 되도록 재배열한다.
+		if (numTasks > 0)
+			relinearize();
+	}
+
+	// 최단 거리 탐색의 고정 크기 스택(3 * 깊이 + 1)을 넘는 트리라면 깊이가 제한된 중점 분할로 다시 생성한다.
+	mDepth = computeDepth();
+	if (3 * mDepth + 1 > BVH_STACK_SIZE)
+	{
+		printf("BVH depth %d exceeds the traversal stack, rebuilding with midpoint split\n", mDepth);
+		mBuildType = BUILD_MIDPOINT;
+		build();
+		return;
+	}
+
+	// 전체 경계 상자와 refit 판정의 기준이 되는 SAH 비용을 구한다.
+	updateBndBox();
+	mBuildCost = mCost = computeCost();
+}
+
+void DgBvh::updateBndBox()
+{
+	const Node& root = mNodes[0];
+	mMin = DgPos(DBL_MAX, DBL_MAX, DBL_MAX);
+	mMax = DgPos(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+	for (int c = 0; c < 4; ++c)
+	{
+		if (root.mChild[c] < 0 && root.mCount[c] == 0)
+			continue;
+		for (int a = 0; a < 3; ++a)
+		{
+			mMin[a] = MIN(mMin[a], (double)root.mMin[a][c]);
+			mMax[a] = MAX(mMax[a], (double)root.mMax[a][c]);
+		}
+	}
+}
+
+double DgBvh::computeCost() const
+{
+	auto area = [](double dx, double dy, double dz) { return 2.0 * (dx * dy + dy * dz + dz * dx); };
+	double rootArea = area(mMax[0] - mMin[0], mMax[1] - mMin[1], mMax[2] - mMin[2]);
+	if (rootArea <= 0.0)
+		return 0.0;
+
+	double cost = 0.0;
+	for (const Node& node : mNodes)
+	{
+		for (int c = 0; c < 4; ++c)
+		{
+			if (node.mChild[c] < 0 && node.mCount[c] == 0)
+				continue;
+			double A = area(node.mMax[0][c] - node.mMin[0][c], node.mMax[1][c] - node.mMin[1][c], node.mMax[2][c] - node.mMin[2][c]);
+			cost += (node.mChild[c] >= 0) ? A : A * node.mCount[c];
+		}
+	}
+	return cost / rootArea;
+}
+
+void DgBvh::buildLBVH()
+{
+	int numFaces = NUM(mFaceIdxs);
+
+	// 삼각형 무게중심의 경계 상자를 구하여
+	std::vector<DgPos> centers(numFaces);
+#pragma omp parallel for
+	for (int i = 0; i < numFaces; ++i)
+	{
+		DgFace* f = getFace(i);
+		DgPos p0, p1, p2;
+		getFacePos(f, p0, p1, p2);
+		centers[i] = DgPos((p0[0] + p1[0] + p2[0]) / 3.0, (p0[1] + p1[1] + p2[1]) / 3.0, (p0[2] + p1[2] + p2[2]) / 3.0);
+	}
+	double cmin[3] = { DBL_MAX, DBL_MAX, DBL_MAX };
+	double cmax[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+	for (const DgPos& c : centers)
+	{
+		for (int a = 0; a < 3; ++a)
+		{
+			cmin[a] = MIN(cmin[a], c[a]);
+			cmax[a] = MAX(cmax[a], c[a]);
+		}
+	}
+
+	// 모튼 코드를 계산하고(2^20개 이하는 30비트, 그 이상은 63비트) 삼각형 인덱스와 함께 기수 정렬한다.
+	int numBits = (numFaces <= (1 << 20)) ? 30 : 63;
+	std::vector<unsigned long long> codes(numFaces);
+#pragma omp parallel for
+	for (int i = 0; i < numFaces; ++i)
+	{
+		double x[3];
+		for (int a = 0; a < 3; ++a)
+			x[a] = (cmax[a] > cmin[a]) ? (centers[i][a] - cmin[a]) / (cmax[a] - cmin[a]) : 0.0;
+		codes[i] = (numBits == 30) ? morton_code30(x[0], x[1], x[2]) : morton_code63(x[0], x[1], x[2]);
+	}
+	radix_sort_pairs(codes, mFaceIdxs, numBits);
+
+	// 이진 내부 노드별 자식과 구간을 병렬로 구한다(내부 노드 i는 정렬된 구간의 한쪽 끝이 i).
+	auto delta = [&](int i, int j) {
+		if (j < 0 || j >= numFaces)
+			return -1;
+		unsigned long long x = codes[i] ^ codes[j];
+		return (x != 0) ? count_leading_zeros(x) : 64 + count_leading_zeros((unsigned long long)(i ^ j));
+	};
+	std::vector<int> binNodes(4 * (numFaces - 1));
+#pragma omp parallel for
+	for (int i = 0; i < numFaces - 1; ++i)
+	{
+		// 구간의 방향과 다른 쪽 끝을 찾고
+		int d = (delta(i, i + 1) - delta(i, i - 1) > 0) ? 1 : -1;
+		int dmin = delta(i, i - d);
+		int lmax = 2;
+		while (delta(i, i + lmax * d) > dmin)
+			lmax *= 2;
+		int l = 0;
+		for (int t = lmax / 2; t >= 1; t /= 2)
+			if (delta(i, i + (l + t) * d) > dmin)
+				l += t;
+		int j = i + l * d;
+
+		// 공통 접두사가 끝나는 분할 위치를 이진 탐색한다.
+		int dnode = delta(i, j);
+		int split = 0;
+		for (int div = 2; ; div *= 2)
+		{
+			int t = (l + div - 1) / div;
+			if (delta(i, i + (split + t) * d) > dnode)
+				split += t;
+			if (t == 1)
+				break;
+		}
+		int gamma = i + split * d + MIN(d, 0);
+
+		int first = MIN(i, j), last = MAX(i, j);
+		binNodes[4 * i] = (first == gamma) ? ~gamma : gamma;
+		binNodes[4 * i + 1] = (last == gamma + 1) ? ~(gamma + 1) : gamma + 1;
+		binNodes[4 * i + 2] = first;
+		binNodes[4 * i + 3] = last - first + 1;
+	}
+
+	// 4분할 노드를 깊이 우선 순서로 생성하고, 경계 상자와 다이폴 정보를 상향식으로 계산한다.
+	mNodes.reserve(numFaces / 2);
+	emitLBVH(binNodes, 0);
+	mDipoles.resize(mNodes.size() * 4);
+	refitNodes();
+}
+
+int DgBvh::emitLBVH(const std::vector<int>& binNodes, int ref)
+{
+	int nodeIdx = NUM(mNodes);
+	mNodes.emplace_back();
+
+	// 이진 참조의 시작 위치와 삼각형 개수
+	auto first = [&](int r) { return (r < 0) ? ~r : binNodes[4 * r + 2]; };
+	auto count = [&](int r) { return (r < 0) ? 1 : binNodes[4 * r + 3]; };
+
+	// 가장 큰 내부 자식을 두 자식으로 펼치기를 반복하여 최대 4개의 자식을 구한다.
+	int slots[4] = { binNodes[4 * ref], binNodes[4 * ref + 1], 0, 0 };
+	int numSlots = 2;
+	while (numSlots < 4)
+	{
+		int best = -1;
+		for (int k = 0; k < numSlots; ++k)
+			if (slots[k] >= 0 && count(slots[k]) > MAX_BVH_LEAF_SIZE && (best < 0 || count(slots[k]) > count(slots[best])))
+				best = k;
+		if (best < 0)
+			break;
+		int r = slots[best];
+		slots[best] = binNodes[4 * r];
+		slots[numSlots++] = binNodes[4 * r + 1];
+	}
+
+	// 자식 참조를 설정한다(경계 상자는 refitNodes()에서 계산).
+	for (int c = 0; c < 4; ++c)
+	{
+		int childIdx = -1, cfirst = NUM(mFaceIdxs), ccount = 0;
+		if (c < numSlots)
+		{
+			cfirst = first(slots[c]);
+			ccount = count(slots[c]);
+			if (ccount > MAX_BVH_LEAF_SIZE)
+				childIdx = emitLBVH(binNodes, slots[c]);
+		}
+		mNodes[nodeIdx].mChild[c] = (childIdx >= 0) ? childIdx : -cfirst - 1;
+		mNodes[nodeIdx].mCount[c] = (childIdx >= 0) ? 0 : ccount;
+	}
+	return nodeIdx;
+}
+
+int DgBvh::buildMidpoint(int first, int count, int depth)
+{
+	// 노드를 깊이 우선 순서로 추가한다.
+	int nodeIdx = (int)mNodes.size();
+	mNodes.emplace_back();
+	mDipoles.resize(mNodes.size() * 4);
+
+	// 삼각형 구간의 경계 상자를 구하여
+	double bmin[3] = { DBL_MAX, DBL_MAX, DBL_MAX };
+	double bmax[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+	for (int i = first; i < first + count; ++i)
+	{
+		DgFace* f = getFace(i);
+		for (int v = 0; v < 3; ++v)
+		{
+			DgPos p = getVertPos(f, v);
+			for (int a = 0; a < 3; ++a)
+			{
+				bmin[a] = MIN(bmin[a], p[a]);
+				bmax[a] = MAX(bmax[a], p[a]);
+			}
+		}
+	}
+
+	// 분할할 두 축(axis0, axis1)과 중심(c0, c1)을 구한다.
+	double dx = bmax[0] - bmin[0];
+	double dy = bmax[1] - bmin[1];
+	double dz = bmax[2] - bmin[2];
+	int axis0 = 1, axis1 = 2;
+	if (dy < dx && dy < dz)
+	{
+		axis0 = 2;
+		axis1 = 0;
+	}
+	else if (dz < dx && dz < dy)
+	{
+		axis0 = 0;
+		axis1 = 1;
+	}
+	double c0 = (bmin[axis0] + bmax[axis0]) / 2.0;
+	double c1 = (bmin[axis1] + bmax[axis1]) / 2.0;
+
+	// 삼각형 인덱스 구간을 첫 번째 정점 기준으로 4개의 영역으로 제자리 분할한다.
+	int* pBegin = mFaceIdxs.data() + first;
+	int* pEnd = pBegin + count;
+	auto isLow = [&](int axis, double c) {
+		return [this, axis, c](int fidx) { return getVertPos(&mMesh->mFaces[fidx], 0)[axis] <= c; };
+	};
+	int* pMid = std::partition(pBegin, pEnd, isLow(axis0, c0));
+	int* pMid0 = std::partition(pBegin, pMid, isLow(axis1, c1));
+	int* pMid1 = std::partition(pMid, pEnd, isLow(axis1, c1));
+	int bounds[5] = { first, first + (int)(pMid0 - pBegin), first + (int)(pMid - pBegin), first + (int)(pMid1 - pBegin), first + count };
+
+	// 4개의 영역에 대한 자식을 생성한다.
+	for (int c = 0; c < 4; ++c)
+	{
+		int cfirst = bounds[c];
+		int ccount = bounds[c + 1] - bounds[c];
+		if (depth + 1 == MAX_BVH_DEPTH || ccount < 6)
+			setChild(mNodes, mDipoles, nodeIdx, c, cfirst, ccount, -1);
+		else
+			setChild(mNodes, mDipoles, nodeIdx, c, cfirst, ccount, buildMidpoint(cfirst, ccount, depth + 1));
+	}
+	return nodeIdx;
+}
+
+int DgBvh::buildSAH(std::vector<Node>& nodes, std::vector<Dipole>& dipoles, int first, int count,
+	const std::vector<float>& bounds, std::vector<int>* pending, int grain)
+{
+	// 노드를 깊이 우선 순서로 추가한다.
+	int nodeIdx = NUM(nodes);
+	nodes.emplace_back();
+	dipoles.resize(nodes.size() * 4);
+
+	// 이진 SAH 분할을 두 번 적용하여 최대 4개의 자식 구간을 구한다.
+	int ranges[4][2];
+	int numRanges = 0;
+	int mid = splitSAH(first, count, bounds);
+	if (mid < 0)
+	{
+		ranges[numRanges][0] = first;
+		ranges[numRanges++][1] = count;
+	}
+	else
+	{
+		int halves[2][2] = { { first, mid - first }, { mid, first + count - mid } };
+		for (int h = 0; h < 2; ++h)
+		{
+			int hmid = (halves[h][1] > MAX_BVH_LEAF_SIZE) ? splitSAH(halves[h][0], halves[h][1], bounds) : -1;
+			if (hmid < 0)
+			{
+				ranges[numRanges][0] = halves[h][0];
+				ranges[numRanges++][1] = halves[h][1];
+			}
+			else
+			{
+				ranges[numRanges][0] = halves[h][0];
+				ranges[numRanges++][1] = hmid - halves[h][0];
+				ranges[numRanges][0] = hmid;
+				ranges[numRanges++][1] = halves[h][0] + halves[h][1] - hmid;
+			}
+		}
+	}
+
+	// 자식을 생성한다(분할할 수 없는 구간은 리프 크기와 무관하게 리프가 된다).
+	for (int c = 0; c < 4; ++c)
+	{
+		if (c >= numRanges)
+		{
+			setChild(nodes, dipoles, nodeIdx, c, first + count, 0, -1);
+			continue;
+		}
+
+		int cfirst = ranges[c][0];
+		int ccount = ranges[c][1];
+		if (ccount <= MAX_BVH_LEAF_SIZE || mid < 0)
+			setChild(nodes, dipoles, nodeIdx, c, cfirst, ccount, -1);
+		else if (pending != NULL && ccount <= grain)
+		{
+			// 하위 트리는 나중에 병렬로 생성한다(자식 참조는 임시 값).
+			setChild(nodes, dipoles, nodeIdx, c, cfirst, ccount, 0);
+			pending->push_back(nodeIdx * 4 + c);
+			pending->push_back(cfirst);
+			pending->push_back(ccount);
+		}
+		else
+			setChild(nodes, dipoles, nodeIdx, c, cfirst, ccount, buildSAH(nodes, dipoles, cfirst, ccount, bounds, pending, grain));
+	}
+	return nodeIdx;
+}
+
+int DgBvh::splitSAH(int first, int count, const std::vector<float>& bounds)
+{
+	// 무게중심의 경계 상자를 구한다.
+	float cmin[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+	float cmax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	for (int i = first; i < first + count; ++i)
+	{
+		const float* b = &bounds[9 * mFaceIdxs[i]];
+		for (int a = 0; a < 3; ++a)
+		{
+			cmin[a] = MIN(cmin[a], b[6 + a]);
+			cmax[a] = MAX(cmax[a], b[6 + a]);
+		}
+	}
+
+	// 상자의 표면적(빈 상자는 0)
+	auto area = [](const float* bmin, const float* bmax) {
+		if (bmin[0] > bmax[0])
+			return 0.0f;
+		float dx = bmax[0] - bmin[0], dy = bmax[1] - bmin[1], dz = bmax[2] - bmin[2];
+		return 2.0f * (dx * dy + dy * dz + dz * dx);
+	};
+
+	// 세 축에 대하여 구간별 SAH 비용이 최소인 분할을 찾는다.
+	float bestCost = FLT_MAX;
+	int bestAxis = -1, bestBin = -1;
+	for (int a = 0; a < 3; ++a)
+	{
+		float ext = cmax[a] - cmin[a];
+		if (ext <= 0.0f)
+			continue;
+
+		// 무게중심을 구간에 분배하여 구간별 개수와 경계 상자를 구하고
+		int binCount[NUM_SAH_BINS] = { 0 };
+		float binMin[NUM_SAH_BINS][3], binMax[NUM_SAH_BINS][3];
+		for (int k = 0; k < NUM_SAH_BINS; ++k)
+			for (int e = 0; e < 3; ++e)
+			{
+				binMin[k][e] = FLT_MAX;
+				binMax[k][e] = -FLT_MAX;
+			}
+		float scale = NUM_SAH_BINS / ext;
+		for (int i = first; i < first + count; ++i)
+		{
+			const float* b = &bounds[9 * mFaceIdxs[i]];
+			int k = MIN((int)((b[6 + a] - cmin[a]) * scale), NUM_SAH_BINS - 1);
+			binCount[k]++;
+			for (int e = 0; e < 3; ++e)
+			{
+				binMin[k][e] = MIN(binMin[k][e], b[e]);
+				binMax[k][e] = MAX(binMax[k][e], b[3 + e]);
+			}
+		}
+
+		// 왼쪽에서 오른쪽으로 누적한 표면적과 개수를 구한 후
+		float leftArea[NUM_SAH_BINS];
+		int leftCount[NUM_SAH_BINS];
+		float lmin[3] = { FLT_MAX, FLT_MAX, FLT_MAX }, lmax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		int n = 0;
+		for (int k = 0; k < NUM_SAH_BINS - 1; ++k)
+		{
+			n += binCount[k];
+			for (int e = 0; e < 3; ++e)
+			{
+				lmin[e] = MIN(lmin[e], binMin[k][e]);
+				lmax[e] = MAX(lmax[e], binMax[k][e]);
+			}
+			leftArea[k] = area(lmin, lmax);
+			leftCount[k] = n;
+		}
+
+		// 오른쪽에서 왼쪽으로 누적하며 비용(A_L * N_L + A_R * N_R)을 계산한다.
+		float rmin[3] = { FLT_MAX, FLT_MAX, FLT_MAX }, rmax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		n = 0;
+		for (int k = NUM_SAH_BINS - 1; k > 0; --k)
+		{
+			n += binCount[k];
+			for (int e = 0; e < 3; ++e)
+			{
+				rmin[e] = MIN(rmin[e], binMin[k][e]);
+				rmax[e] = MAX(rmax[e], binMax[k][e]);
+			}
+			if (n == 0 || leftCount[k - 1] == 0)
+				continue;
+
+			float cost = leftArea[k - 1] * leftCount[k - 1] + area(rmin, rmax) * n;
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = a;
+				bestBin = k;
+			}
+		}
+	}
+
+	// 분할할 수 없다면 -1을 반환한다.
+	if (bestAxis < 0)
+		return -1;
+
+	// 최적 구간의 왼쪽과 오른쪽으로 제자리 분할한다.
+	float scale = NUM_SAH_BINS / (cmax[bestAxis] - cmin[bestAxis]);
+	float c0 = cmin[bestAxis];
+	int* pMid = std::partition(mFaceIdxs.data() + first, mFaceIdxs.data() + first + count, [&](int fidx) {
+		return MIN((int)((bounds[9 * fidx + 6 + bestAxis] - c0) * scale), NUM_SAH_BINS - 1) < bestBin;
+	});
+	return (int)(pMid - mFaceIdxs.data());
+}
+
+void DgBvh::relinearize()
+{
+	std::vector<Node> nodes;
+	std::vector<Dipole> dipoles;
+	nodes.reserve(mNodes.size());
+	dipoles.reserve(mDipoles.size());
+
+	// (기존 노드 인덱스, 새 배열에서 부모의 자식 슬롯) 스택으로 전위 순회한다.
+	std::vector<std::pair<int, int>> nodeStack;
+	nodeStack.emplace_back(0, -1);
+	while (!nodeStack.empty())
+	{
+		auto [oldIdx, parentSlot] = nodeStack.back();
+		nodeStack.pop_back();
+
+		int newIdx = NUM(nodes);
+		nodes.push_back(mNodes[oldIdx]);
+		dipoles.insert(dipoles.end(), mDipoles.begin() + oldIdx * 4, mDipoles.begin() + oldIdx * 4 + 4);
+		if (parentSlot >= 0)
+			nodes[parentSlot >> 2].mChild[parentSlot & 3] = newIdx;
+
+		// 첫 번째 자식이 먼저 방문되도록 역순으로 넣는다.
+		for (int c = 3; c >= 0; --c)
+			if (mNodes[oldIdx].mChild[c] >= 0)
+				nodeStack.emplace_back(mNodes[oldIdx].mChild[c], newIdx * 4 + c);
+	}
+	mNodes.swap(nodes);
+	mDipoles.swap(dipoles);
+}
+
+int DgBvh::computeDepth() const
+{
+	// (노드 인덱스, 깊이) 스택으로 순회한다.
+	int depth = 0;
+	std::vector<std::pair<int, int>> nodeStack;
+	nodeStack.emplace_back(0, 1);
+	while (!nodeStack.empty())
+	{
+		auto [nodeIdx, d] = nodeStack.back();
+		nodeStack.pop_back();
+		depth = MAX(depth, d);
+		for (int c = 0; c < 4; ++c)
+			if (mNodes[nodeIdx].mChild[c] >= 0)
+				nodeStack.emplace_back(mNodes[nodeIdx].mChild[c], d + 1);
+	}
+	return depth;
+}
+
+void DgBvh::setChild(std::vector<Node>& nodes, std::vector<Dipole>& dipoles, int nodeIdx, int c, int first, int count, int childIdx)
+{
+	Node& node = nodes[nodeIdx];
+	Dipole& dp = dipoles[nodeIdx * 4 + c];
+	node.mChild[c] = (childIdx >= 0) ? childIdx : -first - 1;
+	node.mCount[c] = (childIdx >= 0) ? 0 : count;
+
+	// 자식 경계 상자를 바깥쪽으로 반올림하여 저장한다(빈 자식은 뒤집힌 상자).
+	double bmin[3] = { DBL_MAX, DBL_MAX, DBL_MAX };
+	double bmax[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+	double an[3] = { 0.0, 0.0, 0.0 }, ct[3] = { 0.0, 0.0, 0.0 }, area = 0.0;
+	for (int i = first; i < first + count; ++i)
+	{
+		DgFace* f = getFace(i);
+		DgPos p0, p1, p2;
+		getFacePos(f, p0, p1, p2);
+		for (int a = 0; a < 3; ++a)
+		{
+			bmin[a] = MIN(bmin[a], MIN(p0[a], MIN(p1[a], p2[a])));
+			bmax[a] = MAX(bmax[a], MAX(p0[a], MAX(p1[a], p2[a])));
+		}
+
+		// 다이폴 정보(면적 가중 법선 합과 중심)를 누적한다.
+		DgVec3 n = 0.5 * ((p1 - p0) ^ (p2 - p0));
+		double A = norm(n);
+		area += A;
+		for (int a = 0; a < 3; ++a)
+		{
+			an[a] += n[a];
+			ct[a] += A * (p0[a] + p1[a] + p2[a]) / 3.0;
+		}
+	}
+	for (int a = 0; a < 3; ++a)
+	{
+		node.mMin[a][c] = (count > 0) ? round_down(bmin[a]) : FLT_MAX;
+		node.mMax[a][c] = (count > 0) ? round_up(bmax[a]) : -FLT_MAX;
+	}
+
+	// 다이폴의 중심과 반지름을 구한다.
+	for (int a = 0; a < 3; ++a)
+	{
+		dp.mAreaNormal[a] = (float)an[a];
+		dp.mCenter[a] = (float)((area > 0.0) ? ct[a] / area : (bmin[a] + bmax[a]) * 0.5);
+	}
+	dp.mArea = (float)area;
+	double radius = 0.0;
+	for (int i = first; i < first + count; ++i)
+	{
+		DgFace* f = getFace(i);
+		for (int v = 0; v < 3; ++v)
+		{
+			DgPos p = getVertPos(f, v);
+			radius = MAX(radius, SQRT(SQR(p[0] - dp.mCenter[0]) + SQR(p[1] - dp.mCenter[1]) + SQR(p[2] - dp.mCenter[2])));
+		}
+	}
+	dp.mRadius = round_up(radius);
+}
+
+bool DgBvh::intersectRay(const DgPos& org, const DgVec3& dir, double tmax, double& t, DgFace** pFace)
+{
+	RayData r;
+	init_ray(r, org, dir);
+
+	// 교차 구간의 시작이 가까운 자식부터 방문하는 고정 크기 스택
+	Dist2Ref stack[BVH_STACK_SIZE];
+	int top = 0;
+	stack[top++] = Dist2Ref(0.0, 0);
+
+	*pFace = NULL;
+	t = tmax;
+	while (top > 0)
+	{
+		auto [tnear, ref] = stack[--top];
+		if (tnear > t)
+			continue;
+
+		// 리프라면 삼각형과 교차시켜 가장 가까운 교차점을 갱신한다.
+		if (ref < 0)
+		{
+			int slot = -ref - 1;
+			const Node& node = mNodes[slot >> 2];
+			int first = -node.mChild[slot & 3] - 1;
+			for (int i = first; i < first + node.mCount[slot & 3]; ++i)
+			{
+				double th;
+				DgPos p0, p1, p2;
+				getFacePos(getFace(i), p0, p1, p2);
+				if (intersect_ray_tri(r, p0, p1, p2, t, th))
+				{
+					t = th;
+					*pFace = getFace(i);
+				}
+			}
+		}
+		else
+		{
+			double d[4];
+			ray_box4(mNodes[ref], r, t, d);
+			top = push_children_sorted(mNodes[ref], ref, d, t, stack, top);
+		}
+	}
+	return *pFace != NULL;
+}
+
+bool DgBvh::isOccluded(const DgPos& org, const DgVec3& dir, double tmax)
+{
+	RayData r;
+	init_ray(r, org, dir);
+
+	int stack[BVH_STACK_SIZE];
+	int top = 0;
+	stack[top++] = 0;
+	while (top > 0)
+	{
+		const Node& node = mNodes[stack[--top]];
+		double d[4];
+		ray_box4(node, r, tmax, d);
+		for (int c = 0; c < 4; ++c)
+		{
+			if (d[c] == HUGE_VAL)
+				continue;
+			if (node.mChild[c] >= 0)
+			{
+				stack[top++] = node.mChild[c];
+				continue;
+			}
+
+			// 처음 발견한 교차에서 종료한다.
+			int first = -node.mChild[c] - 1;
+			for (int i = first; i < first + node.mCount[c]; ++i)
+			{
+				double th;
+				DgPos p0, p1, p2;
+				getFacePos(getFace(i), p0, p1, p2);
+				if (intersect_ray_tri(r, p0, p1, p2, tmax, th))
+					return true;
+			}
+		}
+	}
+	return false;
+}
+
+int DgBvh::countRayHits(const DgPos& org, const DgVec3& dir)
+{
+	RayData r;
+	init_ray(r, org, dir);
+
+	int numHits = 0;
+	int stack[BVH_STACK_SIZE];
+	int top = 0;
+	stack[top++] = 0;
+	while (top > 0)
+	{
+		const Node& node = mNodes[stack[--top]];
+		double d[4];
+		ray_box4(node, r, DBL_MAX, d);
+		for (int c = 0; c < 4; ++c)
+		{
+			if (d[c] == HUGE_VAL)
+				continue;
+			if (node.mChild[c] >= 0)
+			{
+				stack[top++] = node.mChild[c];
+				continue;
+			}
+
+			int first = -node.mChild[c] - 1;
+			for (int i = first; i < first + node.mCount[c]; ++i)
+			{
+				double th;
+				DgPos p0, p1, p2;
+				getFacePos(getFace(i), p0, p1, p2);
+				if (intersect_ray_tri(r, p0, p1, p2, DBL_MAX, th))
+					numHits++;
+			}
+		}
+	}
+	return numHits;
+}
+
+void DgBvh::intersectRays(const DgPos* orgs, const DgVec3* dirs, int numRays, double* ts, DgFace** pFaces)
+{
+	numRays = MIN(numRays, BVH_PACKET_SIZE);
+	RayData rays[BVH_PACKET_SIZE];
+	for (int k = 0; k < numRays; ++k)
+	{
+		init_ray(rays[k], orgs[k], dirs[k]);
+		pFaces[k] = NULL;
+	}
+
+	// 묶음 중 가장 먼저 상자에 들어가는 광선의 파라미터 순으로 방문한다.
+	Dist2Ref stack[BVH_STACK_SIZE];
+	int top = 0;
+	stack[top++] = Dist2Ref(0.0, 0);
+	while (top > 0)
+	{
+		auto [tnear, ref] = stack[--top];
+		double tfar = 0.0;
+		for (int k = 0; k < numRays; ++k)
+			tfar = MAX(tfar, ts[k]);
+		if (tnear > tfar)
+			continue;
+
+		if (ref < 0)
+		{
+			int slot = -ref - 1;
+			const Node& node = mNodes[slot >> 2];
+			int first = -node.mChild[slot & 3] - 1;
+			for (int i = first; i < first + node.mCount[slot & 3]; ++i)
+			{
+				DgFace* f = getFace(i);
+				DgPos p0, p1, p2;
+				getFacePos(f, p0, p1, p2);
+				for (int k = 0; k < numRays; ++k)
+				{
+					double th;
+					if (intersect_ray_tri(rays[k], p0, p1, p2, ts[k], th))
+					{
+						ts[k] = th;
+						pFaces[k] = f;
+					}
+				}
+			}
+		}
+		else
+		{
+			// 자식별로 교차하는 광선 중 가장 작은 시작 파라미터를 구한다.
+			double d[4] = { HUGE_VAL, HUGE_VAL, HUGE_VAL, HUGE_VAL };
+			for (int k = 0; k < numRays; ++k)
+			{
+				double dk[4];
+				ray_box4(mNodes[ref], rays[k], ts[k], dk);
+				for (int c = 0; c < 4; ++c)
+					d[c] = MIN(d[c], dk[c]);
+			}
+			top = push_children_sorted(mNodes[ref], ref, d, tfar, stack, top);
+		}
+	}
+}
+
+bool DgBvh::refit(double maxRatio)
+{
+	// 트리 구조를 유지한 채 경계 상자와 다이폴 정보를 갱신하고
+	refitNodes();
+	updateBndBox();
+	updatePseudoNormals();
+
+	// 트리의 품질이 기준 이하로 떨어졌다면 다시 생성한다.
+	mCost = computeCost();
+	if (mCost > maxRatio * mBuildCost)
+	{
+		build();
+		return true;
+	}
+	return false;
+}
+
+void DgBvh::refitNodes()
+{
+	// 처음 갱신하는 경우 깊이별 노드 목록을 만든다(노드는 부모보다 뒤에 저장되어 있음).
+	if (mLevels.empty())
+	{
+		std::vector<int> level(mNodes.size(), 0);
+		for (int i = 0; i < NUM(mNodes); ++i)
+		{
+			if (NUM(mLevels) <= level[i])
+				mLevels.resize(level[i] + 1);
+			mLevels[level[i]].push_back(i);
+			for (int c = 0; c < 4; ++c)
+				if (mNodes[i].mChild[c] >= 0)
+					level[mNodes[i].mChild[c]] = level[i] + 1;
+		}
+	}
+
+	// 가장 깊은 레벨부터 같은 레벨의 노드를 병렬로 갱신한다.
+	for (int l = NUM(mLevels) - 1; l >= 0; --l)
+	{
+		const std::vector<int>& nodeIdxs = mLevels[l];
+#pragma omp parallel for schedule(dynamic, 64)
+		for (int n = 0; n < NUM(nodeIdxs); ++n)
+			for (int c = 0; c < 4; ++c)
+				refitChild(nodeIdxs[n], c);
+	}
+}
+
+void DgBvh::updatePseudoNormals()
+{
+	int numVerts = NUM(mMesh->mVerts);
+	int numFaces = NUM(mMesh->mFaces);
+	mVertNormals.assign(numVerts, DgVec3(0.0, 0.0, 0.0));
+	mEdgeNormals.assign(3 * numFaces, DgVec3(0.0, 0.0, 0.0));
+	mBndryFaces.assign(numFaces, false);
+
+	// 에지를 (작은 정점 인덱스, 큰 정점 인덱스)로 식별하여 인접 삼각형의 법선을 모은다.
+	std::unordered_map<long long, std::pair<DgVec3, int>> edges;
+	edges.reserve(3 * numFaces / 2 + 1);
+	for (int i = 0; i < numFaces; ++i)
+	{
+		const DgFace* f = &mMesh->mFaces[i];
+		DgPos p[3];
+		getFacePos(f, p[0], p[1], p[2]);
+		DgVec3 n = (p[1] - p[0]) ^ (p[2] - p[0]);
+		n.normalize();
+
+		// 정점의 의사 법선은 삼각형 법선을 내각으로 가중하여 더한다.
+		for (int k = 0; k < 3; ++k)
+		{
+			double theta = angle(p[(k + 1) % 3] - p[k], p[(k + 2) % 3] - p[k], true);
+			mVertNormals[f->mVertIdxs[k]] += theta * n;
+
+			int v0 = f->mVertIdxs[k], v1 = f->mVertIdxs[(k + 1) % 3];
+			long long key = (long long)MIN(v0, v1) * numVerts + MAX(v0, v1);
+			std::pair<DgVec3, int>& e = edges[key];
+			e.first += n;
+			e.second++;
+		}
+	}
+
+	// 에지의 의사 법선을 삼각형별로 저장하고, 한 번만 사용된 에지를 갖는 삼각형을 경계로 표시한다.
+	for (int i = 0; i < numFaces; ++i)
+	{
+		const DgFace* f = &mMesh->mFaces[i];
+		for (int k = 0; k < 3; ++k)
+		{
+			int v0 = f->mVertIdxs[k], v1 = f->mVertIdxs[(k + 1) % 3];
+			long long key = (long long)MIN(v0, v1) * numVerts + MAX(v0, v1);
+			const std::pair<DgVec3, int>& e = edges[key];
+			mEdgeNormals[3 * i + k] = e.first;
+			if (e.second == 1)
+				mBndryFaces[i] = true;
+		}
+	}
+}
+
+void DgBvh::refitChild(int nodeIdx, int c)
+{
+	Node& node = mNodes[nodeIdx];
+
+	// 리프는 삼각형으로부터 다시 계산한다.
+	if (node.mChild[c] < 0)
+	{
+		setChild(mNodes, mDipoles, nodeIdx, c, -node.mChild[c] - 1, node.mCount[c], -1);
+		return;
+	}
+
+	// 내부 노드는 자식 노드의 4개 상자와 다이폴을 병합한다.
+	int childIdx = node.mChild[c];
+	const Node& child = mNodes[childIdx];
+	float bmin[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+	float bmax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	double an[3] = { 0.0, 0.0, 0.0 }, ct[3] = { 0.0, 0.0, 0.0 }, area = 0.0;
+	for (int k = 0; k < 4; ++k)
+	{
+		if (child.mChild[k] < 0 && child.mCount[k] == 0)
+			continue;
+		const Dipole& dk = mDipoles[childIdx * 4 + k];
+		for (int a = 0; a < 3; ++a)
+		{
+			bmin[a] = MIN(bmin[a], child.mMin[a][k]);
+			bmax[a] = MAX(bmax[a], child.mMax[a][k]);
+			an[a] += dk.mAreaNormal[a];
+			ct[a] += (double)dk.mArea * dk.mCenter[a];
+		}
+		area += dk.mArea;
+	}
+
+	Dipole& dp = mDipoles[nodeIdx * 4 + c];
+	for (int a = 0; a < 3; ++a)
+	{
+		node.mMin[a][c] = bmin[a];
+		node.mMax[a][c] = bmax[a];
+		dp.mAreaNormal[a] = (float)an[a];
+		dp.mCenter[a] = (float)((area > 0.0) ? ct[a] / area : (bmin[a] + bmax[a]) * 0.5);
+	}
+	dp.mArea = (float)area;
+
+	// 반지름은 자식 다이폴 구를 모두 포함하도록 보수적으로 구한다.
+	double radius = 0.0;
+	for (int k = 0; k < 4; ++k)
+	{
+		if (child.mChild[k] < 0 && child.mCount[k] == 0)
+			continue;
+		const Dipole& dk = mDipoles[childIdx * 4 + k];
+		double d = SQRT(SQR(dk.mCenter[0] - dp.mCenter[0]) + SQR(dk.mCenter[1] - dp.mCenter[1]) + SQR(dk.mCenter[2] - dp.mCenter[2]));
+		radius = MAX(radius, d + dk.mRadius);
+	}
+	dp.mRadius = round_up(radius);
+}
+
 bool DgBvh::isCloserThan(double dist, const DgPos& p, bool bVertOnly)
 {
-	// ּ :  Ÿ  ĵ
-	std::priority_queue<Dist2BV, std::vector<Dist2BV>, std::greater<Dist2BV>> minQ;
-	minQ.push(std::make_pair(0.0, mRoot));
+	// 가까운 자식이 top에 오는 고정 크기 스택(최대 3 * mDepth + 1개)
+	Dist2Ref stack[BVH_STACK_SIZE];
+	int top = 0;
+	stack[top++] = Dist2Ref(0.0, 0);
 
 	double sqrDist = SQR(dist);
-	while (!minQ.empty())
+	while (top > 0)
 	{
-		//    
-		auto [dist2Box, box] = minQ.top();
-		minQ.pop();
+		// 가장 가까운 자식을 꺼냄
+		auto [dist2Box, ref] = stack[--top];
 
-		// Ÿ üũ
+		// 거리 체크
 		if (dist2Box > sqrDist)
 			continue;
 
-		//   ﰢ Ÿ 
-		if (box->mIsLeaf)
+		// 리프라면 삼각형 거리 측정
+		if (ref < 0)
 		{
-			for (DgFace* f : box->mFaces)
+			int slot = -ref - 1;
+			const Node& node = mNodes[slot >> 2];
+			int first = -node.mChild[slot & 3] - 1;
+			for (int i = first; i < first + node.mCount[slot & 3]; ++i)
 			{
-				double d = (bVertOnly) ? SQRT(dist_sq_vert(p, f)) : SQRT(dist_sq(p, f));
+				DgPos p0, p1, p2;
+				getFacePos(getFace(i), p0, p1, p2);
+				double d = (bVertOnly) ? SQRT(dist_sq_vert(p, p0, p1, p2)) : SQRT(dist_sq(p, p0, p1, p2));
 				if (d < dist)
 					return true;
 			}
 		}
 		else
 		{
-			for (AaBb* child : box->mChildNodes)
-				minQ.emplace(child->getSqrDist(p), child);
+			double d[4];
+			box_sqr_dist4(mNodes[ref], p, d);
+			top = push_children_sorted(mNodes[ref], ref, d, sqrDist, stack, top);
 		}
 	}
 	return false;
@@ -243,34 +1350,59 @@ bool DgBvh::isCloserThan(double dist, const DgPos& p, bool bVertOnly)
 
 double DgBvh::computeDistance(DgPos p, DgPos& q, DgFace** pFace, bool bSigned)
 {
-	// ּ :  Ÿ  ĵ
-	std::priority_queue<Dist2BV, std::vector<Dist2BV>, std::greater<Dist2BV>> minQ;
-	minQ.push(std::make_pair(0.0, mRoot));
+	*pFace = NULL;
+	double sqr_min_d = findClosest(p, q, pFace);
 
-	//  ޽ ִ Ÿ Ѵ.
+	// 계산된 최소 거리를 반환한다.
+	if (bSigned)
+		return signedDistance(p, q, *pFace, sqr_min_d);
+	else
+		return SQRT(sqr_min_d);
+}
+
+double DgBvh::findClosest(const DgPos& p, DgPos& q, DgFace** pFace)
+{
+	// 가까운 자식이 top에 오는 고정 크기 스택(최대 3 * mDepth + 1개)
+	Dist2Ref stack[BVH_STACK_SIZE];
+	int top = 0;
+	stack[top++] = Dist2Ref(0.0, 0);
+
+	// 점과 메쉬의 최단 거리를 구한다(초기 삼각형이 주어지면 그 거리를 상한으로 사용한다).
 	double sqr_min_d = DBL_MAX;
-	while (!minQ.empty())
+	if (*pFace != NULL)
+	{
+		DgPos p0, p1, p2;
+		getFacePos(*pFace, p0, p1, p2);
+		sqr_min_d = dist_sq(p, p0, p1, p2, q);
+	}
+	while (top > 0)
 	{
-		//    ڸ 
-		auto [dist2Box, box] = minQ.top();
-		minQ.pop();
+		// 가장 가까운 자식을 꺼내어
+		auto [dist2Box, ref] = stack[--top];
 
-		//  ڱ Ÿ  ִ Ÿ ٸ ŵѴ.
+		// 경계 상자까지의 거리가 현재까지 최단 거리보다 길다면 스킵한다.
 		if (dist2Box > sqr_min_d)
 			continue;
 
-		//    ڶ ﰢ Ÿ Ѵ.
-		if (box->mIsLeaf)
+		// 리프라면 삼각형과의 거리를 계산한다.
+		if (ref < 0)
 		{
-			for (DgFace* f : box->mFaces)
+			int slot = -ref - 1;
+			const Node& node = mNodes[slot >> 2];
+			int first = -node.mChild[slot & 3] - 1;
+			for (int i = first; i < first + node.mCount[slot & 3]; ++i)
 			{
-				double area = f->getArea();
+				DgFace* f = getFace(i);
+				DgPos p0, p1, p2;
+				getFacePos(f, p0, p1, p2);
+				double area = 0.5 * norm((p1 - p0) ^ (p2 - p0));
 				if (EQ_ZERO(area, 1.0e-7))
 					continue;
 
+				// 거리가 같다면 인덱스가 작은 삼각형을 선택하여 결과가 탐색 순서와 무관하도록 한다.
 				DgPos tmp;
-				double d = dist_sq(p, f, tmp);
-				if (d < sqr_min_d)
+				double d = dist_sq(p, p0, p1, p2, tmp);
+				if (d < sqr_min_d || (d == sqr_min_d && f < *pFace))
 				{
 					sqr_min_d = d;
 					q = tmp;
@@ -280,165 +1412,451 @@ double DgBvh::computeDistance(DgPos p, DgPos& q, DgFace** pFace, bool bSigned)
 		}
 		else
 		{
-			for (AaBb* child : box->mChildNodes)
-				minQ.emplace(child->getSqrDist(p), child);
+			double d[4];
+			box_sqr_dist4(mNodes[ref], p, d);
+			top = push_children_sorted(mNodes[ref], ref, d, sqr_min_d, stack, top);
 		}
 	}
 
-	//  ּ Ÿ ȯѴ.
-	if (bSigned)
-	{
-		DgVec3 n;
-		MgPos q1(*pFace, q);
-		if (q1.isOnVertex())
-		{
-			DgVertex* v = q1.getClosestVert();
-			n = v->getAvgNormal();
-		}
-		else if (q1.isOnEdge())
-		{
-			DgEdge* e = q1.getEdgeOverPt();
-			DgVec3 n1 = SV(e)->getAvgNormal();
-			DgVec3 n2 = EV(e)->getAvgNormal();
-			n = (n1 + n2).normalize();
-		}
-		else
-		{
-			n = (*pFace)->getFaceNormal(false);
-		}
-		DgVec3 qp = (p - q).normalize();
-		if (n * qp < 0.0 && !(*pFace)->isBndryFace())
-			return -SQRT(sqr_min_d);
-		else
-			return SQRT(sqr_min_d);
-	}
+	return sqr_min_d;
+}
+
+double DgBvh::signedDistance(const DgPos& p, const DgPos& q, DgFace* pFace, double sqrDist)
+{
+	// 최근접점이 놓인 삼각형의 특징(정점, 에지, 내부)을 구하여
+	DgPos p0, p1, p2, tmp;
+	getFacePos(pFace, p0, p1, p2);
+	int feature = 6;
+	dist_sq(p, p0, p1, p2, tmp, &feature);
+
+	// 특징의 의사 법선을 선택한다.
+	int fidx = getFaceIdx(pFace);
+	DgVec3 n;
+	if (feature < 3)
+		n = mVertNormals[pFace->mVertIdxs[feature]];
+	else if (feature < 6)
+		n = mEdgeNormals[3 * fidx + feature - 3];
 	else
-		return SQRT(sqr_min_d);
+		n = (p1 - p0) ^ (p2 - p0);
+
+	DgVec3 qp = p - q;
+	if (n * qp < 0.0 && !mBndryFaces[fidx])
+		return -SQRT(sqrDist);
+	else
+		return SQRT(sqrDist);
 }
 
 double DgBvh::computeDistance(DgPos p, DgPos& q, int& fidx, bool sign)
 {
 	DgFace* f;
 	double d = computeDistance(p, q, &f, sign);
-	fidx = f->mIdx;
+	fidx = getFaceIdx(f);
 	return d;
 }
 
+void DgBvh::computeDistances(const DgPos* pts, int numPts, double* dists, DgPos* closest, int* fidxs,
+	bool bSigned, bool bSeed, int numThreads)
+{
+	if (numPts <= 0)
+		return;
+
+	// 질의점과 BVH를 포함하는 경계 상자를 구하여
+	double bmin[3] = { mMin[0], mMin[1], mMin[2] };
+	double bmax[3] = { mMax[0], mMax[1], mMax[2] };
+	for (int i = 0; i < numPts; ++i)
+	{
+		for (int a = 0; a < 3; ++a)
+		{
+			bmin[a] = MIN(bmin[a], pts[i][a]);
+			bmax[a] = MAX(bmax[a], pts[i][a]);
+		}
+	}
+
+	// 질의점을 모튼 순서로 정렬한다.
+	std::vector<std::pair<unsigned int, int>> order(numPts);
+#pragma omp parallel for
+	for (int i = 0; i < numPts; ++i)
+	{
+		double x[3];
+		for (int a = 0; a < 3; ++a)
+			x[a] = (bmax[a] > bmin[a]) ? (pts[i][a] - bmin[a]) / (bmax[a] - bmin[a]) : 0.0;
+		order[i] = std::make_pair(morton_code30(x[0], x[1], x[2]), i);
+	}
+	std::sort(order.begin(), order.end());
+
+	// 정렬된 질의점을 BVH_BATCH_SIZE개씩 묶어 스레드에 동적으로 분배한다.
+	if (numThreads <= 0)
+		numThreads = omp_get_max_threads();
+	int numBatches = (numPts + BVH_BATCH_SIZE - 1) / BVH_BATCH_SIZE;
+#pragma omp parallel for schedule(dynamic, 1) num_threads(numThreads)
+	for (int b = 0; b < numBatches; ++b)
+	{
+		DgFace* pPrev = NULL;
+		int last = MIN((b + 1) * BVH_BATCH_SIZE, numPts);
+		for (int n = b * BVH_BATCH_SIZE; n < last; ++n)
+		{
+			// 직전 질의점의 최근접 삼각형을 초기 상한으로 사용하여 최단 거리를 구하고
+			int i = order[n].second;
+			DgPos q;
+			DgFace* pFace = (bSeed) ? pPrev : NULL;
+			double sqr_min_d = findClosest(pts[i], q, &pFace);
+			pPrev = pFace;
+
+			// 결과를 원래 순서의 위치에 저장한다.
+			dists[i] = (bSigned) ? signedDistance(pts[i], q, pFace, sqr_min_d) : SQRT(sqr_min_d);
+			if (closest != NULL)
+				closest[i] = q;
+			if (fidxs != NULL)
+				fidxs[i] = getFaceIdx(pFace);
+		}
+	}
+}
+
 int DgBvh::intersectWithTri(const DgPos& u0, const DgPos& u1, const DgPos& u2, std::vector<DgFace*>& hitFaces)
 {
-	// ﰢ BV Ʈ  ڿ   0 ȯѴ.
-	if (!mRoot->intersectWithTri(u0, u1, u2))
+	// 삼각형이 전체 경계 상자와 교차하지 않으면 0를 반환한다.
+	if (!::intersect_tri_box(u0, u1, u2, mMin, mMax))
 		return 0;
 
-	// BFS Ž   ڸ ϴ queue 
-	std::queue<DgBvh::AaBb*> boxQueue;
-	boxQueue.push(mRoot);
+	// BFS 탐색을 위한 노드를 저장하는 queue를 생성
+	std::queue<int> nodeQueue;
+	nodeQueue.push(0);
 
-	// BVH BFS  ŽϿ  ﰢ Ѵ.
-	while (!boxQueue.empty())
+	// BVH를 BFS 방식으로 탐색하여 교차 삼각형을 구한다.
+	while (!nodeQueue.empty())
 	{
-		DgBvh::AaBb* pBox = boxQueue.front();
-		boxQueue.pop();
+		const Node& node = mNodes[nodeQueue.front()];
+		nodeQueue.pop();
 
-		if (pBox->mIsLeaf)
+		for (int c = 0; c < 4; ++c)
 		{
-			for (DgFace* f : pBox->mFaces)
+			if (node.mChild[c] < 0 && node.mCount[c] == 0)
+				continue;
+
+			DgPos bmin(node.mMin[0][c], node.mMin[1][c], node.mMin[2][c]);
+			DgPos bmax(node.mMax[0][c], node.mMax[1][c], node.mMax[2][c]);
+			if (!::intersect_tri_box(u0, u1, u2, bmin, bmax))
+				continue;
+
+			if (node.mChild[c] >= 0)
 			{
-				DgPos v0 = f->getVertexPos(0);
-				DgPos v1 = f->getVertexPos(1);
-				DgPos v2 = f->getVertexPos(2);
+				nodeQueue.push(node.mChild[c]);
+				continue;
+			}
+
+			int first = -node.mChild[c] - 1;
+			for (int i = first; i < first + node.mCount[c]; ++i)
+			{
+				DgFace* f = getFace(i);
+				DgPos v0, v1, v2;
+				getFacePos(f, v0, v1, v2);
 				DgPos p, q;
 				if (intersect_tri_tri(u0, u1, u2, v0, v1, v2, p, q))
 					hitFaces.push_back(f);
 			}
 		}
-		else
+	}
+
+	return static_cast<int>(hitFaces.size());
+}
+
+/*!
+*	\struct	BvhFileHeader
+*	\brief	BVH 캐시 파일의 헤더(뒤이어 노드, 다이폴, 삼각형 인덱스 배열이 64바이트 경계에 저장됨)
+*/
+struct BvhFileHeader
+{
+	char mMagic[4];
+	int mVersion;
+	int mNodeSize;
+	int mBuildType;
+	int mNumNodes;
+	int mNumFaceIdxs;
+	int mNumMeshFaces;
+	int mDepth;
+	unsigned long long mMeshHash;
+	double mMin[3];
+	double mMax[3];
+	double mBuildCost;
+};
+
+static const int BVH_CACHE_VERSION = 1;
+
+/*!
+*	\brief	캐시 파일에서 배열의 시작 위치를 64바이트 경계로 올림
+*/
+static size_t align64(size_t offset)
+{
+	return (offset + 63) & ~(size_t)63;
+}
+
+bool DgBvh::save(const char* fname) const
+{
+	std::ofstream file(fname, std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	// 헤더를 작성하고
+	BvhFileHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.mMagic, "DBVH", 4);
+	header.mVersion = BVH_CACHE_VERSION;
+	header.mNodeSize = (int)sizeof(Node);
+	header.mBuildType = (int)mBuildType;
+	header.mNumNodes = NUM(mNodes);
+	header.mNumFaceIdxs = NUM(mFaceIdxs);
+	header.mNumMeshFaces = NUM(mMesh->mFaces);
+	header.mDepth = mDepth;
+	header.mMeshHash = computeMeshHash();
+	for (int a = 0; a < 3; ++a)
+	{
+		header.mMin[a] = mMin[a];
+		header.mMax[a] = mMax[a];
+	}
+	header.mBuildCost = mBuildCost;
+
+	// 배열을 64바이트 경계에 이어서 기록한다.
+	const char zeros[64] = { 0 };
+	size_t offset = 0;
+	auto write = [&](const void* data, size_t size) {
+		file.write(zeros, align64(offset) - offset);
+		file.write((const char*)data, size);
+		offset = align64(offset) + size;
+	};
+	write(&header, sizeof(header));
+	write(mNodes.data(), mNodes.size() * sizeof(Node));
+	write(mDipoles.data(), mDipoles.size() * sizeof(Dipole));
+	write(mFaceIdxs.data(), mFaceIdxs.size() * sizeof(int));
+	return file.good();
+}
+
+bool DgBvh::load(const char* fname)
+{
+	DgMappedFile file;
+	if (!file.open(fname) || file.mSize < sizeof(BvhFileHeader))
+		return false;
+
+	// 헤더가 현재 형식, 메쉬, 생성 방식과 일치하는지 확인한다.
+	BvhFileHeader header;
+	memcpy(&header, file.mData, sizeof(header));
+	if (memcmp(header.mMagic, "DBVH", 4) != 0 || header.mVersion != BVH_CACHE_VERSION || header.mNodeSize != (int)sizeof(Node) ||
+		header.mBuildType != (int)mBuildType || header.mNumMeshFaces != NUM(mMesh->mFaces) || header.mNumNodes <= 0)
+		return false;
+
+	size_t nodeOffset = align64(sizeof(header));
+	size_t dipoleOffset = align64(nodeOffset + header.mNumNodes * sizeof(Node));
+	size_t faceOffset = align64(dipoleOffset + header.mNumNodes * 4 * sizeof(Dipole));
+	if (file.mSize != faceOffset + header.mNumFaceIdxs * sizeof(int))
+		return false;
+	if (header.mMeshHash != computeMeshHash())
+	{
+		printf("BVH cache is stale, rebuilding: %s\n", fname);
+		return false;
+	}
+
+	// 매핑된 배열을 그대로 복사한다.
+	const Node* nodes = (const Node*)(file.mData + nodeOffset);
+	const Dipole* dipoles = (const Dipole*)(file.mData + dipoleOffset);
+	const int* faceIdxs = (const int*)(file.mData + faceOffset);
+	mNodes.assign(nodes, nodes + header.mNumNodes);
+	mDipoles.assign(dipoles, dipoles + header.mNumNodes * 4);
+	mFaceIdxs.assign(faceIdxs, faceIdxs + header.mNumFaceIdxs);
+	mLevels.clear();
+	mDepth = header.mDepth;
+	mMin = DgPos(header.mMin[0], header.mMin[1], header.mMin[2]);
+	mMax = DgPos(header.mMax[0], header.mMax[1], header.mMax[2]);
+	mBuildCost = mCost = header.mBuildCost;
+	return true;
+}
+
+unsigned long long DgBvh::computeMeshHash() const
+{
+	unsigned long long h = 14695981039346656037ull;
+	auto hash = [&h](const void* data, size_t size) {
+		const unsigned char* bytes = (const unsigned char*)data;
+		for (size_t i = 0; i < size; ++i)
 		{
-			for (int i = 0; i < 4; ++i)
-				if (pBox->mChildNodes[i]->intersectWithTri(u0, u1, u2))
-					boxQueue.push(pBox->mChildNodes[i]);
+			h ^= bytes[i];
+			h *= 1099511628211ull;
 		}
+	};
+
+	int numVerts = NUM(mMesh->mVerts);
+	int numFaces = NUM(mMesh->mFaces);
+	hash(&numVerts, sizeof(int));
+	hash(&numFaces, sizeof(int));
+	for (const DgVertex& v : mMesh->mVerts)
+	{
+		double p[3] = { v.mPos[0], v.mPos[1], v.mPos[2] };
+		hash(p, sizeof(p));
 	}
+	for (const DgFace& f : mMesh->mFaces)
+		hash(f.mVertIdxs, sizeof(f.mVertIdxs));
+	return h;
+}
 
-	return static_cast<int>(hitFaces.size());
+size_t DgBvh::getMemory() const
+{
+	return mNodes.size() * sizeof(Node) + mDipoles.size() * sizeof(Dipole) + mFaceIdxs.size() * sizeof(int);
+}
+
+double DgBvh::computeWindingNumber(const DgPos& p, double beta)
+{
+	// 깊이 우선 탐색을 위한 고정 크기 노드 스택
+	int stack[BVH_STACK_SIZE];
+	int top = 0;
+	stack[top++] = 0;
+
+	double w = 0.0;
+	while (top > 0)
+	{
+		int nodeIdx = stack[--top];
+		const Node& node = mNodes[nodeIdx];
+
+		for (int c = 0; c < 4; ++c)
+		{
+			const Dipole& dp = mDipoles[nodeIdx * 4 + c];
+			if (node.mChild[c] < 0 && node.mCount[c] == 0)
+				continue;
+
+			// 점에서 충분히 먼 자식은 다이폴로 근사한다.
+			DgVec3 r(dp.mCenter[0] - p[0], dp.mCenter[1] - p[1], dp.mCenter[2] - p[2]);
+			double len = norm(r);
+			if (len > beta * dp.mRadius)
+			{
+				DgVec3 an(dp.mAreaNormal[0], dp.mAreaNormal[1], dp.mAreaNormal[2]);
+				w += (r * an) / (4.0 * M_PI * len * len * len);
+				continue;
+			}
+
+			// 가까운 리프는 삼각형의 입체각을 정확히 더한다.
+			if (node.mChild[c] >= 0)
+				stack[top++] = node.mChild[c];
+			else
+			{
+				int first = -node.mChild[c] - 1;
+				for (int i = first; i < first + node.mCount[c]; ++i)
+				{
+					DgPos p0, p1, p2;
+					getFacePos(getFace(i), p0, p1, p2);
+					w += solid_angle(p, p0, p1, p2) / (4.0 * M_PI);
+				}
+			}
+		}
+	}
+	return w;
 }
 
-double dist_sq_vert(const DgPos& p, DgFace* f)
+double dist_sq_vert(const DgPos& q, const DgPos& p0, const DgPos& p1, const DgPos& p2)
 {
-	double min_d = dist_sq(p, f->getVertexPos(0));
-	min_d = MIN(min_d, dist_sq(p, f->getVertexPos(1)));
-	min_d = MIN(min_d, dist_sq(p, f->getVertexPos(2)));
+	double min_d = norm_sq(q - p0);
+	min_d = MIN(min_d, norm_sq(q - p1));
+	min_d = MIN(min_d, norm_sq(q - p2));
 	return min_d;
 }
 
-double dist_sq(const DgPos& q, DgFace* f)
+double dist_sq(const DgPos& q, const DgPos& p0, const DgPos& p1, const DgPos& p2)
 {
-	// ﰢ    ͸ Ѵ.
-	DgPos p0 = f->getVertexPos(0);
-	DgPos p1 = f->getVertexPos(1);
-	DgPos p2 = f->getVertexPos(2);
-	DgVec3 v01 = p1 - p0;
-	DgVec3 v12 = p2 - p1;
-	DgVec3 v20 = p0 - p2;
+	DgPos closest;
+	return dist_sq(q, p0, p1, p2, closest);
+}
 
-	// Case 1:  ִ Ÿ  
-	bool p01q, p02q, p12q, p10q, p20q, p21q;
-	// true if order of points is q -> p0 -> p1 (about the axis v01)
-	p01q = (v01 * (q - p0) < 0.0);
-	// true if order of points is q -> p0 -> p2 (about the axis p13)
-	p02q = (v20 * (q - p0) > 0.0);
-	// true if order of points is q -> p1 -> p2 (about the axis v12)
-	p12q = (v12 * (q - p1) < 0.0);
-	// true if order of points is q -> p1 -> p0 (about the axis p21)
-	p10q = (v01 * (q - p1) > 0.0);
-	// true if order of points is q -> p2 -> p0 (about the axis v20)
-	p20q = (v20 * (q - p2) < 0.0);
-	// true if order of points is q -> p2 -> p1 (about the axis p32)
-	p21q = (v12 * (q - p2) > 0.0);
+double dist_sq(const DgPos& q, const DgPos& a, const DgPos& b, const DgPos& c, DgPos& closest, int* pFeature)
+{
+	// 삼각형의 에지 벡터를 구한다.
+	DgVec3 ab = b - a;
+	DgVec3 ac = c - a;
 
-	// p0  ִ Ÿ ߻
-	if (p01q && p02q)
+	// 정점 a의 보로노이 영역
+	DgVec3 ap = q - a;
+	double d1 = ab * ap;
+	double d2 = ac * ap;
+	if (d1 <= 0.0 && d2 <= 0.0)
 	{
-		return distance_sq(q, p0);
+		closest = a;
+		if (pFeature != NULL)
+			*pFeature = 0;
+		return norm_sq(q - closest);
 	}
-	else if (p10q && p12q)		// p1  ִ Ÿ ߻
+
+	// 정점 b의 보로노이 영역
+	DgVec3 bp = q - b;
+	double d3 = ab * bp;
+	double d4 = ac * bp;
+	if (d3 >= 0.0 && d4 <= d3)
 	{
-		return distance_sq(q, p1);
+		closest = b;
+		if (pFeature != NULL)
+			*pFeature = 1;
+		return norm_sq(q - closest);
 	}
-	else if (p20q && p21q)		// p2  ִ Ÿ ߻
+
+	// 에지 (a, b)의 보로노이 영역
+	double vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
 	{
-		return distance_sq(q, p2);
+		double v = d1 / (d1 - d3);
+		closest = a + v * ab;
+		if (pFeature != NULL)
+			*pFeature = 3;
+		return norm_sq(q - closest);
 	}
 
-	// Case 2:  ִ Ÿ ߻ϴ 
-	DgVec3 n = (v20 ^ v01).normalize();
-	DgVec3 p0q = v01 ^ n; // outward direction of edge(p0, p1)
-	DgVec3 p1q = v12 ^ n; // outward direction of edge(p1, p2)
-	DgVec3 p2q = v20 ^ n; // outward direction of edge(p2, p0)
-
-	//  (p0, p1) ִ Ÿ ߻ϴ 
-	if (!p01q && !p10q && (p0q * (q - p0) > 0.0))
+	// 정점 c의 보로노이 영역
+	DgVec3 cp = q - c;
+	double d5 = ab * cp;
+	double d6 = ac * cp;
+	if (d6 >= 0.0 && d5 <= d6)
 	{
-		p0q.normalize();
-		v01.normalize();
-		return ((p0q * (q - p0)) * (p0q * (q - p0)) + (n * (q - p0)) * (n * (q - p0)));
+		closest = c;
+		if (pFeature != NULL)
+			*pFeature = 2;
+		return norm_sq(q - closest);
 	}
-	//  (p1, p2) ִ Ÿ ߻ϴ 
-	else if (!p12q && !p21q && (p1q * (q - p1) > 0.0))
+
+	// 에지 (c, a)의 보로노이 영역
+	double vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
 	{
-		p1q.normalize();
-		v12.normalize();
-		return ((p1q * (q - p1)) * (p1q * (q - p1)) + (n * (q - p1)) * (n * (q - p1)));
+		double w = d2 / (d2 - d6);
+		closest = a + w * ac;
+		if (pFeature != NULL)
+			*pFeature = 5;
+		return norm_sq(q - closest);
 	}
-	//  (p2, p0) ִ Ÿ ߻ϴ 
-	else if (!p20q && !p02q && (p2q * (q - p2) > 0.0))
+
+	// 에지 (b, c)의 보로노이 영역
+	double va = d3 * d6 - d5 * d4;
+	if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
 	{
-		p2q.normalize();
-		v20.normalize();
-		return ((p2q * (q - p2)) * (p2q * (q - p2)) + (n * (q - p2)) * (n * (q - p2)));
+		double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+		closest = b + w * (c - b);
+		if (pFeature != NULL)
+			*pFeature = 4;
+		return norm_sq(q - closest);
 	}
 
-	// Case 3: ﰢ ο ִ Ÿ ߻ϴ 
-	return (n * (q - p0)) * (n * (q - p0));
+	// 삼각형 내부에서 최단 거리가 발생하는 경우
+	double denom = 1.0 / (va + vb + vc);
+	double v = vb * denom;
+	double w = vc * denom;
+	closest = a + (ab * v + ac * w);
+	if (pFeature != NULL)
+		*pFeature = 6;
+	return norm_sq(q - closest);
 }
 
+double solid_angle(const DgPos& p, const DgPos& p0, const DgPos& p1, const DgPos& p2)
+{
+	DgVec3 a = p0 - p;
+	DgVec3 b = p1 - p;
+	DgVec3 c = p2 - p;
+	double la = norm(a);
+	double lb = norm(b);
+	double lc = norm(c);
+
+	// tan(Omega / 2) = det(a, b, c) / (|a||b||c| + (a.b)|c| + (b.c)|a| + (c.a)|b|)
+	double det = a * (b ^ c);
+	double denom = la * lb * lc + (a * b) * lc + (b * c) * la + (c * a) * lb;
+	return 2.0 * atan2(det, denom);
+}
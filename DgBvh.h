@@ -3,210 +3,547 @@
 
 /*!
  *	\class	DgBvh
- *	\brief	AABB (Axis-Aligned Bounding Box) Ÿ BVH (Bounding Volume Hierarchy) ǥϴ Ŭ
- *	\note	 : 2021-02-23
+ *	\brief	AABB (Axis-Aligned Bounding Box) 타입의 BVH (Bounding Volume Hierarchy)를 표현하는 클래스
+ *	\note	마지막 수정일: 2021-02-23
  *
- *	\author ѻ, 
+ *	\author 한상준, 윤승현
  */
 class DgBvh
 {
 public:
 	/*!
-	 *	\class	AaBb (Axis-Alined Bounding Box)
-	 *	\brief	AABB Ÿ  ڸ ǥϴ Ŭ
-	 *	\note	 : 2021-04-07
-	 *
-	 *	\author ѻ, 
+	 *	\struct	Node
+	 *	\brief	4개의 자식을 갖는 BVH 노드(깊이 우선 순서로 연속 배열에 저장)
+	 *	\note	자식의 경계 상자는 SoA 형태의 float 좌표로 저장하며, 정밀도 손실로 인해 상자가
+	 *			줄어들지 않도록 바깥쪽으로 반올림한다.
 	 */
-	class AaBb
+	struct alignas(64) Node
 	{
-	public:
-		/* \brief  ޽   */
-		DgMesh* mMesh;
-
-		/* \brief  ڿ Ե ﰢ Ʈ */
-		std::vector<DgFace*> mFaces;
-
-		/* \brief   ּ ġ */
-		DgPos mMin;
-
-		/* \brief   ִ ġ */
-		DgPos mMax;
-
-		/* \brief   BVH  */
-		int mDepth;
-
-		/* \brief     */
-		bool mIsLeaf;
-
-		/* \brief   ڿ   */
-		std::vector<AaBb*> mChildNodes;
-
-	public:
-		/*!
-		 *	\brief	Ʈ 
-		 */
-		AaBb();
-
-		/*!
-		 *	\brief	ﰢ Ʈ ٿϴ  ڿ   (ʿ ) Ѵ.
-		 *	\param[in]	pMesh		޽ 
-		 *	\param[in]	faces		 ڿ Ե ﰢ Ʈ
-		 *	\param[in]	depth		  BVH 
-		 */
-		AaBb(DgMesh* pMesh, std::vector<DgFace*>& faces, const int depth);
-
-		/*!
-		 *	\brief	Ҹ
-		 */
-		~AaBb();
-
-		/*!
-		 *	\brief	 ڸ  (ִ ) Ͽ 4  ڸ Ѵ.
-		 */
-		void divide();
-
-		/*!
-		 *	\brief	    ִ Ÿ  Ѵ.
-		 *	\note	   ο ԵǾٸ 0 ȯѴ.
-		 *
-		 *	\param[in]	p	 ġ
-		 *
-		 *	\return     ִ Ÿ  ȯѴ.
-		 */
-		double getSqrDist(const DgPos& p);
-
-		/*!
-		 *	\brief	ﰢ    θ ˻Ѵ.
-		 *
-		 *	\param[in]	p0		 ﰢ ù ° 
-		 *	\param[in]	p1		 ﰢ  ° 
-		 *	\param[in]	p2		 ﰢ  ° 
-		 *
-		 *	\return ﰢ  ڰ ϸ true, ƴϸ false ȯѴ.
-		 */
-		bool intersectWithTri(const DgPos& p0, const DgPos& p1, const DgPos& p2);
+		/* \brief 자식 경계 상자의 최소 좌표([축][자식]) */
+		float mMin[3][4];
+
+		/* \brief 자식 경계 상자의 최대 좌표([축][자식]) */
+		float mMax[3][4];
+
+		/* \brief 자식 참조: 0 이상이면 내부 노드의 인덱스, 음수이면 리프(삼각형 시작 위치 = -mChild - 1) */
+		int mChild[4];
+
+		/* \brief 리프 자식의 삼각형 개수(내부 노드는 0, 빈 리프는 0) */
+		int mCount[4];
+	};
+
+	/*!
+	 *	\struct	Dipole
+	 *	\brief	일반화 와인딩 넘버의 원거리 근사를 위한 자식 경계 상자의 다이폴 정보
+	 */
+	struct Dipole
+	{
+		/* \brief 면적 가중 법선 합(sum(A_i * n_i)) */
+		float mAreaNormal[3];
+
+		/* \brief 다이폴의 중심(삼각형 무게중심의 면적 가중 평균) */
+		float mCenter[3];
+
+		/* \brief 중심으로부터 모든 삼각형 정점을 포함하는 반지름 */
+		float mRadius;
+
+		/* \brief 포함된 삼각형의 면적 합 */
+		float mArea;
 	};
 
 public:
-	/* \brief  ޽   */
+	/* \brief 대상 메쉬에 대한 포인터 */
 	DgMesh* mMesh;
 
-	/* \brief ֻ  ڿ   */
-	AaBb*	mRoot;
+	/* \brief 깊이 우선 순서로 저장된 BVH 노드 배열(mNodes[0]이 루트 노드) */
+	std::vector<Node> mNodes;
+
+	/* \brief 자식 경계 상자별 다이폴 정보(인덱스: 노드 인덱스 * 4 + 자식 번호) */
+	std::vector<Dipole> mDipoles;
+
+	/* \brief 리프가 참조하는 삼각형 인덱스 배열(mMesh->mFaces의 인덱스, 리프 단위로 연속) */
+	std::vector<int> mFaceIdxs;
+
+	/* \brief 전체 경계 상자의 최소 위치 */
+	DgPos mMin;
+
+	/* \brief 전체 경계 상자의 최대 위치 */
+	DgPos mMax;
 
-	/* \brief  ޽   */
+	/* \brief 대상 메쉬를 복제 여부 */
 	bool	mCopy;
 
+	/*!
+	 *	\brief BVH 생성 방식: 중점 4분할, SAH(Surface Area Heuristic) 구간 분할 또는 모튼 코드 기반 선형 BVH
+	 *	\note	삼각형이 BVH_LBVH_THRESHOLD개 이상이면 지정한 방식과 무관하게 BUILD_LBVH로 생성한다.
+	 */
+	enum TypeBuild {
+		BUILD_MIDPOINT = 0,
+		BUILD_SAH = 1,
+		BUILD_LBVH = 2,
+	};
+
+	TypeBuild mBuildType;
+
+	/* \brief 루트부터 가장 깊은 리프까지의 내부 노드 개수(탐색 스택 크기 확인용) */
+	int mDepth;
+
+	/* \brief 생성 직후 트리의 SAH 비용(루트 표면적으로 정규화) */
+	double mBuildCost;
+
+	/* \brief 현재 트리의 SAH 비용(refit 후 갱신) */
+	double mCost;
+
+	/* \brief 깊이별 내부 노드 인덱스 목록(refit에서 상향식 병렬 갱신에 사용, 처음 refit할 때 생성) */
+	std::vector<std::vector<int>> mLevels;
+
+	/* \brief 정점별 각도 가중 의사 법선(인덱스: mMesh->mVerts의 인덱스) */
+	std::vector<DgVec3> mVertNormals;
+
+	/* \brief 삼각형 에지별 의사 법선(인덱스: 삼각형 인덱스 * 3 + k, 에지 (v_k, v_k+1)) */
+	std::vector<DgVec3> mEdgeNormals;
+
+	/* \brief 경계 에지를 갖는 삼각형 여부(인덱스: 삼각형 인덱스) */
+	std::vector<bool> mBndryFaces;
+
 public:
 	/*!
-	 *	\brief	
+	 *	\brief	생성자
 	 */
 	DgBvh();
 
 	/*!
-	 *	\brief	 ޽  BVH Ѵ.
+	 *	\brief	대상 메쉬에 대한 BVH를 생성한다.
+	 *
+	 *	\param[in]	pMesh	대상 메쉬
+	 *	\param[in]	type	BVH 생성 방식
+	 */
+	DgBvh(DgMesh* pMesh, TypeBuild type = BUILD_MIDPOINT);
+
+	/*!
+	 *	\brief	캐시 파일이 유효하면 읽어 들이고, 없거나 오래되었다면 BVH를 생성하여 캐시 파일에 저장한다.
+	 *	\note	캐시는 메쉬의 정점 좌표와 삼각형 인덱스의 해시, 파일 버전, 노드 크기, 생성 방식이 모두 같을 때만 사용한다.
 	 *
-	 *	\param[in]	pMesh	 ޽
+	 *	\param[in]	pMesh		대상 메쉬
+	 *	\param[in]	cacheFile	캐시 파일 이름(NULL 또는 빈 문자열이면 캐시를 사용하지 않음)
+	 *	\param[in]	type		BVH 생성 방식
 	 */
-	DgBvh(DgMesh* pMesh);
+	DgBvh(DgMesh* pMesh, const char* cacheFile, TypeBuild type = BUILD_MIDPOINT);
 
 	/*!
-	 *	\brief	κ ޽  BVH Ѵ.
+	 *	\brief	부분 메쉬에 대한 BVH를 생성한다.
 	 *
-	 *	\param[in]	subFaces	κ ޽ ﰢ 迭
+	 *	\param[in]	pMesh		부분 메쉬를 포함하는 메쉬
+	 *	\param[in]	subFaces	부분 메쉬의 삼각형 배열(pMesh->mFaces의 원소)
+	 *	\param[in]	type		BVH 생성 방식
 	 */
-	DgBvh(std::vector<DgFace*>& subFaces);
+	DgBvh(DgMesh* pMesh, std::vector<DgFace*>& subFaces, TypeBuild type = BUILD_MIDPOINT);
 
 	/*!
-	 *	\brief	Է  BVH Ѵ.
+	 *	\brief	입력 정보로 BVH를 생성한다.
 	 *
-	 *	\param[in]	verts	 Ʈ
-	 *	\param[in]	faces	ﰢ ϴ  ε Ʈ
+	 *	\param[in]	verts	정점의 리스트
+	 *	\param[in]	faces	삼각형을 구성하는 정점의 인덱스 리스트
 	 */
 	DgBvh(std::vector<DgPos>& verts, std::vector<int>& faces);
 
 	/*!
-	 *	\brief	Ҹ
+	 *	\brief	소멸자
 	 */
 	~DgBvh();
 
 	/*!
-	 *	\brief	 ޽  Ÿ ־ Ÿ  Ѵ.
+	 *	\brief	점과 메쉬 사이의 거리가 주어진 거리보다 가까운지 조사한다.
 	 *
-	 *	\param[in]	dist		Է Ÿ
-	 *	\param[in]	p			  ġ
-	 *	\param[in]	bVertOnly	 ޽   Ÿ ϸ true,  ޽ ﰢ  Ÿ ϸ false
+	 *	\param[in]	dist		입력 거리
+	 *	\param[in]	p			조사할 점의 위치
+	 *	\param[in]	bVertOnly	점과 메쉬 정점 사이의 거리만을 조사하면 true, 점과 메쉬 삼각형 사이의 거리를 조사하면 false
 	 *
-	 *	\return  ޽  Ÿ ־ Ÿ  true, ƴϸ false ȯѴ.
+	 *	\return 정점과 메쉬 사이의 거리가 주어진 거리보다 가까우면 true, 아니면 false를 반환한다.
 	 */
 	bool isCloserThan(double dist, const DgPos& p, bool bVertOnly);
 
 	/*!
-	 *	\brief	 ޽ ִ Ÿ Ѵ.
+	 *	\brief	점과 메쉬의 최단 거리를 계산한다.
 	 *
-	 *	\param[in]	p		 ġ
-	 *	\param[out]	q		ִ Ÿ ߻ϴ ޽   ȴ.
-	 *	\param[out]	pFace	ִ Ÿ ߻ϴ ﰢ Ͱ ȴ.
-	 *	\param[in]	bSinged	 Ÿ ȯ 
+	 *	\param[in]	p		점의 위치
+	 *	\param[out]	q		최단 거리가 발생하는 메쉬 위의 점이 저장된다.
+	 *	\param[out]	pFace	최단 거리가 발생하는 삼각형의 포인터가 저장된다.
+	 *	\param[in]	bSinged	음수 거리 변환 여부
 	 *
-	 *	\return  ִ Ÿ ȯѴ.
+	 *	\return 계산된 최단 거리를 반환한다.
 	 */
 	double computeDistance(DgPos p, DgPos& q, DgFace** pFace, bool bSigned);
 
 	/*!
-	 *	\brief	 ޽ ִ Ÿ Ѵ.
+	 *	\brief	점과 메쉬의 최단 거리를 계산한다.
 	 *
-	 *	\param[in]	p		 ġ
-	 *	\param[out]	q		ִ Ÿ ߻ϴ ޽   ȴ.
-	 *	\param[out]	fidx	ִ Ÿ ߻ϴ ﰢ ε ȴ.
-	 *	\param[in]	sign	 Ÿ ȯ 
+	 *	\param[in]	p		점의 위치
+	 *	\param[out]	q		최단 거리가 발생하는 메쉬 위의 점이 저장된다.
+	 *	\param[out]	fidx	최단 거리가 발생하는 삼각형의 인덱스가 저장된다.
+	 *	\param[in]	sign	음수 거리 변환 여부
 	 *
-	 *	\return  ִ Ÿ ȯѴ.
+	 *	\return 계산된 최단 거리를 반환한다.
 	 */
 	double computeDistance(DgPos p, DgPos& q, int& fidx, bool sign);
 
 	/*!
-	 *	\brief	Է ﰢ ϴ BVH  ﰢ ã´.
+	 *	\brief	여러 점과 메쉬의 최단 거리를 병렬로 계산한다.
+	 *	\note	질의점을 모튼(Morton) 순서로 정렬하여 연속된 구간을 스레드에 분배하므로 인접 질의가 같은 노드를 방문하며,
+	 *			bSeed가 true이면 직전 질의점의 최근접 삼각형까지의 거리를 초기 상한으로 사용한다.
+	 *			결과는 질의점마다 computeDistance()를 호출한 것과 같다.
 	 *
-	 *	\param[in]	fB				Է ﰢ
-	 *	\param[out]	crossFacesA		Է ﰢ ϴ BVH  ﰢ ȴ.
-	 *	\param[out]	cutSegmentsB	fB   е ȴ.
+	 *	\param[in]	pts			질의점 배열
+	 *	\param[in]	numPts		질의점의 개수
+	 *	\param[out]	dists		질의점별 최단 거리가 저장된다.
+	 *	\param[out]	closest		질의점별 메쉬 위의 최근접점이 저장된다(NULL이면 무시).
+	 *	\param[out]	fidxs		질의점별 최근접 삼각형의 인덱스가 저장된다(NULL이면 무시).
+	 *	\param[in]	bSigned		음수 거리 변환 여부
+	 *	\param[in]	bSeed		직전 질의점의 결과로 초기 상한을 설정할지 여부
+	 *	\param[in]	numThreads	사용할 스레드 개수(0: 모든 코어)
+	 */
+	void computeDistances(const DgPos* pts, int numPts, double* dists, DgPos* closest, int* fidxs,
+		bool bSigned, bool bSeed = true, int numThreads = 0);
+
+	/*!
+	 *	\brief	입력 삼각형과 교차하는 BVH의 모든 삼각형을 찾는다.
 	 *
-	 *	\return ġ   fB  ʿ  -1, ƴϸ fB ϴ ﰢ  ȯѴ.
+	 *	\param[in]	fB				입력 삼각형
+	 *	\param[out]	crossFacesA		입력 삼각형과 교차하는 BVH의 모든 삼각형이 저장된다.
+	 *	\param[out]	cutSegmentsB	fB에 놓인 교차 선분들이 저장된다.
+	 *
+	 *	\return 수치 안정성을 위해 fB의 교란이 필요한 경우 -1, 아니면 fB와 교차하는 삼각형의 수를 반환한다.
 	 */
 	//int intersectWithTri(DgFace* fB, std::vector<DgFace*>& crossFacesA, std::vector<Segment>& cutSegmentsB);
 	//int intersectWithTri2(DgFace* fB, std::unordered_map<DgFace*, std::vector<Segment>>& faceToSegmentsA, std::unordered_map <DgFace*, std::vector<Segment>>& faceToSegmentsB);
 
 	/*!
-	 *	\brief	Է ﰢ ϴ  ﰢ ã´.
+	 *	\brief	입력 삼각형과 교차하는 모든 삼각형을 찾는다.
 	 *
-	 *	\param[in]	u0			Է ﰢ ù °  ǥ
-	 *	\param[in]	u1			Է ﰢ  °  ǥ
-	 *	\param[in]	u2			Է ﰢ  °  ǥ
-	 *	\param[out]	hitFaces	Է ﰢ ϴ ﰢ ȴ.
+	 *	\param[in]	u0			입력 삼각형의 첫 번째 정점의 좌표
+	 *	\param[in]	u1			입력 삼각형의 두 번째 정점의 좌표
+	 *	\param[in]	u2			입력 삼각형의 세 번째 정점의 좌표
+	 *	\param[out]	hitFaces	입력 삼각형과 교차하는 삼각형이 저장된다.
 	 *
-	 *	\return Է ﰢ ϴ ﰢ  ȯѴ.
+	 *	\return 입력 삼각형과 교차하는 삼각형의 수를 반환한다.
 	 */
 	int intersectWithTri(const DgPos& u0, const DgPos& u1, const DgPos& u2, std::vector<DgFace*>& hitFaces);
+
+	/*!
+	 *	\brief	광선과 가장 먼저 교차하는 삼각형을 찾는다.
+	 *	\note	삼각형 교차는 watertight 방식(Woop et al. 2013)으로 계산하므로 공유 에지와 정점을 통과하는 광선도 놓치지 않는다.
+	 *
+	 *	\param[in]	org		광선의 시작점
+	 *	\param[in]	dir		광선의 방향(정규화하지 않아도 됨, t는 dir의 배수)
+	 *	\param[in]	tmax	교차를 조사할 최대 광선 파라미터
+	 *	\param[out]	t		교차점의 광선 파라미터가 저장된다.
+	 *	\param[out]	pFace	교차한 삼각형의 포인터가 저장된다.
+	 *
+	 *	\return 교차하는 삼각형이 있으면 true, 없으면 false를 반환한다.
+	 */
+	bool intersectRay(const DgPos& org, const DgVec3& dir, double tmax, double& t, DgFace** pFace);
+
+	/*!
+	 *	\brief	광선이 (0, tmax] 구간에서 임의의 삼각형과 교차하는지 조사한다.
+	 *
+	 *	\param[in]	org		광선의 시작점
+	 *	\param[in]	dir		광선의 방향
+	 *	\param[in]	tmax	교차를 조사할 최대 광선 파라미터
+	 *
+	 *	\return 교차하는 삼각형이 있으면 true, 없으면 false를 반환한다.
+	 */
+	bool isOccluded(const DgPos& org, const DgVec3& dir, double tmax);
+
+	/*!
+	 *	\brief	반직선과 교차하는 삼각형의 개수를 구한다(광선 패리티에 의한 내외부 판정용).
+	 *
+	 *	\param[in]	org		광선의 시작점
+	 *	\param[in]	dir		광선의 방향
+	 *
+	 *	\return 교차하는 삼각형의 개수를 반환한다.
+	 */
+	int countRayHits(const DgPos& org, const DgVec3& dir);
+
+	/*!
+	 *	\brief	방향이 비슷한 광선 묶음(최대 BVH_PACKET_SIZE개)을 한 번의 트리 탐색으로 교차시킨다.
+	 *	\note	하나 이상의 광선이 교차하는 자식만 방문하므로 화면 픽셀처럼 인접한 광선에서 노드 방문 횟수가 줄어든다.
+	 *
+	 *	\param[in]		orgs		광선의 시작점 배열
+	 *	\param[in]		dirs		광선의 방향 배열
+	 *	\param[in]		numRays		광선의 개수(4 또는 8 권장, 최대 BVH_PACKET_SIZE)
+	 *	\param[in,out]	ts			광선별 최대 파라미터를 입력하면 교차점의 파라미터가 저장된다.
+	 *	\param[out]		pFaces		광선별 교차 삼각형의 포인터가 저장된다(교차하지 않으면 NULL).
+	 */
+	void intersectRays(const DgPos* orgs, const DgVec3* dirs, int numRays, double* ts, DgFace** pFaces);
+
+	/*!
+	 *	\brief	메쉬 정점이 이동한 후 트리 구조를 유지한 채 경계 상자와 다이폴 정보를 다시 계산한다.
+	 *	\note	같은 깊이의 노드를 병렬로 갱신하며 가장 깊은 레벨부터 루트까지 올라간다.
+	 *			갱신된 트리의 SAH 비용이 생성 직후 비용의 maxRatio배를 넘으면 트리를 다시 생성한다.
+	 *
+	 *	\param[in]	maxRatio	재생성을 결정하는 SAH 비용의 최대 증가 비율
+	 *
+	 *	\return 트리를 다시 생성했다면 true, 아니면 false를 반환한다.
+	 */
+	bool refit(double maxRatio = 1.5);
+
+	/*!
+	 *	\brief	BVH를 바이너리 캐시 파일로 저장한다.
+	 *
+	 *	\param[in]	fname	파일 이름
+	 *
+	 *	\return 저장에 성공하면 true, 아니면 false를 반환한다.
+	 */
+	bool save(const char* fname) const;
+
+	/*!
+	 *	\brief	바이너리 캐시 파일을 메모리 매핑하여 BVH를 읽어 들인다.
+	 *	\note	노드, 다이폴, 삼각형 인덱스 배열은 파일에 그대로 저장되어 있으므로 매핑된 영역에서 한 번에 복사한다.
+	 *
+	 *	\param[in]	fname	파일 이름
+	 *
+	 *	\return 파일이 현재 메쉬와 생성 방식에 대하여 유효하면 true, 없거나 오래되었다면 false를 반환한다.
+	 */
+	bool load(const char* fname);
+
+	/*!
+	 *	\brief	메쉬의 정점 좌표와 삼각형 정점 인덱스에 대한 64비트 해시(FNV-1a)를 계산한다.
+	 */
+	unsigned long long computeMeshHash() const;
+
+	/*!
+	 *	\brief	BVH 노드와 삼각형 인덱스 배열이 차지하는 메모리 크기(byte)를 반환한다.
+	 */
+	size_t getMemory() const;
+
+	/*!
+	 *	\brief	점에 대한 메쉬의 일반화 와인딩 넘버(generalized winding number)를 계산한다.
+	 *	\note	점에서 충분히 먼(거리 > beta * 반지름) 경계 상자는 다이폴로 근사(Barnes-Hut)하고,
+	 *			가까운 리프 경계 상자는 삼각형의 입체각을 정확히 계산한다.
+	 *			열린 메쉬나 자기 교차 메쉬에서도 내부는 1, 외부는 0에 가까운 값을 가진다.
+	 *
+	 *	\param[in]	p		점의 위치
+	 *	\param[in]	beta	다이폴 근사의 허용 비율 (클수록 정확하고 느림)
+	 *
+	 *	\return 계산된 와인딩 넘버를 반환한다.
+	 */
+	double computeWindingNumber(const DgPos& p, double beta = 2.0);
+
+private:
+	/*!
+	 *	\brief	점과 가장 가까운 삼각형과 최단 거리 제곱을 구한다.
+	 *
+	 *	\param[in]		p		점의 위치
+	 *	\param[out]		q		최단 거리가 발생하는 메쉬 위의 점이 저장된다.
+	 *	\param[in,out]	pFace	NULL이 아니면 초기 상한으로 사용할 삼각형, 최근접 삼각형의 포인터가 저장된다.
+	 *
+	 *	\return 계산된 최단 거리 제곱을 반환한다.
+	 */
+	double findClosest(const DgPos& p, DgPos& q, DgFace** pFace);
+
+	/*!
+	 *	\brief	최근접점의 의사 법선(pseudo normal)으로 거리의 부호를 결정한다.
+	 *
+	 *	\param[in]	p		점의 위치
+	 *	\param[in]	q		메쉬 위의 최근접점
+	 *	\param[in]	pFace	최근접 삼각형
+	 *	\param[in]	sqrDist	최단 거리 제곱
+	 *
+	 *	\return 부호가 적용된 거리를 반환한다.
+	 */
+	double signedDistance(const DgPos& p, const DgPos& q, DgFace* pFace, double sqrDist);
+
+	/*!
+	 *	\brief	삼각형 인덱스 배열의 구간 [first, first + count)에 대한 노드를 깊이 우선 순서로 생성한다.
+	 *	\note	경계 상자를 두 축(최단축 제외)의 중점으로 분할하여 4개의 자식을 생성한다.
+	 *
+	 *	\param[in]	first	구간의 시작 위치
+	 *	\param[in]	count	구간의 삼각형 개수
+	 *	\param[in]	depth	노드의 BVH 레벨
+	 *
+	 *	\return 생성된 노드의 인덱스를 반환한다.
+	 */
+	int buildMidpoint(int first, int count, int depth);
+
+	/*!
+	 *	\brief	삼각형 인덱스 배열의 구간 [first, first + count)에 대한 노드를 SAH로 생성한다.
+	 *	\note	무게중심을 NUM_SAH_BINS개의 구간으로 나누어 이진 SAH 분할을 두 번 적용하고(최대 4개의 자식),
+	 *			MAX_BVH_LEAF_SIZE개 이하의 삼각형을 갖는 자식은 리프가 된다.
+	 *
+	 *	\param[out]	nodes		생성된 노드가 추가될 배열
+	 *	\param[out]	dipoles		생성된 다이폴 정보가 추가될 배열
+	 *	\param[in]	first		구간의 시작 위치
+	 *	\param[in]	count		구간의 삼각형 개수
+	 *	\param[in]	bounds		삼각형별 경계 상자와 무게중심(최소 3개, 최대 3개, 중심 3개의 float)
+	 *	\param[out]	pending		grain개 이하의 삼각형을 갖는 하위 트리를 지연시킬 경우 (슬롯, 시작, 개수)가 저장된다.
+	 *	\param[in]	grain		지연시킬 하위 트리의 최대 삼각형 개수(0: 지연하지 않음)
+	 *
+	 *	\return 생성된 노드의 인덱스를 반환한다.
+	 */
+	int buildSAH(std::vector<Node>& nodes, std::vector<Dipole>& dipoles, int first, int count,
+		const std::vector<float>& bounds, std::vector<int>* pending, int grain);
+
+	/*!
+	 *	\brief	삼각형 무게중심의 모튼 코드를 기수 정렬하고 이진 기수 트리(Karras 2012)를 O(n)에 구성하여 노드를 생성한다.
+	 *	\note	이진 트리의 두 레벨을 하나의 4분할 노드로 합치고, MAX_BVH_LEAF_SIZE개 이하의 구간은 리프가 된다.
+	 *			경계 상자와 다이폴 정보는 refitNodes()로 상향식 병렬 계산한다.
+	 */
+	void buildLBVH();
+
+	/*!
+	 *	\brief	이진 기수 트리의 노드를 4분할 노드로 합쳐 깊이 우선 순서로 생성한다(경계 상자는 계산하지 않음).
+	 *
+	 *	\param[in]	binNodes	이진 내부 노드별 (왼쪽 자식, 오른쪽 자식, 시작 위치, 삼각형 개수), 리프 자식은 ~위치
+	 *	\param[in]	ref			변환할 이진 내부 노드의 인덱스
+	 *
+	 *	\return 생성된 노드의 인덱스를 반환한다.
+	 */
+	int emitLBVH(const std::vector<int>& binNodes, int ref);
+
+	/*!
+	 *	\brief	트리 구조를 유지한 채 가장 깊은 레벨부터 루트까지 같은 레벨의 노드를 병렬로 갱신한다.
+	 */
+	void refitNodes();
+
+	/*!
+	 *	\brief	구간 [first, first + count)를 이진 SAH 비용이 최소가 되도록 제자리 분할한다.
+	 *
+	 *	\param[in]	first	구간의 시작 위치
+	 *	\param[in]	count	구간의 삼각형 개수
+	 *	\param[in]	bounds	삼각형별 경계 상자와 무게중심
+	 *
+	 *	\return 분할 위치를 반환한다(무게중심이 모두 같아 분할할 수 없다면 -1).
+	 */
+	int splitSAH(int first, int count, const std::vector<float>& bounds);
+
+	/*!
+	 *	\brief	전체 삼각형으로부터 BVH 노드를 생성한다.
+	 */
+	void build();
+
+	/*!
+	 *	\brief	노드 배열을 루트부터 깊이 우선(전위) 순서로 재배열한다.
+	 */
+	void relinearize();
+
+	/*!
+	 *	\brief	루트부터 가장 깊은 리프까지의 내부 노드 개수를 계산한다.
+	 */
+	int computeDepth() const;
+
+	/*!
+	 *	\brief	루트 노드의 자식 경계 상자로부터 전체 경계 상자(mMin, mMax)를 구한다.
+	 */
+	void updateBndBox();
+
+	/*!
+	 *	\brief	트리의 SAH 비용(자식 상자의 표면적 합, 리프는 삼각형 개수를 곱함)을 루트 표면적으로 정규화하여 계산한다.
+	 */
+	double computeCost() const;
+
+	/*!
+	 *	\brief	자식 슬롯의 경계 상자와 다이폴 정보를 다시 계산한다(내부 노드 자식은 손자 상자를 병합).
+	 *
+	 *	\param[in]	nodeIdx		노드 인덱스
+	 *	\param[in]	c			자식 번호
+	 */
+	void refitChild(int nodeIdx, int c);
+
+	/*!
+	 *	\brief	노드의 자식 슬롯에 리프 또는 내부 노드를 설정하고 경계 상자와 다이폴 정보를 계산한다.
+	 *
+	 *	\param[out]	nodes		노드 배열
+	 *	\param[out]	dipoles		다이폴 정보 배열
+	 *	\param[in]	nodeIdx		노드 인덱스
+	 *	\param[in]	c			자식 번호
+	 *	\param[in]	first		자식에 포함된 삼각형의 시작 위치
+	 *	\param[in]	count		자식에 포함된 삼각형의 개수
+	 *	\param[in]	childIdx	내부 노드 자식의 인덱스(리프인 경우 -1)
+	 */
+	void setChild(std::vector<Node>& nodes, std::vector<Dipole>& dipoles, int nodeIdx, int c, int first, int count, int childIdx);
+
+	/*!
+	 *	\brief	자식 슬롯의 삼각형 포인터를 반환한다.
+	 */
+	DgFace* getFace(int i) const { return &mMesh->mFaces[mFaceIdxs[i]]; }
+
+	/*!
+	 *	\brief	삼각형의 k번째 정점 위치를 메쉬의 정점 배열에서 읽어 반환한다.
+	 */
+	DgPos getVertPos(const DgFace* f, int k) const
+	{
+		const DgVertex& v = mMesh->mVerts[f->mVertIdxs[k]];
+		return DgPos(v.mPos[0], v.mPos[1], v.mPos[2]);
+	}
+
+	/*!
+	 *	\brief	삼각형의 세 정점 위치를 반환한다.
+	 */
+	void getFacePos(const DgFace* f, DgPos& p0, DgPos& p1, DgPos& p2) const
+	{
+		p0 = getVertPos(f, 0);
+		p1 = getVertPos(f, 1);
+		p2 = getVertPos(f, 2);
+	}
+
+	/*!
+	 *	\brief	삼각형의 인덱스(mMesh->mFaces의 인덱스)를 반환한다.
+	 */
+	int getFaceIdx(const DgFace* f) const { return (int)(f - mMesh->mFaces.data()); }
+
+	/*!
+	 *	\brief	부호 판정에 사용할 정점, 에지의 의사 법선과 경계 삼각형 정보를 계산한다.
+	 *	\note	정점 위치가 바뀌면 다시 계산해야 하며 생성자와 refit()에서 호출한다.
+	 */
+	void updatePseudoNormals();
 };
 
 /*!
- *	\brief	 ﰢ   ִ Ÿ  Ѵ.
+ *	\brief	점과 삼각형 정점 사이의 최단 거리 제곱을 계산한다.
+ *
+ *	\param[in]	q	점의 위치
+ *	\param[in]	p0	삼각형의 첫 번째 정점
+ *	\param[in]	p1	삼각형의 두 번째 정점
+ *	\param[in]	p2	삼각형의 세 번째 정점
+ *
+ *	\return 계산된 최단 거리 제곱을 반환한다.
+ */
+double dist_sq_vert(const DgPos& q, const DgPos& p0, const DgPos& p1, const DgPos& p2);
+
+/*!
+ *	\brief	점과 삼각형 사이의 최단 거리 제곱을 계산한다.
+ *
+ *	\param[in]	q	점의 위치
+ *	\param[in]	p0	삼각형의 첫 번째 정점
+ *	\param[in]	p1	삼각형의 두 번째 정점
+ *	\param[in]	p2	삼각형의 세 번째 정점
+ *
+ *	\return 계산된 최단 거리 제곱을 반환한다.
+ */
+double dist_sq(const DgPos& q, const DgPos& p0, const DgPos& p1, const DgPos& p2);
+
+/*!
+ *	\brief	점과 삼각형 사이의 최단 거리 제곱과 삼각형 위의 최근접점을 계산한다.
  *
- *	\param[in]	q	 ġ
- *	\param[in]	f	 ﰢ 
+ *	\param[in]	q			기준 위치
+ *	\param[in]	p0			삼각형의 첫 번째 정점
+ *	\param[in]	p1			삼각형의 두 번째 정점
+ *	\param[in]	p2			삼각형의 세 번째 정점
+ *	\param[out]	closest		삼각형 위의 최근접점이 저장된다.
+ *	\param[out]	pFeature	최근접점이 놓인 특징이 저장된다(0~2: 정점 k, 3~5: 에지 (v_k, v_k+1), 6: 내부).
  *
- *	\return  ִ Ÿ  ȯѴ.
+ *	\return 최단 거리 제곱을 반환한다.
  */
-double dist_sq_vert(const DgPos& p, DgFace* f);
+double dist_sq(const DgPos& q, const DgPos& p0, const DgPos& p1, const DgPos& p2, DgPos& closest, int* pFeature = NULL);
 
 /*!
- *	\brief	 ﰢ  ִ Ÿ  Ѵ.
+ *	\brief	점에서 바라본 삼각형의 부호 입체각을 계산한다(Van Oosterom-Strackee).
  *
- *	\param[in]	q	 ġ
- *	\param[in]	f	 ﰢ 
+ *	\param[in]	p	점의 위치
+ *	\param[in]	p0	삼각형의 첫 번째 정점
+ *	\param[in]	p1	삼각형의 두 번째 정점
+ *	\param[in]	p2	삼각형의 세 번째 정점
  *
- *	\return  ִ Ÿ  ȯѴ.
+ *	\return 삼각형의 법선 방향 기준 부호 입체각([-2pi, 2pi])을 반환한다.
  */
-double dist_sq(const DgPos& q, DgFace* f);
+double solid_angle(const DgPos& p, const DgPos& p0, const DgPos& p1, const DgPos& p2);
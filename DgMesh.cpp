@@ -1,20 +1,114 @@
 #include "DgViewer.h"
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #define STB_IMAGE_IMPLEMENTATION
 #include ".\\include\\STB\\stb_image.h"
-void DgMesh::setupBuffers()
+/*!
+*	\brief	Tipsify 알고리즘으로 삼각형 순서를 정점 캐시(post-transform cache)에 맞게 재배열
+*
+*	\param[in,out]	indices		삼각형 정점 인덱스 배열
+*	\param[in]		numVerts	정점의 개수
+*	\param[in]		cacheSize	가정하는 정점 캐시의 크기
+*/
+static void optimize_vertex_cache(std::vector<unsigned int>& indices, unsigned int numVerts, int cacheSize)
 {
-	if (mFaces.empty()) return;
+	int numTris = (int)indices.size() / 3;
+	if (numTris < 2)
+		return;
+
+	// 정점별 인접 삼각형 목록을 구성한다.
+	std::vector<int> offsets(numVerts + 1, 0), live(numVerts, 0);
+	for (unsigned int idx : indices)
+		live[idx]++;
+	for (unsigned int v = 0; v < numVerts; ++v)
+		offsets[v + 1] = offsets[v] + live[v];
+	std::vector<int> adjTris(indices.size()), fill(offsets.begin(), offsets.end() - 1);
+	for (int t = 0; t < numTris; ++t)
+		for (int j = 0; j < 3; ++j)
+			adjTris[fill[indices[3 * t + j]]++] = t;
+
+	std::vector<int> stamp(numVerts, 0), deadEnd, candidates;
+	std::vector<char> emitted(numTris, 0);
+	std::vector<unsigned int> result;
+	result.reserve(indices.size());
+	int time = cacheSize + 1, cursor = 0;
+	int fan = (int)indices[0];
+	while (fan >= 0)
+	{
+		// 부채 정점에 인접한 삼각형을 모두 출력하고
+		candidates.clear();
+		for (int a = offsets[fan]; a < offsets[fan + 1]; ++a)
+		{
+			int t = adjTris[a];
+			if (emitted[t])
+				continue;
+			for (int j = 0; j < 3; ++j)
+			{
+				int v = (int)indices[3 * t + j];
+				result.push_back(v);
+				deadEnd.push_back(v);
+				candidates.push_back(v);
+				live[v]--;
+				if (time - stamp[v] > cacheSize)
+					stamp[v] = time++;
+			}
+			emitted[t] = 1;
+		}
+
+		// 캐시에 남아 있으면서 남은 삼각형이 있는 정점 중 가장 오래된 정점을 다음 부채 정점으로 선택한다.
+		fan = -1;
+		int best = -1;
+		for (int v : candidates)
+		{
+			if (live[v] <= 0)
+				continue;
+			int priority = (time - stamp[v] + 2 * live[v] <= cacheSize) ? time - stamp[v] : 0;
+			if (priority > best)
+			{
+				best = priority;
+				fan = v;
+			}
+		}
+
+		// 후보가 없으면 최근 출력한 정점, 그다음 입력 순서의 정점으로 이동한다.
+		while (fan < 0 && !deadEnd.empty())
+		{
+			int v = deadEnd.back();
+			deadEnd.pop_back();
+			if (live[v] > 0)
+				fan = v;
+		}
+		while (fan < 0 && cursor < (int)numVerts)
+		{
+			if (live[cursor] > 0)
+				fan = cursor;
+			cursor++;
+		}
+	}
+	indices.swap(result);
+}
 
+void DgMesh::buildVertexStream(std::vector<float>& vertexData)
+{
 	const bool hasTexCoord = !mTexels.empty();
 
-	// 1)  :  ⺻ ϳ ߰, ߸ ε  fallback غ
+	// 1) 재질 보정: 없으면 기본재질 하나 추가, 잘못된 인덱스가 있으면 fallback 준비
 	bool hadMatsInitially = !mMaterials.empty();
 	size_t defaultMatIdx = 0;
 
 	if (!hadMatsInitially) {
-		mMaterials.emplace_back();           // ⺻  
-		// (ɼ) mMaterials.back().mName = "Default";
+		mMaterials.emplace_back();           // 기본 재질 생성
+		// (옵션) mMaterials.back().mName = "Default";
 		defaultMatIdx = 0;
 	}
 
@@ -26,24 +120,34 @@ void DgMesh::setupBuffers()
 	}
 	if (hadMatsInitially && needFallback) {
 		defaultMatIdx = mMaterials.size();
-		mMaterials.emplace_back();           // ʱ  ־ Ϻ face -1/  fallback ߰
-		// (ɼ) mMaterials.back().mName = "Default";
+		mMaterials.emplace_back();           // 초기 재질이 있었지만 일부 face가 -1/범위밖 → fallback 추가
+		// (옵션) mMaterials.back().mName = "Default";
 	}
 
-	// 2)  Ŷ غ
+	// 2) 재질별 버킷 준비
 	mVertexIndicesPerMtl.clear();
 	mVertexIndicesPerMtl.resize(mMaterials.size());
 
-	std::vector<float> vertexData;
-	unsigned int nextIndex = 0;
+	vertexData.clear();
+	vertexData.reserve(mFaces.size() * (hasTexCoord ? 8 : 6));
+	const int stride = hasTexCoord ? 8 : 6;
+
+	// (위치, 법선, 텍셀)이 같은 정점을 하나로 합치기 위한 개방 주소 해시 테이블(정점 번호 + 1, 0: 빈 칸)
+	size_t tableSize = 1;
+	while (tableSize < mFaces.size() * 3)
+		tableSize <<= 1;
+	tableSize <<= 1;
+	std::vector<unsigned int> table(tableSize, 0);
+	unsigned int numUnique = 0;
 
 	for (size_t i = 0; i < mFaces.size(); ++i)
 	{
-		const DgFace& face = mFaces[i];
+		DgFace& face = mFaces[i];
 
-		// ȿ  ε (ų  ̸ defaultMatIdx)
-		size_t bucket = (face.mMtlIdx >= 0 && face.mMtlIdx < (int)mMaterials.size())
-			? (size_t)face.mMtlIdx : defaultMatIdx;
+		// 유효 재질 인덱스 선택(없거나 범위 밖이면 defaultMatIdx), 다시 호출해도 재질이 추가되지 않도록 삼각형에 기록
+		if (face.mMtlIdx < 0 || face.mMtlIdx >= (int)mMaterials.size())
+			face.mMtlIdx = (int)defaultMatIdx;
+		size_t bucket = (size_t)face.mMtlIdx;
 
 		for (int j = 0; j < 3; ++j)
 		{
@@ -53,39 +157,117 @@ void DgMesh::setupBuffers()
 			const DgVertex& v = mVerts[vIdx];
 			const DgNormal& n = mNormals[nIdx];
 
-			// position
-			vertexData.push_back((float)v.mPos[0]);
-			vertexData.push_back((float)v.mPos[1]);
-			vertexData.push_back((float)v.mPos[2]);
-
-			// normal
-			vertexData.push_back((float)n.mDir[0]);
-			vertexData.push_back((float)n.mDir[1]);
-			vertexData.push_back((float)n.mDir[2]);
-
-			// texcoord (ɼ)
+			// position, normal, texcoord (옵션)
+			float attrib[8] = {
+				(float)v.mPos[0], (float)v.mPos[1], (float)v.mPos[2],
+				(float)n.mDir[0], (float)n.mDir[1], (float)n.mDir[2], 0.0f, 0.0f };
 			if (hasTexCoord) {
 				const int tIdx = face.mTexelIdxs[j];
 				const DgTexel& t = mTexels[tIdx];
-				vertexData.push_back((float)t.mST[0]);
-				vertexData.push_back((float)t.mST[1]);
+				attrib[6] = (float)t.mST[0];
+				attrib[7] = (float)t.mST[1];
+			}
+
+			// 속성 값의 해시로 기존 정점을 찾고, 없으면 새 정점을 추가한다.
+			unsigned long long h = 14695981039346656037ull;
+			const unsigned char* bytes = (const unsigned char*)attrib;
+			for (size_t b = 0; b < stride * sizeof(float); ++b)
+			{
+				h ^= bytes[b];
+				h *= 1099511628211ull;
+			}
+			size_t slot = (size_t)h & (tableSize - 1);
+			while (table[slot] != 0 && memcmp(&vertexData[(table[slot] - 1) * stride], attrib, stride * sizeof(float)) != 0)
+				slot = (slot + 1) & (tableSize - 1);
+			if (table[slot] == 0)
+			{
+				vertexData.insert(vertexData.end(), attrib, attrib + stride);
+				table[slot] = ++numUnique;
 			}
 
-			//  Ŷ ε push
-			mVertexIndicesPerMtl[bucket].push_back(nextIndex++);
+			// 재질 버킷에 인덱스 push
+			mVertexIndicesPerMtl[bucket].push_back(table[slot] - 1);
 		}
 	}
+	std::vector<unsigned int>().swap(table);
 
-	// 3) VAO/VBO ε
+	// 재질별로 삼각형 순서를 정점 캐시에 맞게 재배열하고
+	for (std::vector<unsigned int>& indices : mVertexIndicesPerMtl)
+		optimize_vertex_cache(indices, numUnique, VERTEX_CACHE_SIZE);
+
+	// 정점을 처음 참조되는 순서로 재배치하여 정점 읽기의 지역성을 높인다.
+	std::vector<unsigned int> remap(numUnique, UINT_MAX);
+	std::vector<float> sorted(vertexData.size());
+	unsigned int next = 0;
+	for (std::vector<unsigned int>& indices : mVertexIndicesPerMtl)
+	{
+		for (unsigned int& idx : indices)
+		{
+			if (remap[idx] == UINT_MAX)
+			{
+				memcpy(&sorted[next * stride], &vertexData[idx * stride], stride * sizeof(float));
+				remap[idx] = next++;
+			}
+			idx = remap[idx];
+		}
+	}
+	vertexData.swap(sorted);
+}
+
+/*!
+ *	\brief	인스턴스 버퍼에 저장되는 인스턴스별 정보(모델링 변환과 법선 변환)
+ */
+struct DgInstData
+{
+	glm::mat4 mModel;		// 모델링 변환(정점 속성 3~6)
+	glm::mat3 mNormal;		// 법선 변환(모델링 변환의 역전치, 정점 속성 7~9)
+};
+
+void DgMesh::setupBuffers()
+{
+	if (mFaces.empty()) return;
+
+	const bool hasTexCoord = !mTexels.empty();
+
+	// 캐시에서 읽은 메쉬는 매핑된 정점 스트림을 그대로 업로드하고, 아니면 스트림을 구성한다.
+	std::vector<float> vertexData;
+	const float* streamData = mCacheStream;
+	size_t streamSize = mCacheStreamSize;
+	if (streamData == nullptr)
+	{
+		buildVertexStream(vertexData);
+		streamData = vertexData.data();
+		streamSize = vertexData.size();
+	}
+
+	// 3) VAO/VBO 업로드
 	if (!mBuffersInitialized) {
 		glGenVertexArrays(1, &mVAO);
 		glGenBuffers(1, &mVBO);
+		glGenBuffers(1, &mEBO);
 		mBuffersInitialized = true;
 	}
+	mBuffersDirty = false;
 
 	glBindVertexArray(mVAO);
 	glBindBuffer(GL_ARRAY_BUFFER, mVBO);
-	glBufferData(GL_ARRAY_BUFFER, vertexData.size() * sizeof(float), vertexData.data(), GL_STATIC_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, streamSize * sizeof(float), streamData, GL_STATIC_DRAW);
+
+	// 4) 재질별 인덱스를 하나의 EBO에 이어 붙여 한 번만 업로드하고, 재질별 구간을 기록한다.
+	std::vector<unsigned int> indexData;
+	mMtlRanges.clear();
+	for (const std::vector<unsigned int>& indices : mVertexIndicesPerMtl)
+	{
+		mMtlRanges.emplace_back((GLsizei)indexData.size(), (GLsizei)indices.size());
+		indexData.insert(indexData.end(), indices.begin(), indices.end());
+	}
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mEBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexData.size() * sizeof(unsigned int), indexData.data(), GL_STATIC_DRAW);
+
+	// 업로드가 끝난 캐시 매핑은 해제한다(이후 갱신은 메쉬 데이터로부터 다시 구성).
+	mCacheStream = nullptr;
+	mCacheStreamSize = 0;
+	mCacheFile.reset();
 
 	const int stride = hasTexCoord ? 8 : 6;
 
@@ -100,15 +282,40 @@ void DgMesh::setupBuffers()
 		glEnableVertexAttribArray(2);
 	}
 
+	// 5) 인스턴스별 모델링 변환은 mat4를 열 단위로 속성 3~6에, 법선 변환은 mat3를 열 단위로 속성 7~9에 연결
+	if (mInstVBO == 0)
+		glGenBuffers(1, &mInstVBO);
+	glBindBuffer(GL_ARRAY_BUFFER, mInstVBO);
+	for (int c = 0; c < 4; ++c)
+	{
+		glVertexAttribPointer(3 + c, 4, GL_FLOAT, GL_FALSE, sizeof(DgInstData), (void*)(offsetof(DgInstData, mModel) + c * sizeof(glm::vec4)));
+		glEnableVertexAttribArray(3 + c);
+		glVertexAttribDivisor(3 + c, 1);
+	}
+	for (int c = 0; c < 3; ++c)
+	{
+		glVertexAttribPointer(7 + c, 3, GL_FLOAT, GL_FALSE, sizeof(DgInstData), (void*)(offsetof(DgInstData, mNormal) + c * sizeof(glm::vec3)));
+		glEnableVertexAttribArray(7 + c);
+		glVertexAttribDivisor(7 + c, 1);
+	}
+	mInstDirty = true;
+
 	glBindVertexArray(0);
 }
 
+int DgMesh::addInstance(const glm::mat4& mat)
+{
+	mInstMats.push_back(mat);
+	mInstDirty = true;
+	return NUM(mInstMats) - 1;
+}
+
 
 //void DgMesh::setupBuffers()
 //{
 //	if (mFaces.empty()) return;
 //
-//	bool hasTexCoord = !mTexels.empty();  // ؽó ǥ 
+//	bool hasTexCoord = !mTexels.empty();  // 텍스처 좌표 유무
 //
 //	std::vector<float> vertexData;
 //	mVertexIndicesPerMtl.clear();
@@ -146,7 +353,7 @@ void DgMesh::setupBuffers()
 //				vertexData.push_back((float)t.mST[1]);
 //			}
 //
-//			//  ε ߰
+//			// 재질별 인덱스 추가
 //			mVertexIndicesPerMtl[face.mMtlIdx].push_back(nextIndex++);
 //		}
 //	}
@@ -162,7 +369,7 @@ void DgMesh::setupBuffers()
 //	glBindBuffer(GL_ARRAY_BUFFER, mVBO);
 //	glBufferData(GL_ARRAY_BUFFER, vertexData.size() * sizeof(float), vertexData.data(), GL_STATIC_DRAW);
 //
-//	//  ̾ƿ: position (0), normal (1)
+//	// 공통 레이아웃: position (0), normal (1)
 //	int stride = hasTexCoord ? 8 : 6;
 //
 //	// layout(location = 0): position
@@ -183,52 +390,81 @@ void DgMesh::setupBuffers()
 //	glBindVertexArray(0);
 //}
 
-void DgMesh::render()
+void DgMesh::updateBuffers()
 {
-	if (!mBuffersInitialized)
+	if (!mBuffersInitialized || mBuffersDirty)
 		setupBuffers();
 
-	// ؽó  ؽó  ̴ 
-	bool hasTexture = false;
-	for (const auto& mat : mMaterials) {
-		if (mat.mTexId > 0) {
-			hasTexture = true;
-			break;
+	// 인스턴스 변환은 변경된 경우에만 법선 변환(역전치)을 인스턴스마다 한 번 계산하여 다시 업로드한다.
+	if (mInstDirty && mInstVBO != 0)
+	{
+		std::vector<DgInstData> insts(getNumInstances());
+		for (int i = 0; i < NUM(insts); ++i)
+		{
+			insts[i].mModel = mInstMats.empty() ? glm::mat4(1.0f) : mInstMats[i];
+			insts[i].mNormal = glm::transpose(glm::inverse(glm::mat3(insts[i].mModel)));
 		}
+		glBindBuffer(GL_ARRAY_BUFFER, mInstVBO);
+		glBufferData(GL_ARRAY_BUFFER, insts.size() * sizeof(DgInstData), insts.data(), GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		mInstDirty = false;
 	}
+}
+
+bool DgMesh::hasTexture() const
+{
+	for (const auto& mat : mMaterials) {
+		if (mat.mTexId > 0)
+			return true;
+	}
+	return false;
+}
+
+void DgMesh::setMaterial(const DgShader& shader, int mtlIdx)
+{
+	const DgMaterial& mtl = mMaterials[mtlIdx];
+
+	// 재질 계수 uniform 설정
+	glUniform3fv(shader.getLoc(DgShader::UNIFORM_KA), 1, mtl.mKa);
+	glUniform3fv(shader.getLoc(DgShader::UNIFORM_KD), 1, mtl.mKd);
+	glUniform3fv(shader.getLoc(DgShader::UNIFORM_KS), 1, mtl.mKs);
+	glUniform1f(shader.getLoc(DgShader::UNIFORM_NS), mtl.mNs);
+	glUniform1i(shader.getLoc(DgShader::UNIFORM_TEX), 0);
+}
+
+void DgMesh::drawMaterial(int mtlIdx)
+{
+	// VAO에 연결된 mEBO의 재질 구간을 모든 인스턴스에 대하여 그린다.
+	glDrawElementsInstanced(GL_TRIANGLES, mMtlRanges[mtlIdx].second, GL_UNSIGNED_INT,
+		(void*)(mMtlRanges[mtlIdx].first * sizeof(unsigned int)), getNumInstances());
+}
+
+void DgMesh::render()
+{
+	updateBuffers();
+
+	// 텍스처가 있으면 텍스처 전용 셰이더 사용
+	bool bTexture = hasTexture();
+
+	// 링크 시점에 구해 둔 유니폼 위치를 사용한다.
+	const DgShader& shader = DgShader::get(mShaderId);
 
 	glBindVertexArray(mVAO);
-	for (size_t i = 0; i < mMaterials.size(); ++i)
+	for (int i = 0; i < NUM(mMaterials); ++i)
 	{
-		const DgMaterial& mtl = mMaterials[i];
+		// 재질 계수 uniform 설정
+		setMaterial(shader, i);
 
-		//   uniform 
-		glUniform3fv(glGetUniformLocation(mShaderId, "uKa"), 1, mtl.mKa);
-		glUniform3fv(glGetUniformLocation(mShaderId, "uKd"), 1, mtl.mKd);
-		glUniform3fv(glGetUniformLocation(mShaderId, "uKs"), 1, mtl.mKs);
-		glUniform1f(glGetUniformLocation(mShaderId, "uNs"), mtl.mNs);
-
-		// ؽó   ó
-		if (hasTexture)
+		// 텍스처 유무에 따라 처리
+		if (bTexture)
 		{
 			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, mtl.mTexId);
-			glUniform1i(glGetUniformLocation(mShaderId, "uTex"), 0);
+			glBindTexture(GL_TEXTURE_2D, mMaterials[i].mTexId);
 		}
 
-		//  ε   Ȯ
-		const std::vector<unsigned int>& indices = mVertexIndicesPerMtl[i];
-		if (indices.empty()) continue;
-
-		// EBO  ӽ ε  (draw call)
-		GLuint tempEBO;
-		glGenBuffers(1, &tempEBO);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, tempEBO);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
-
-		glDrawElements(GL_TRIANGLES, (GLsizei)indices.size(), GL_UNSIGNED_INT, 0);
-
-		glDeleteBuffers(1, &tempEBO);
+		// 재질별 인덱스 존재 여부 확인
+		if (i >= NUM(mMtlRanges) || mMtlRanges[i].second == 0) continue;
+		drawMaterial(i);
 	}
 
 	glBindVertexArray(0);
@@ -236,7 +472,7 @@ void DgMesh::render()
 
 void DgMesh::addVertex(DgVertex* pVert)
 {
-	//  ε ϰ  迭 ߰Ѵ.
+	// 정점의 인덱스를 설정하고 정점 배열에 추가한다.
 	pVert->mMesh = this;
 	pVert->mIdx = (int)mVerts.size();
 	mVerts.push_back(*pVert);
@@ -246,27 +482,27 @@ void DgMesh::updateEdgeMate(DgVertex* pVert)
 {
 	if (pVert == nullptr)
 	{
-		// ޽   Ʈ  ʱȭ Ѵ.
+		// 메쉬의 모든 에지의 메이트 정보를 초기화 한다.
 		for (DgFace& f : mFaces)
 			for (DgEdge* e : f.getEdges())
 				e->mMate = nullptr;
 
-		//   Ͽ
+		// 각각의 정점에 대하여
 		for (DgVertex& v : mVerts)
 		{
-			//  ϴ   Ͽ
+			// 정점에서 시작하는 각각의 에지에 대하여
 			for (DgEdge* e1 : v.mEdges)
 			{
 				if (e1->mMate != NULL)
 					continue;
 
-				//    ϴ   Ͽ
+				// 에지의 다음 정점에서 시작하는 각각의 에지에 대하여
 				for (DgEdge* e2 : EV(e1)->mEdges)
 				{
-					// e2 e1 mate 
+					// e2가 e1의 mate 에지라면
 					if (IS_MATE_EDGE(e1, e2))
 					{
-						// mate  Ѵ.
+						// mate 정보를 설정한다.
 						e1->mMate = e2;
 						e2->mMate = e1;
 						break;
@@ -275,27 +511,27 @@ void DgMesh::updateEdgeMate(DgVertex* pVert)
 			}
 		}
 	}
-	else //  ֺ  Ѵ.
+	else // 정점 주변의 정보를 갱신한다.
 	{
 		for (DgVertex* v : pVert->getOneRingVerts(false))
 		{
-			//  ϴ   e1 Ͽ
+			// 정점에서 시작하는 각각의 에지 e1에 대하여
 			for (DgEdge* e1 : v->mEdges)
 			{
-				// 2023-10-01 ߰...
+				// 2023-10-01 추가...
 				if (e1->mFace->mIdx == -1)
 					continue;
 
-				//   ϴ   e2 Ͽ
+				// 에지의 끝점에서 시작하는 각각의 에지 e2에 대하여
 				for (DgEdge* e2 : EV(e1)->mEdges)
 				{
 					if (e2->mFace->mIdx == -1)
 						continue;
 
-					// e1 e2 mate 
+					// e1과 e2가 mate 관계라면
 					if (IS_MATE_EDGE(e1, e2))
 					{
-						// mate  Ѵ.
+						// mate 정보를 설정한다.
 						e1->mMate = e2;
 						e2->mMate = e1;
 						break;
@@ -308,24 +544,24 @@ void DgMesh::updateEdgeMate(DgVertex* pVert)
 
 void DgMesh::updateNormal(TypeNormal normalType)
 {
-	//    Ѵ.
+	// 기존의 모든 법선을 제거한다.
 	for (DgNormal& n : mNormals)
 		delete &n;
 	mNormals.clear();
 	mNormalBuffer.clear();
 
-	//  ¸ Ѵ.
+	// 법선 형태를 설정한다.
 	mNormalType = (normalType == NORMAL_ASIS) ? mNormalType : normalType;
 
-	// ﰢ  Ѵٸ
+	// 삼각형 법선을 사용한다면
 	if (mNormalType == NORMAL_FACE)
 	{
-		//  ﰢ Ͽ
+		// 각각의 삼각형에 대하여
 		mNormals.assign(NUM(mFaces), DgNormal(0.0, 0.0, 0.0));
 #pragma omp parallel for
 		for (int i = 0; i < NUM(mFaces); ++i)
 		{
-			// ﰢ  Ͽ Ʈ ߰Ѵ.
+			// 삼각형 법선을 생성하여 리스트에 추가한다.
 			DgFace* f = &mFaces[i];
 			DgVec3 N;
 			try {
@@ -338,31 +574,31 @@ void DgMesh::updateNormal(TypeNormal normalType)
 			pNormal->mIdx = i;
 			mNormals[i] = pNormal;
 
-			//   ﰢ  ҴѴ.
+			// 각 에지에 삼각형 법선을 할당한다.
 			f->mEdge->mNormal = pNormal;
 			f->mEdge->mNext->mNormal = pNormal;
 			f->mEdge->mNext->mNext->mNormal = pNormal;
 		}
 	}
-	else  if (mNormalType == NORMAL_VERTEX) //   Ѵٸ
+	else  if (mNormalType == NORMAL_VERTEX) // 정점 법선을 사용한다면
 	{
-		//   Ͽ
+		// 각각의 정점에 대하여
 		mNormals.assign(NUM(mVerts), DgNormal(0.0, 0.0, 0.0));
 #pragma omp parallel for
 		for (int i = 0; i < NUM(mVerts); ++i)
 		{
-			//   ϰ Ʈ ߰Ѵ.
+			// 정점 법선을 생성하고 리스트에 추가한다.
 			DgNormal* pNormal = new DgNormal();
 			pNormal->mIdx = i;
 			mNormals[i] = pNormal;
 
-			//  ϴ   Ͽ   ҴѴ.
+			// 정점에서 시작하는 각각의 에지에 대하여 정점 법선을 할당한다.
 			for (DgEdge* e : mVerts[i].mEdges)
 				e->mNormal = pNormal;
 		}
 
-		//  ﰢ  Ͽ   Ѵ.
-#pragma omp parallel for
+		// 각 삼각형의 법선을 계산하여 세 에지에 누적한다.
+		// (여러 삼각형이 같은 정점 법선에 누적하므로 병렬화하지 않는다.)
 		for (int i = 0; i < NUM(mFaces); ++i)
 		{
 			DgFace* f = &mFaces[i];
@@ -378,7 +614,7 @@ void DgMesh::updateNormal(TypeNormal normalType)
 			f->mEdge->mNext->mNext->mNormal->mDir += N;
 		}
 
-		//   ȭ Ѵ.
+		// 누적된 법선을 정규화 한다.
 #pragma omp parallel for
 		for (int i = 0; i < NUM(mNormals); ++i)
 		{
@@ -393,14 +629,14 @@ void DgMesh::updateNormal(TypeNormal normalType)
 
 void DgMesh::updateBndBox()
 {
-	// ޽  ٸ Ѵ.
+	// 메쉬 정점이 없다면 리턴한다.
 	if (getNumVerts() == 0)
 	{
 		mBndBox[0] = mBndBox[1] = DgPos(0.0, 0.0, 0.0);
 		return;
 	}
 
-	// ޽   ࿡  ִ/ּ ǥ Ѵ.
+	// 메쉬 정점의 각 축에 대한 최대/최소 좌표를 구한다.
 	mBndBox[0] = mBndBox[1] = mVerts[0].mPos;
 	for (DgVertex& v : mVerts)
 	{
@@ -421,7 +657,7 @@ int DgMesh::getNumVerts()
 
 void DgMesh::computeNormal(int normalType)
 {
-	if (normalType == 0) //  
+	if (normalType == 0) // 정점 법선
 	{
 		int numVerts = (int)mVerts.size();
 		mNormals.clear();
@@ -464,7 +700,7 @@ void DgMesh::computeNormal(int normalType)
 			mNormals[i].mDir[2] = n[2];
 		}			
 	}
-	else if (normalType == 1) // ﰢ 
+	else if (normalType == 1) // 삼각형 법선
 	{
 		int numFaces = (int)mFaces.size();
 		mNormals.clear();
@@ -474,7 +710,7 @@ void DgMesh::computeNormal(int normalType)
 		{
 			int* vidx = mFaces[i].mVertIdxs;
 
-			//  ﰢ   
+			// 각 삼각형마다 로컬 법선 생성
 			glm::vec3 p0 = glm::make_vec3(mVerts[vidx[0]].mPos);
 			glm::vec3 p1 = glm::make_vec3(mVerts[vidx[1]].mPos);
 			glm::vec3 p2 = glm::make_vec3(mVerts[vidx[2]].mPos);
@@ -492,12 +728,43 @@ void DgMesh::computeNormal(int normalType)
 	}
 }
 
+/*!
+*	\brief	이미지 파일을 읽어 2D 텍스처를 생성
+*
+*	\return 생성된 텍스처 아이디(실패하면 0)를 반환한다.
+*/
+static GLuint load_texture(const char* fname)
+{
+	int width, height, channels;
+	stbi_set_flip_vertically_on_load(true);
+	unsigned char* data = stbi_load(fname, &width, &height, &channels, 0);
+	if (!data) {
+		std::cerr << "\t텍스처 로딩 실패: " << fname << std::endl;
+		return 0;
+	}
+
+	glEnable(GL_TEXTURE_2D);
+	GLuint texId;
+	glGenTextures(1, &texId);
+	glBindTexture(GL_TEXTURE_2D, texId);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	GLenum format = (channels == 3) ? GL_RGB : (channels == 4) ? GL_RGBA : GL_RED;
+	glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glDisable(GL_TEXTURE_2D);
+	stbi_image_free(data);
+	return texId;
+}
+
 bool import_obj_mtl(DgMesh* pMesh, const char* fname)
 {
 	std::ifstream file(fname);
 	if (!file.is_open())
 	{
-		std::cerr << "\t   : " << fname << std::endl;
+		std::cerr << "\t재질 파일 열기 실패: " << fname << std::endl;
 		return false;
 	}
 
@@ -536,225 +803,717 @@ bool import_obj_mtl(DgMesh* pMesh, const char* fname)
 		}
 		else if (tag == "map_Kd")
 		{
+			// 텍스처 경로는 MTL 파일의 위치를 기준으로 한다.
 			std::string texFile;
 			iss >> texFile;
+			texFile = (std::filesystem::path(fname).parent_path() / texFile).string();
 
-			int width, height, channels;
-			stbi_set_flip_vertically_on_load(true);
-			unsigned char* data = stbi_load(texFile.c_str(), &width, &height, &channels, 0);
-			if (!data) {
-				std::cerr << "\tؽó ε : " << texFile << std::endl;
-				continue;
-			}
-
-			glEnable(GL_TEXTURE_2D);
-			GLuint texId;
-			glGenTextures(1, &texId);
-			glBindTexture(GL_TEXTURE_2D, texId);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			GLenum format = (channels == 3) ? GL_RGB : (channels == 4) ? GL_RGBA : GL_RED;
-			glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-			glBindTexture(GL_TEXTURE_2D, 0);
-			glDisable(GL_TEXTURE_2D);
-			stbi_image_free(data);
-			pMesh->mMaterials.back().mTexId = texId;
+			pMesh->mMaterials.back().mTexFile = texFile;
+			pMesh->mMaterials.back().mTexId = load_texture(texFile.c_str());
 		}
 	}
 	return true;
 }
 
-DgMesh* import_mesh_obj(const char* fname)
+/*!
+*	\brief	OBJ 파일의 한 구간을 파싱한 결과
+*/
+struct ObjChunk
 {
-	//  
-	std::ifstream file(fname);
-	if (!file.is_open()) {
-		std::cerr << "OBJ   : " << fname << std::endl;
-		return nullptr;
-	}
+	std::vector<double> mVerts;		// 정점 좌표(x, y, z)
+	std::vector<double> mTexels;	// 텍셀 좌표(s, t)
+	std::vector<double> mNormals;	// 법선 좌표(x, y, z)
+	std::vector<int> mTris;			// 삼각형별 (v0, v1, v2, t0, t1, t2, n0, n1, n2, 플래그: 1 텍셀, 2 법선)
+	std::vector<std::pair<int, std::string>> mUseMtls;	// (적용이 시작되는 삼각형 번호, 재질 이름)
+	std::vector<std::string> mMtlLibs;					// MTL 파일 이름
+	int mNumVerts = 0, mNumTexels = 0, mNumNormals = 0;	// 구간에 포함된 정점, 텍셀, 법선의 개수
+};
 
-	std::filesystem::path prevPath = std::filesystem::current_path();
+/*!
+*	\brief	공백과 탭을 건너뜀
+*/
+static const char* obj_skip_space(const char* p, const char* end)
+{
+	while (p < end && (*p == ' ' || *p == '\t'))
+		++p;
+	return p;
+}
 
-	//  ͸ (, fname = "c:/models/bunny.obj")
-	std::filesystem::path objPath(fname);					// objPath = c:/models/bunny.obj
-	std::filesystem::path objDir = objPath.parent_path();	// objDir = c:/models/
-	std::filesystem::current_path(objDir);					//  ͸ c:/models/  
+/*!
+*	\brief	다음 줄의 시작 위치를 반환
+*/
+static const char* obj_next_line(const char* p, const char* end)
+{
+	const char* q = (const char*)memchr(p, '\n', end - p);
+	return (q != NULL) ? q + 1 : end;
+}
 
-	// ﰢ ޽ 
-	DgMesh* pMesh = new DgMesh();
-	int currMtlIdx = -1;
+/*!
+*	\brief	공백 다음의 실수를 읽음(실패하면 0)
+*/
+static const char* obj_parse_double(const char* p, const char* end, double& x)
+{
+	p = obj_skip_space(p, end);
+	if (p < end && *p == '+')
+		++p;
+	x = 0.0;
+	auto res = std::from_chars(p, end, x);
+	return res.ptr;
+}
 
-	// Obj  Ľ
-	std::string line, tag;
-	while (std::getline(file, line))
+/*!
+*	\brief	공백 다음의 이름(줄 끝의 공백 제외)을 읽음
+*/
+static std::string obj_parse_name(const char* p, const char* end)
+{
+	p = obj_skip_space(p, end);
+	const char* q = p;
+	while (q < end && *q != '\n' && *q != '\r')
+		++q;
+	while (q > p && (q[-1] == ' ' || q[-1] == '\t'))
+		--q;
+	return std::string(p, q);
+}
+
+/*!
+*	\brief	줄의 태그(v, vt, vn, f 등)와 태그 다음 위치를 구함
+*/
+static const char* obj_parse_tag(const char* p, const char* end, std::string_view& tag)
+{
+	p = obj_skip_space(p, end);
+	const char* q = p;
+	while (q < end && *q != ' ' && *q != '\t' && *q != '\n' && *q != '\r')
+		++q;
+	tag = std::string_view(p, q - p);
+	return q;
+}
+
+/*!
+*	\brief	OBJ 파일의 구간 [begin, end)에서 정점, 텍셀, 법선의 개수만 센다.
+*/
+static void obj_count_chunk(const char* begin, const char* end, ObjChunk& chunk)
+{
+	for (const char* p = begin; p < end; p = obj_next_line(p, end))
 	{
-		//  ̳ ּ ŵ
-		if (line.empty() || line[0] == '#')
-			continue;
+		std::string_view tag;
+		obj_parse_tag(p, end, tag);
+		if (tag == "v")
+			chunk.mNumVerts++;
+		else if (tag == "vt")
+			chunk.mNumTexels++;
+		else if (tag == "vn")
+			chunk.mNumNormals++;
+	}
+}
 
-		//  ٿ ױ 
-		std::istringstream iss(line);
-		iss >> tag;
+/*!
+*	\brief	OBJ 파일의 구간 [begin, end)를 파싱한다.
+*	\note	음수(상대) 인덱스는 앞선 구간까지의 개수(base)로 전역 인덱스로 변환하며, 다각형은 부채꼴로 삼각형 분할한다.
+*/
+static void obj_parse_chunk(const char* begin, const char* end, const int base[3], ObjChunk& chunk)
+{
+	int count[3] = { base[0], base[1], base[2] };
+	std::vector<int> poly;
+	for (const char* p = begin; p < end; p = obj_next_line(p, end))
+	{
+		std::string_view tag;
+		const char* q = obj_parse_tag(p, end, tag);
+		if (tag.empty() || tag[0] == '#')
+			continue;
 
-		if (tag == "mtllib")	// mtllib dice.mtl
-		{
-			std::string mtlFile;
-			iss >> mtlFile;
-			if (!import_obj_mtl(pMesh, mtlFile.c_str()))
-				std::cerr << "MTL  ε : " << mtlFile << std::endl;
-		}
-		else if (tag == "v")	// v	0.0		0.0		5.0
+		if (tag == "v")				// v	0.0		0.0		5.0
 		{
 			double x, y, z;
-			iss >> x >> y >> z;
-			pMesh->mVerts.emplace_back(x, y, z); // pMesh->mVerts.push_back(DgVertex(x, y, z));  
+			q = obj_parse_double(q, end, x);
+			q = obj_parse_double(q, end, y);
+			obj_parse_double(q, end, z);
+			chunk.mVerts.insert(chunk.mVerts.end(), { x, y, z });
+			count[0]++;
 		}
-		else if (tag == "vt")	// vt	0.25	0.5
+		else if (tag == "vt")		// vt	0.25	0.5
 		{
 			double s, t;
-			iss >> s >> t;
-			pMesh->mTexels.emplace_back(s, t);
+			q = obj_parse_double(q, end, s);
+			obj_parse_double(q, end, t);
+			chunk.mTexels.insert(chunk.mTexels.end(), { s, t });
+			count[1]++;
 		}
-		else if (tag == "vn")	// vn	0.0		0.0		1.0
+		else if (tag == "vn")		// vn	0.0		0.0		1.0
 		{
-			double nx, ny, nz;
-			iss >> nx >> ny >> nz;
-			pMesh->mNormals.emplace_back(nx, ny, nz);
+			double x, y, z;
+			q = obj_parse_double(q, end, x);
+			q = obj_parse_double(q, end, y);
+			obj_parse_double(q, end, z);
+			chunk.mNormals.insert(chunk.mNormals.end(), { x, y, z });
+			count[2]++;
 		}
-		else if (tag == "usemtl")	// usemtl Dice
+		else if (tag == "f")		// f	1/3/4	2/2/4	3/5/4
 		{
-			std::string mtlName;
-			iss >> mtlName;
-			currMtlIdx = -1;
-			for (size_t i = 0; i < pMesh->mMaterials.size(); ++i) {
-				if (pMesh->mMaterials[i].mName == mtlName) {
-					currMtlIdx = static_cast<int>(i);
+			// 꼭짓점별 (정점, 텍셀, 법선) 인덱스를 읽고(없으면 -1)
+			poly.clear();
+			int flags = 0;
+			while (true)
+			{
+				q = obj_skip_space(q, end);
+				if (q >= end || *q == '\n' || *q == '\r')
 					break;
+				int idx[3] = { 0, 0, 0 };
+				for (int k = 0; k < 3; ++k)
+				{
+					auto res = std::from_chars(q, end, idx[k]);
+					q = res.ptr;
+					if (k > 0 && res.ec == std::errc())
+						flags |= k;
+					if (q >= end || *q != '/')
+						break;
+					++q;
 				}
+				if (idx[0] == 0)
+					break;
+				for (int k = 0; k < 3; ++k)
+					poly.push_back((idx[k] > 0) ? idx[k] - 1 : (idx[k] < 0) ? count[k] + idx[k] : -1);
+			}
+
+			// 다각형은 삼각형으로 분할하여 저장한다.
+			int n = (int)poly.size() / 3;
+			for (int i = 1; i + 1 < n; ++i)
+			{
+				int c[3] = { 0, i, i + 1 };
+				for (int k = 0; k < 3; ++k)
+					for (int v = 0; v < 3; ++v)
+						chunk.mTris.push_back(poly[3 * c[v] + k]);
+				chunk.mTris.push_back(flags);
 			}
 		}
-		else if (tag == "f") // f	1/3/4	2/2/4	3/5/4
+		else if (tag == "usemtl")	// usemtl Dice
+			chunk.mUseMtls.emplace_back((int)chunk.mTris.size() / 10, obj_parse_name(q, end));
+		else if (tag == "mtllib")	// mtllib dice.mtl
+			chunk.mMtlLibs.push_back(obj_parse_name(q, end));
+	}
+}
+
+/*!
+*	\brief	줄 경계로 나눈 OBJ 구간 [bounds[c], bounds[c + 1])들을 병렬로 파싱하여 빈 메쉬 pMesh를 구성
+*	\note	mtllib은 objDir을 기준으로 읽으며, pMesh에 미리 추가된 재질도 usemtl의 대상이 된다.
+*/
+static void obj_build_mesh(DgMesh* pMesh, const std::vector<const char*>& bounds, const std::filesystem::path& objDir)
+{
+	int numChunks = (int)bounds.size() - 1;
+
+	// 상대 인덱스 변환을 위해 구간별 정점, 텍셀, 법선의 개수를 센 후
+	std::vector<ObjChunk> chunks(numChunks);
+#pragma omp parallel for schedule(dynamic, 1)
+	for (int c = 0; c < numChunks; ++c)
+		obj_count_chunk(bounds[c], bounds[c + 1], chunks[c]);
+	std::vector<int> bases(3 * numChunks + 3, 0);
+	for (int c = 0; c < numChunks; ++c)
+	{
+		bases[3 * c + 3] = bases[3 * c] + chunks[c].mNumVerts;
+		bases[3 * c + 4] = bases[3 * c + 1] + chunks[c].mNumTexels;
+		bases[3 * c + 5] = bases[3 * c + 2] + chunks[c].mNumNormals;
+	}
+
+	// 구간을 병렬로 파싱한다.
+#pragma omp parallel for schedule(dynamic, 1)
+	for (int c = 0; c < numChunks; ++c)
+		obj_parse_chunk(bounds[c], bounds[c + 1], &bases[3 * c], chunks[c]);
+
+	// OBJ 파일 위치를 기준으로 재질 파일을 읽는다.
+	for (ObjChunk& chunk : chunks)
+	{
+		for (const std::string& mtlFile : chunk.mMtlLibs)
 		{
-			std::vector<int> vIdxs, tIdxs, nIdxs;
-			std::string token;
-			bool hasTexel = false, hasNormal = false;
+			std::string mtlPath = (objDir / mtlFile).string();
+			if (!import_obj_mtl(pMesh, mtlPath.c_str()))
+				std::cerr << "MTL 파일 로딩 실패: " << mtlPath << std::endl;
+		}
+	}
 
-			while (iss >> token)
-			{
-				int vi, ti, ni;
-				size_t firstSlash = token.find('/');
-				size_t secondSlash = token.find('/', firstSlash + 1);
+	// 정점, 텍셀, 법선 배열을 순서대로 병합한다.
+	pMesh->mVerts.reserve(bases[3 * numChunks]);
+	pMesh->mTexels.reserve(bases[3 * numChunks + 1]);
+	pMesh->mNormals.reserve(bases[3 * numChunks + 2]);
+	for (ObjChunk& chunk : chunks)
+	{
+		for (size_t i = 0; i < chunk.mVerts.size(); i += 3)
+			pMesh->mVerts.emplace_back(chunk.mVerts[i], chunk.mVerts[i + 1], chunk.mVerts[i + 2]);
+		for (size_t i = 0; i < chunk.mTexels.size(); i += 2)
+			pMesh->mTexels.emplace_back(chunk.mTexels[i], chunk.mTexels[i + 1]);
+		for (size_t i = 0; i < chunk.mNormals.size(); i += 3)
+			pMesh->mNormals.emplace_back(chunk.mNormals[i], chunk.mNormals[i + 1], chunk.mNormals[i + 2]);
+		std::vector<double>().swap(chunk.mVerts);
+		std::vector<double>().swap(chunk.mTexels);
+		std::vector<double>().swap(chunk.mNormals);
+	}
 
-				if (firstSlash == std::string::npos)		// f	1	2	3
-				{
-					vi = std::stoi(token) - 1;
-					ti = -1;
-					ni = -1;
-				}
-				else if (secondSlash == std::string::npos)	// f	1/3		2/2		3/5
-				{
-					vi = std::stoi(token.substr(0, firstSlash)) - 1;
-					ti = std::stoi(token.substr(firstSlash + 1)) - 1;
-					ni = -1;
-					hasTexel = true;
-				}
-				else if (secondSlash == firstSlash + 1)		// f	1//4	2//4	3//4
-				{
-					vi = std::stoi(token.substr(0, firstSlash)) - 1;
-					ti = -1;
-					ni = std::stoi(token.substr(secondSlash + 1)) - 1;
-					hasNormal = true;
-				}
-				else										// f	1/3/4	2/2/4	3/5/4
-				{
-					vi = std::stoi(token.substr(0, firstSlash)) - 1;
-					ti = std::stoi(token.substr(firstSlash + 1, secondSlash - firstSlash - 1)) - 1;
-					ni = std::stoi(token.substr(secondSlash + 1)) - 1;
-					hasTexel = true;
-					hasNormal = true;
+	// 재질 이름을 인덱스로 변환하며 삼각형을 병합한다.
+	std::map<std::string, int> mtlIdxs;
+	for (int i = (int)pMesh->mMaterials.size() - 1; i >= 0; --i)
+		mtlIdxs[pMesh->mMaterials[i].mName] = i;
+	int currMtlIdx = -1;
+	auto apply_usemtl = [&](const std::string& name) {
+		auto it = mtlIdxs.find(name);
+		currMtlIdx = (it != mtlIdxs.end()) ? it->second : -1;
+	};
+	for (ObjChunk& chunk : chunks)
+	{
+		size_t nextMtl = 0;
+		for (int f = 0; f < (int)chunk.mTris.size() / 10; ++f)
+		{
+			while (nextMtl < chunk.mUseMtls.size() && chunk.mUseMtls[nextMtl].first == f)
+				apply_usemtl(chunk.mUseMtls[nextMtl++].second);
+
+			const int* tri = &chunk.mTris[10 * f];
+			int n0 = tri[6], n1 = tri[7], n2 = tri[8];
+			bool hasTexel = (tri[9] & 1) != 0;
+			bool hasNormal = (tri[9] & 2) != 0;
+
+			// 법선이 없으면 삼각형 법선으로 자동 계산
+			if (!hasNormal)
+			{
+				auto& p0 = pMesh->mVerts[tri[0]].mPos;
+				auto& p1 = pMesh->mVerts[tri[1]].mPos;
+				auto& p2 = pMesh->mVerts[tri[2]].mPos;
+				double e0[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+				double e1[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+				double n[3] = { e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0] };
+				double len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+				if (len > 1e-8) {
+					n[0] /= len; n[1] /= len; n[2] /= len;
 				}
-				vIdxs.push_back(vi);
-				tIdxs.push_back(ti);
-				nIdxs.push_back(ni);
+				pMesh->mNormals.emplace_back(n[0], n[1], n[2]);
+				n0 = n1 = n2 = (int)pMesh->mNormals.size() - 1;
 			}
 
-			// ٰ ﰢ Ͽ ó
-			for (size_t i = 1; i + 1 < vIdxs.size(); ++i)
-			{
-				int v0 = vIdxs[0], v1 = vIdxs[i], v2 = vIdxs[i + 1];
-				int t0 = tIdxs[0], t1 = tIdxs[i], t2 = tIdxs[i + 1];
-				int n0 = nIdxs[0], n1 = nIdxs[i], n2 = nIdxs[i + 1];
+			if (hasTexel)
+				pMesh->mFaces.emplace_back(tri[0], tri[1], tri[2], tri[3], tri[4], tri[5], n0, n1, n2, currMtlIdx);
+			else
+				pMesh->mFaces.emplace_back(tri[0], tri[1], tri[2], n0, n1, n2, currMtlIdx);
+		}
+		// 구간의 마지막 삼각형 이후(또는 삼각형이 없는 구간)의 usemtl은 다음 구간의 삼각형에 적용된다.
+		while (nextMtl < chunk.mUseMtls.size())
+			apply_usemtl(chunk.mUseMtls[nextMtl++].second);
 
-				//   ﰢ  ڵ 
-				//if (!hasNormal || n0 < 0 || n1 < 0 || n2 < 0)
-				if (!hasNormal)
-				{
-					auto& p0 = pMesh->mVerts[v0].mPos;
-					auto& p1 = pMesh->mVerts[v1].mPos;
-					auto& p2 = pMesh->mVerts[v2].mPos;
-					double e0[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
-					double e1[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
-					double n[3] = { e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0] };
-					double len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
-					if (len > 1e-8) {
-						n[0] /= len; n[1] /= len; n[2] /= len;
-					}
-					pMesh->mNormals.emplace_back(n[0], n[1], n[2]);
-					n0 = n1 = n2 = (int)pMesh->mNormals.size() - 1;
-				}
+		// 병합한 구간의 메모리를 바로 해제한다.
+		std::vector<int>().swap(chunk.mTris);
+	}
+}
+
+/*!
+*	\brief	OBJ 파일을 파싱하여 메쉬를 생성
+*/
+static DgMesh* parse_mesh_obj(const char* fname)
+{
+	// 파일을 메모리에 매핑한다.
+	DgMappedFile file;
+	if (!file.open(fname)) {
+		std::cerr << "OBJ 파일 열기 실패: " << fname << std::endl;
+		return nullptr;
+	}
+	const char* data = file.mData;
+	const char* dataEnd = file.mData + file.mSize;
+
+	// 파일을 줄 경계에서 스레드 개수의 4배 구간으로 나눈다.
+	int numChunks = (file.mSize < (1 << 20)) ? 1 : omp_get_max_threads() * 4;
+	std::vector<const char*> bounds(numChunks + 1);
+	bounds[0] = data;
+	bounds[numChunks] = dataEnd;
+	for (int c = 1; c < numChunks; ++c)
+		bounds[c] = MAX(bounds[c - 1], obj_next_line(data + file.mSize * c / numChunks - 1, dataEnd));
+
+	// 삼각 메쉬를 생성한다.
+	DgMesh* pMesh = new DgMesh();
+	obj_build_mesh(pMesh, bounds, std::filesystem::path(fname).parent_path());
+	pMesh->mFilePath = fname;
+	return pMesh;
+}
+
+DgMesh* import_mesh_obj(const char* fname)
+{
+	// 원본과 일치하는 이진 캐시가 있으면 캐시를 사용하고
+	std::string cacheFile = std::string(fname) + ".dmsh";
+	DgMesh* pMesh = load_mesh_cache(cacheFile.c_str(), fname);
+	if (pMesh != nullptr)
+	{
+		pMesh->mFilePath = fname;
+		return pMesh;
+	}
+
+	// 없으면 OBJ 파일을 파싱한 후 캐시를 기록한다.
+	pMesh = parse_mesh_obj(fname);
+	if (pMesh != nullptr && !pMesh->mFaces.empty() && !save_mesh_cache(pMesh, cacheFile.c_str(), fname))
+		printf("Failed to write mesh cache: %s\n", cacheFile.c_str());
+	return pMesh;
+}
+
+/*!
+*	\struct	MeshFileHeader
+*	\brief	메쉬 캐시 파일의 헤더(이후 배열은 모두 64바이트 경계에서 시작)
+*/
+struct MeshFileHeader
+{
+	char mMagic[4];
+	int mVersion;
+	int mNumVerts;
+	int mNumTexels;
+	int mNumNormals;
+	int mNumFaces;
+	int mNumMaterials;
+	int mStride;
+	unsigned long long mNumIndices;
+	unsigned long long mNumStreamFloats;
+	unsigned long long mSrcSize;
+	long long mSrcTime;
+};
+
+/*!
+*	\struct	MeshFileMaterial
+*	\brief	메쉬 캐시 파일에 저장되는 고정 크기 재질 레코드
+*/
+struct MeshFileMaterial
+{
+	char mName[64];
+	char mTexFile[260];
+	float mKa[3];
+	float mKd[3];
+	float mKs[3];
+	float mNs;
+	int mNumIndices;
+};
+
+/*!
+*	\struct	MeshFileFace
+*	\brief	메쉬 캐시 파일에 저장되는 삼각형 레코드
+*/
+struct MeshFileFace
+{
+	int mVertIdxs[3];
+	int mTexelIdxs[3];
+	int mNormalIdxs[3];
+	int mMtlIdx;
+};
+
+static const int MESH_CACHE_VERSION = 2;
+
+/*!
+*	\brief	메쉬 캐시 파일에서 배열의 시작 위치를 64바이트 경계로 올림
+*/
+static size_t mesh_align64(size_t offset)
+{
+	return (offset + 63) & ~(size_t)63;
+}
+
+/*!
+*	\brief	원본 파일의 크기와 수정 시각을 구함
+*/
+static bool get_src_stamp(const char* srcFile, unsigned long long& size, long long& time)
+{
+	std::error_code ec;
+	size = (unsigned long long)std::filesystem::file_size(srcFile, ec);
+	if (ec)
+		return false;
+	time = (long long)std::filesystem::last_write_time(srcFile, ec).time_since_epoch().count();
+	return !ec;
+}
+
+bool save_mesh_cache(DgMesh* pMesh, const char* fname, const char* srcFile)
+{
+	// GPU 정점 스트림을 미리 구성하고(기본 재질도 이때 추가됨)
+	std::vector<float> vertexData;
+	pMesh->buildVertexStream(vertexData);
+
+	MeshFileHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.mMagic, "DMSH", 4);
+	header.mVersion = MESH_CACHE_VERSION;
+	header.mNumVerts = NUM(pMesh->mVerts);
+	header.mNumTexels = NUM(pMesh->mTexels);
+	header.mNumNormals = NUM(pMesh->mNormals);
+	header.mNumFaces = NUM(pMesh->mFaces);
+	header.mNumMaterials = NUM(pMesh->mMaterials);
+	header.mStride = pMesh->mTexels.empty() ? 6 : 8;
+	header.mNumStreamFloats = vertexData.size();
+	for (const std::vector<unsigned int>& indices : pMesh->mVertexIndicesPerMtl)
+		header.mNumIndices += indices.size();
+	if (!get_src_stamp(srcFile, header.mSrcSize, header.mSrcTime))
+		return false;
+
+	// 메쉬 배열을 고정 크기 레코드로 변환한다.
+	std::vector<double> verts(3 * header.mNumVerts), texels(2 * header.mNumTexels), normals(3 * header.mNumNormals);
+	for (int i = 0; i < header.mNumVerts; ++i)
+		for (int k = 0; k < 3; ++k)
+			verts[3 * i + k] = pMesh->mVerts[i].mPos[k];
+	for (int i = 0; i < header.mNumTexels; ++i)
+		for (int k = 0; k < 2; ++k)
+			texels[2 * i + k] = pMesh->mTexels[i].mST[k];
+	for (int i = 0; i < header.mNumNormals; ++i)
+		for (int k = 0; k < 3; ++k)
+			normals[3 * i + k] = pMesh->mNormals[i].mDir[k];
+
+	std::vector<MeshFileFace> faces(header.mNumFaces);
+	for (int i = 0; i < header.mNumFaces; ++i)
+	{
+		const DgFace& f = pMesh->mFaces[i];
+		memcpy(faces[i].mVertIdxs, f.mVertIdxs, sizeof(f.mVertIdxs));
+		memcpy(faces[i].mTexelIdxs, f.mTexelIdxs, sizeof(f.mTexelIdxs));
+		memcpy(faces[i].mNormalIdxs, f.mNormalIdxs, sizeof(f.mNormalIdxs));
+		faces[i].mMtlIdx = f.mMtlIdx;
+	}
+
+	std::vector<MeshFileMaterial> mtls(header.mNumMaterials);
+	std::vector<unsigned int> indices;
+	indices.reserve(header.mNumIndices);
+	for (int i = 0; i < header.mNumMaterials; ++i)
+	{
+		const DgMaterial& mtl = pMesh->mMaterials[i];
+		MeshFileMaterial& rec = mtls[i];
+		memset(&rec, 0, sizeof(rec));
+		strncpy(rec.mName, mtl.mName.c_str(), sizeof(rec.mName) - 1);
+		strncpy(rec.mTexFile, mtl.mTexFile.c_str(), sizeof(rec.mTexFile) - 1);
+		memcpy(rec.mKa, mtl.mKa, sizeof(rec.mKa));
+		memcpy(rec.mKd, mtl.mKd, sizeof(rec.mKd));
+		memcpy(rec.mKs, mtl.mKs, sizeof(rec.mKs));
+		rec.mNs = mtl.mNs;
+		rec.mNumIndices = NUM(pMesh->mVertexIndicesPerMtl[i]);
+		indices.insert(indices.end(), pMesh->mVertexIndicesPerMtl[i].begin(), pMesh->mVertexIndicesPerMtl[i].end());
+	}
 
-				//if (hasTexel && t0 >= 0 && t1 >= 0 && t2 >= 0)
-				if (hasTexel)
-					pMesh->mFaces.emplace_back(v0, v1, v2, t0, t1, t2, n0, n1, n2, currMtlIdx);
-				else
-					pMesh->mFaces.emplace_back(v0, v1, v2, n0, n1, n2, currMtlIdx);
+	// 배열을 64바이트 경계에 이어서 기록한다.
+	std::ofstream file(fname, std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	const char zeros[64] = { 0 };
+	size_t offset = 0;
+	auto write = [&](const void* data, size_t size) {
+		file.write(zeros, mesh_align64(offset) - offset);
+		file.write((const char*)data, size);
+		offset = mesh_align64(offset) + size;
+	};
+	write(&header, sizeof(header));
+	write(verts.data(), verts.size() * sizeof(double));
+	write(texels.data(), texels.size() * sizeof(double));
+	write(normals.data(), normals.size() * sizeof(double));
+	write(faces.data(), faces.size() * sizeof(MeshFileFace));
+	write(mtls.data(), mtls.size() * sizeof(MeshFileMaterial));
+	write(indices.data(), indices.size() * sizeof(unsigned int));
+	write(vertexData.data(), vertexData.size() * sizeof(float));
+	return file.good();
+}
+
+DgMesh* load_mesh_cache(const char* fname, const char* srcFile)
+{
+	std::shared_ptr<DgMappedFile> file = std::make_shared<DgMappedFile>();
+	if (!file->open(fname) || file->mSize < sizeof(MeshFileHeader))
+		return nullptr;
+
+	// 헤더가 현재 형식, 원본 파일과 일치하는지 확인한다.
+	MeshFileHeader header;
+	memcpy(&header, file->mData, sizeof(header));
+	unsigned long long srcSize;
+	long long srcTime;
+	if (memcmp(header.mMagic, "DMSH", 4) != 0 || header.mVersion != MESH_CACHE_VERSION || header.mNumVerts < 0 || header.mNumTexels < 0 ||
+		header.mNumNormals < 0 || header.mNumFaces < 0 || header.mNumMaterials < 0 || header.mStride != ((header.mNumTexels > 0) ? 8 : 6) ||
+		header.mNumStreamFloats % header.mStride != 0)
+		return nullptr;
+	if (!get_src_stamp(srcFile, srcSize, srcTime) || srcSize != header.mSrcSize || srcTime != header.mSrcTime)
+	{
+		printf("Mesh cache is stale, reimporting: %s\n", fname);
+		return nullptr;
+	}
+
+	size_t vertOffset = mesh_align64(sizeof(header));
+	size_t texelOffset = mesh_align64(vertOffset + header.mNumVerts * 3 * sizeof(double));
+	size_t normalOffset = mesh_align64(texelOffset + header.mNumTexels * 2 * sizeof(double));
+	size_t faceOffset = mesh_align64(normalOffset + header.mNumNormals * 3 * sizeof(double));
+	size_t mtlOffset = mesh_align64(faceOffset + header.mNumFaces * sizeof(MeshFileFace));
+	size_t indexOffset = mesh_align64(mtlOffset + header.mNumMaterials * sizeof(MeshFileMaterial));
+	size_t streamOffset = mesh_align64(indexOffset + header.mNumIndices * sizeof(unsigned int));
+	if (file->mSize != streamOffset + header.mNumStreamFloats * sizeof(float))
+		return nullptr;
+
+	const double* verts = (const double*)(file->mData + vertOffset);
+	const double* texels = (const double*)(file->mData + texelOffset);
+	const double* normals = (const double*)(file->mData + normalOffset);
+	const MeshFileFace* faces = (const MeshFileFace*)(file->mData + faceOffset);
+	const MeshFileMaterial* mtls = (const MeshFileMaterial*)(file->mData + mtlOffset);
+	const unsigned int* indices = (const unsigned int*)(file->mData + indexOffset);
+
+	// 재질별 인덱스 개수의 합과 삼각형, 정점 스트림 인덱스가 범위 안에 있는지 확인한다(손상된 캐시는 OBJ로 다시 읽음).
+	unsigned long long sumIndices = 0;
+	for (int i = 0; i < header.mNumMaterials; ++i)
+	{
+		if (mtls[i].mNumIndices < 0)
+			return nullptr;
+		sumIndices += (unsigned long long)mtls[i].mNumIndices;
+	}
+	if (sumIndices != header.mNumIndices)
+	{
+		printf("Mesh cache is corrupted, reimporting: %s\n", fname);
+		return nullptr;
+	}
+	for (int i = 0; i < header.mNumFaces; ++i)
+	{
+		const MeshFileFace& f = faces[i];
+		for (int k = 0; k < 3; ++k)
+			if (f.mVertIdxs[k] < 0 || f.mVertIdxs[k] >= header.mNumVerts || f.mTexelIdxs[k] < -1 || f.mTexelIdxs[k] >= header.mNumTexels ||
+				f.mNormalIdxs[k] < -1 || f.mNormalIdxs[k] >= header.mNumNormals)
+			{
+				printf("Mesh cache is corrupted, reimporting: %s\n", fname);
+				return nullptr;
 			}
+	}
+	unsigned long long numStreamVerts = header.mNumStreamFloats / header.mStride;
+	for (unsigned long long i = 0; i < header.mNumIndices; ++i)
+		if (indices[i] >= numStreamVerts)
+		{
+			printf("Mesh cache is corrupted, reimporting: %s\n", fname);
+			return nullptr;
 		}
+
+	// 매핑된 배열로부터 메쉬를 구성하고
+	DgMesh* pMesh = new DgMesh();
+	pMesh->mVerts.reserve(header.mNumVerts);
+	pMesh->mTexels.reserve(header.mNumTexels);
+	pMesh->mNormals.reserve(header.mNumNormals);
+	pMesh->mFaces.reserve(header.mNumFaces);
+	for (int i = 0; i < header.mNumVerts; ++i)
+		pMesh->mVerts.emplace_back(verts[3 * i], verts[3 * i + 1], verts[3 * i + 2]);
+	for (int i = 0; i < header.mNumTexels; ++i)
+		pMesh->mTexels.emplace_back(texels[2 * i], texels[2 * i + 1]);
+	for (int i = 0; i < header.mNumNormals; ++i)
+		pMesh->mNormals.emplace_back(normals[3 * i], normals[3 * i + 1], normals[3 * i + 2]);
+	for (int i = 0; i < header.mNumFaces; ++i)
+	{
+		const MeshFileFace& f = faces[i];
+		pMesh->mFaces.emplace_back(f.mVertIdxs[0], f.mVertIdxs[1], f.mVertIdxs[2], f.mTexelIdxs[0], f.mTexelIdxs[1], f.mTexelIdxs[2],
+			f.mNormalIdxs[0], f.mNormalIdxs[1], f.mNormalIdxs[2], f.mMtlIdx);
 	}
 
-	std::filesystem::current_path(prevPath);
-	file.close();
+	// 재질과 재질별 인덱스를 복원하고 텍스처를 다시 읽는다.
+	pMesh->mMaterials.resize(header.mNumMaterials);
+	pMesh->mVertexIndicesPerMtl.resize(header.mNumMaterials);
+	for (int i = 0; i < header.mNumMaterials; ++i)
+	{
+		const MeshFileMaterial& rec = mtls[i];
+		DgMaterial& mtl = pMesh->mMaterials[i];
+		mtl.mName = rec.mName;
+		mtl.mTexFile = rec.mTexFile;
+		memcpy(mtl.mKa, rec.mKa, sizeof(rec.mKa));
+		memcpy(mtl.mKd, rec.mKd, sizeof(rec.mKd));
+		memcpy(mtl.mKs, rec.mKs, sizeof(rec.mKs));
+		mtl.mNs = rec.mNs;
+		if (!mtl.mTexFile.empty())
+			mtl.mTexId = load_texture(mtl.mTexFile.c_str());
+		pMesh->mVertexIndicesPerMtl[i].assign(indices, indices + rec.mNumIndices);
+		indices += rec.mNumIndices;
+	}
+
+	// 정점 스트림은 복사하지 않고 매핑을 유지하여 첫 setupBuffers에서 바로 업로드한다.
+	pMesh->mCacheStream = (const float*)(file->mData + streamOffset);
+	pMesh->mCacheStreamSize = (size_t)header.mNumStreamFloats;
+	pMesh->mCacheFile = file;
 	return pMesh;
 }
 
+bool DgMappedFile::open(const char* fname)
+{
+	close();
+#ifdef _WIN32
+	HANDLE hFile = CreateFileA(fname, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(hFile, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(hFile);
+		return false;
+	}
+	HANDLE hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	const void* data = (hMapping != NULL) ? MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+	if (data == NULL)
+	{
+		if (hMapping != NULL)
+			CloseHandle(hMapping);
+		CloseHandle(hFile);
+		return false;
+	}
+	mFile = hFile;
+	mMapping = hMapping;
+	mData = (const char*)data;
+	mSize = (size_t)size.QuadPart;
+#else
+	int fd = ::open(fname, O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0)
+	{
+		::close(fd);
+		return false;
+	}
+	void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (data == MAP_FAILED)
+		return false;
+	mData = (const char*)data;
+	mSize = (size_t)st.st_size;
+#endif
+	return true;
+}
+
+void DgMappedFile::close()
+{
+	if (mData == nullptr)
+		return;
+#ifdef _WIN32
+	UnmapViewOfFile(mData);
+	CloseHandle((HANDLE)mMapping);
+	CloseHandle((HANDLE)mFile);
+#else
+	munmap((void*)mData, mSize);
+#endif
+	mData = nullptr;
+	mSize = 0;
+	mFile = mMapping = nullptr;
+}
+
 GLuint load_shaders(const char* vertexPath, const char* fragmentPath)
 {
-	// ̴  
+	// 쉐이더 파일 열기
 	std::ifstream vShaderFile(vertexPath);
 	std::ifstream fShaderFile(fragmentPath);
 
-	//  ⿡    
+	// 파일 열기에 실패한 경우 에러 출력
 	if (!vShaderFile.is_open() || !fShaderFile.is_open()) {
 		std::cerr << "ERROR: Failed to open shader file(s)\n";
 		return 0;
 	}
 
-	//   Ʈ о
+	// 파일 내용을 스트림으로 읽어오기
 	std::stringstream vShaderStream, fShaderStream;
-	vShaderStream << vShaderFile.rdbuf();  //  ̴ ڵ б
-	fShaderStream << fShaderFile.rdbuf();  // ׸Ʈ ̴ ڵ б
+	vShaderStream << vShaderFile.rdbuf();  // 정점 쉐이더 코드 읽기
+	fShaderStream << fShaderFile.rdbuf();  // 프래그먼트 쉐이더 코드 읽기
 
-	// Ʈ ڿ ȯ
+	// 스트림에서 문자열로 변환
 	std::string vertexCode = vShaderStream.str();
 	std::string fragmentCode = fShaderStream.str();
 
-	// C ڿ ͷ ȯ (OpenGL Լ ȣ)
+	// C 문자열 포인터로 변환 (OpenGL 함수 호출용)
 	const char* vShaderCode = vertexCode.c_str();
 	const char* fShaderCode = fragmentCode.c_str();
 
-	// ̴ ü 
+	// 쉐이더 객체 생성
 	GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
 	GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
 
-	// ̴ ҽ   
+	// 쉐이더 소스 설정 및 컴파일
 	glShaderSource(vertexShader, 1, &vShaderCode, nullptr);
 	glCompileShader(vertexShader);
 	glShaderSource(fragmentShader, 1, &fShaderCode, nullptr);
 	glCompileShader(fragmentShader);
 
-	//  ̴    Ȯ
+	// 정점 쉐이더 컴파일 성공 여부 확인
 	GLint success;
 	GLchar infoLog[512];
 	glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
@@ -764,7 +1523,7 @@ GLuint load_shaders(const char* vertexPath, const char* fragmentPath)
 		return 0;
 	}
 
-	// ׸Ʈ ̴    Ȯ
+	// 프래그먼트 쉐이더 컴파일 성공 여부 확인
 	glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
 	if (!success) {
 		glGetShaderInfoLog(fragmentShader, 512, nullptr, infoLog);
@@ -772,17 +1531,17 @@ GLuint load_shaders(const char* vertexPath, const char* fragmentPath)
 		return 0;
 	}
 
-	// α׷ ü 
+	// 프로그램 객체 생성
 	GLuint programID = glCreateProgram();
 
-	// ̴ α׷ 
+	// 쉐이더를 프로그램에 연결
 	glAttachShader(programID, vertexShader);
 	glAttachShader(programID, fragmentShader);
 
-	// α׷ ũ
+	// 프로그램 링크
 	glLinkProgram(programID);
 
-	// ũ   Ȯ
+	// 링크 성공 여부 확인
 	glGetProgramiv(programID, GL_LINK_STATUS, &success);
 	if (!success) {
 		glGetProgramInfoLog(programID, 512, nullptr, infoLog);
@@ -790,23 +1549,58 @@ GLuint load_shaders(const char* vertexPath, const char* fragmentPath)
 		return 0;
 	}
 
-	// ̴ ü  (α׷ ̹ ǾǷ ʿ )
+	// 쉐이더 객체 삭제 (프로그램에 이미 연결되었으므로 필요 없음)
 	glDeleteShader(vertexShader);
 	glDeleteShader(fragmentShader);
 
-	//  α׷ ID ȯ
+	// 링크 시점에 유니폼 위치를 구해 둔다.
+	DgShader::get(programID);
+
+	// 최종 프로그램 ID 반환
 	return programID;
 }
 
+DgShader::DgShader(GLuint id)
+{
+	static const char* names[NUM_UNIFORMS] = {
+		"uModel", "uKa", "uKd", "uKs", "uNs", "uTex", "uSDFAtlas", "uMacroAtlas",
+		"uMacroSize", "uTileMask", "uTileSize", "uSDFMaxLod", "uDebugSteps"
+	};
+
+	mId = id;
+	for (int i = 0; i < NUM_UNIFORMS; ++i)
+		mLocs[i] = (id != 0) ? glGetUniformLocation(id, names[i]) : -1;
+
+	// 카메라와 SDF 볼륨 유니폼 블록을 공통 바인딩 지점에 연결한다.
+	if (id != 0)
+	{
+		GLuint blockIdx = glGetUniformBlockIndex(id, "CameraBlock");
+		if (blockIdx != GL_INVALID_INDEX)
+			glUniformBlockBinding(id, blockIdx, CAMERA_UBO_BINDING);
+		blockIdx = glGetUniformBlockIndex(id, "SDFVolumeBlock");
+		if (blockIdx != GL_INVALID_INDEX)
+			glUniformBlockBinding(id, blockIdx, SDF_UBO_BINDING);
+	}
+}
+
+const DgShader& DgShader::get(GLuint id)
+{
+	static std::unordered_map<GLuint, DgShader> shaders;
+	auto it = shaders.find(id);
+	if (it == shaders.end())
+		it = shaders.emplace(id, DgShader(id)).first;
+	return it->second;
+}
+
 void DgMesh::addFace(DgFace* pFace)
 {
-	// ﰢ ε ϰ ﰢ 迭 ߰Ѵ.
+	// 삼각형의 인덱스를 설정하고 삼각형 배열에 추가한다.
 	pFace->mIdx = (int)mFaces.size();
 	mFaces.push_back(*pFace);
 }
 
 /**********************/
-/* DgFace Ŭ  */
+/* DgFace 클래스 구현 */
 /**********************/
 DgMesh* DgFace::getMesh()
 {
@@ -855,12 +1649,12 @@ double DgFace::getArea()
 
 DgVec3 DgFace::getFaceNormal(bool bLocal)
 {
-	// ﰢ   ġ Ͽ
+	// 삼각형의 세 정점의 위치를 구하여
 	DgPos& p0 = mEdge->mVert->mPos;
 	DgPos& p1 = mEdge->mNext->mVert->mPos;
 	DgPos& p2 = mEdge->mNext->mNext->mVert->mPos;
 
-	//    Ͽ ȯѴ.
+	// 단위 길이의 법선을 구하여 반환한다.
 	DgVec3 e0 = (p1 - p0) * 1000.0;
 	DgVec3 e1 = (p2 - p0) * 1000.0;
 	DgVec3 N = (e0 ^ e1).normalize();
@@ -880,24 +1674,24 @@ bool DgFace::isBndryFace()
 
 
 /**********************/
-/* DgEdge Ŭ  */
+/* DgEdge 클래스 구현 */
 /**********************/
 DgEdge::DgEdge(DgVertex* pVert, DgTexel* pTexel, DgNormal* pNormal)
 {
-	// , ؼ,     ҴѴ.
+	// 정점, 텍셀, 법선 정보를 에지의 시작점에 할당한다.
 	mVert = pVert;
 	mTexel = pTexel;
 	mNormal = pNormal;
 
-	//  , ݴ ,   ﰢ  ͸ ʱȭѴ.
+	// 다음 에지, 반대편 에지, 에지가 속한 삼각형에 대한 포인터를 초기화한다.
 	mNext = NULL;
 	mMate = NULL;
 	mFace = NULL;
 
-	//     ߰Ѵ.
+	// 시작점의 정점에 현재 에지를 추가한다.
 	mVert->mEdges.push_back(this);
 
-	//   ʱȭ Ѵ.
+	// 에지 비용을 초기화 한다.
 	mCostOrLen = 0.0;
 }
 
@@ -919,19 +1713,19 @@ bool DgEdge::isBndry()
 
 double DgEdge::getAngle(bool bRadian)
 {
-	//  Ե ﰢ    ͸ Ѵ.
+	// 에지가 포함된 삼각형에서 세 점과 법선 벡터를 구한다.
 	DgPos p = mVert->mPos;
 	DgPos q = mNext->mVert->mPos;
 	DgPos r = mNext->mNext->mVert->mPos;
 	DgVec3 N = mFace->getFaceNormal(true);
 
-	//  ֺ ִ  Ͽ ȯѴ.
+	// 에지가 마주보고 있는 각도를 계산하여 반환한다.
 	return (bRadian) ? angle(p - r, q - r, N, true) : angle(p - r, q - r, N, false);
 }
 
 
 /**********************/
-/* DgVec3 Ŭ  */
+/* DgVec3 클래스 구현 */
 /**********************/
 
 DgVec3::DgVec3(double x, double y, double z)
@@ -1131,7 +1925,7 @@ std::istream& operator >>(std::istream& is, DgVec3& v)
 }
 
 /*************************/
-/* DgVec3 ƿ Լ  */
+/* DgVec3 유틸 함수 구현 */
 /*************************/
 
 DgVec3 proj(const DgVec3& u, const DgVec3& v)
@@ -1146,10 +1940,10 @@ DgVec3 proj(const DgVec3& u, const DgVec3& v)
 
 DgVec3 ortho(const DgVec3& v)
 {
-	//    ã  std::min 
+	// 가장 작은 값을 찾기 위해 std::min 사용
 	double min_val = std::min({ v.mPos[0], v.mPos[1], v.mPos[2] });
 
-	//     ret 
+	// 가장 작은 값을 기준으로 ret 설정
 	DgVec3 ret;
 	if (min_val == v[0])
 		ret.setCoords(0.0, -v[2], v[1]);
@@ -1167,7 +1961,7 @@ DgVec3 ortho(const DgVec3& v)
 
 double det(const DgVec3& u, const DgVec3& v, const DgVec3& w)
 {
-	// det (u, v, w) =  u * ( v ^ w)  
+	// det (u, v, w) =  u * ( v ^ w) 와 같음
 	return (
 		u.mPos[0] * (v.mPos[1] * w.mPos[2] - v.mPos[2] * w.mPos[1]) -
 		u.mPos[1] * (v.mPos[0] * w.mPos[2] - v.mPos[2] * w.mPos[0]) +
@@ -1218,17 +2012,17 @@ double angle(const DgVec3& u, const DgVec3& v, const DgVec3& axis, bool radian)
 }
 
 /***********************/
-/* intersect Լ  */
+/* intersect 함수 구현 */
 /***********************/
 
 /*!
-*	\brief	    θ ˻Ѵ.
+*	\brief	평면과 경계 상자의 교차 여부를 검사한다.
 *
-*	\param	n[in]			 
-*	\param	p[in]			  
-*	\param	halfsize[in]	 ߽ϴ      
+*	\param	n[in]			평면의 법선
+*	\param	p[in]			평면 위의 점
+*	\param	halfsize[in]	원점을 중심으로하는 경계 상자의 각 축 길이의 반
 *
-*	\return   ڰ ϸ true, ƴϸ false ȯѴ.
+*	\return 평면과 경계 상자가 교차하면 true, 아니면 false를 반환한다.
 */
 static bool intersect_plane_box(DgVec3 n, DgVec3 p, DgVec3 halfsize)
 {
@@ -1255,7 +2049,7 @@ static bool intersect_plane_box(DgVec3 n, DgVec3 p, DgVec3 halfsize)
 
 bool intersect_tri_box(DgPos u0, DgPos u1, DgPos u2, DgPos box_min, DgPos box_max)
 {
-	// x  ׽Ʈ
+	// x 축 테스트
 #define AXISTEST_X01(a, b, fa, fb)	\
 		p0 = a * v0[1] - b * v0[2];	p2 = a * v2[1] - b * v2[2];	\
 		if (p0 < p2) { min = p0; max = p2; } else { min = p2;  max = p0; }	\
@@ -1268,7 +2062,7 @@ bool intersect_tri_box(DgPos u0, DgPos u1, DgPos u2, DgPos box_min, DgPos box_ma
 		rad = fa * box_halfsize[1] + fb * box_halfsize[2];   \
 		if (min > rad || max < -rad) return 0
 
-	// y  ׽Ʈ
+	// y 축 테스트
 #define AXISTEST_Y02(a, b, fa, fb)			   \
 		p0 = -a * v0[0] + b * v0[2]; p2 = -a * v2[0] + b * v2[2];	\
 		if (p0 < p2) { min = p0; max = p2; } else { min = p2; max = p0; } \
@@ -1281,7 +2075,7 @@ bool intersect_tri_box(DgPos u0, DgPos u1, DgPos u2, DgPos box_min, DgPos box_ma
 		rad = fa * box_halfsize[0] + fb * box_halfsize[2];   \
 		if (min > rad || max < -rad) return 0
 
-	// z  ׽Ʈ
+	// z 축 테스트
 #define AXISTEST_Z12(a, b, fa, fb)			   \
 		p1 = a * v1[0] - b * v1[1];	p2 = a * v2[0] - b * v2[1];			       	   \
 		if (p2 < p1) { min = p2; max = p1; } else { min = p1; max = p2; } \
@@ -1301,7 +2095,7 @@ bool intersect_tri_box(DgPos u0, DgPos u1, DgPos u2, DgPos box_min, DgPos box_ma
 			if (x2 < min) min = x2; \
 				if (x2 > max) max = x2;
 
-	//   ߽   ﰢ  ǥ ȯ
+	// 경계 상자의 중심이 원점에 오도록 삼각형 정점의 좌표를 변환
 	double min, max, p0, p1, p2, rad;
 	DgVec3 box_halfsize = (box_max - box_min) * 0.5;
 	DgPos box_cnt = box_min + box_halfsize;
@@ -1309,12 +2103,12 @@ bool intersect_tri_box(DgPos u0, DgPos u1, DgPos u2, DgPos box_min, DgPos box_ma
 	DgVec3 v1 = u1 - box_cnt;
 	DgVec3 v2 = u2 - box_cnt;
 
-	// ﰢ  Ѵ.
+	// 삼각형 에지를 구한다.
 	DgVec3 e0 = v1 - v0;
 	DgVec3 e1 = v2 - v1;
 	DgVec3 e2 = v0 - v2;
 
-	// ׽Ʈ 1: 9 ࿡  SAT Ѵ.
+	// 테스트 1: 9개의 축에 대한 SAT를 수행한다.
 	double fex = abs(e0[0]);
 	double fey = abs(e0[1]);
 	double fez = abs(e0[2]);
@@ -1336,7 +2130,7 @@ bool intersect_tri_box(DgPos u0, DgPos u1, DgPos u2, DgPos box_min, DgPos box_ma
 	AXISTEST_Y1(e2[2], e2[0], fez, fex);
 	AXISTEST_Z12(e2[1], e2[0], fey, fex);
 
-	// ׽Ʈ 2: {x, y, z} ࿡  SAT Ѵ.
+	// 테스트 2: {x, y, z} 축에 대한 SAT를 수행한다.
 	FINDMINMAX(v0[0], v1[0], v2[0], min, max);
 	if (min > box_halfsize[0] || max < -box_halfsize[0]) return false;
 	FINDMINMAX(v0[1], v1[1], v2[1], min, max);
@@ -1344,7 +2138,7 @@ bool intersect_tri_box(DgPos u0, DgPos u1, DgPos u2, DgPos box_min, DgPos box_ma
 	FINDMINMAX(v0[2], v1[2], v2[2], min, max);
 	if (min > box_halfsize[2] || max < -box_halfsize[2]) return false;
 
-	// ׽Ʈ 3: ﰢ    ڿ  ˻
+	// 테스트 3: 삼각형이 놓인 평면과 경계 상자와의 교차 검사
 	DgVec3 n = (e0 ^ e1).normalize();
 	if (!intersect_plane_box(n, v0, box_halfsize))
 		return false;
@@ -1354,74 +2148,74 @@ bool intersect_tri_box(DgPos u0, DgPos u1, DgPos u2, DgPos box_min, DgPos box_ma
 
 int intersect_tri_tri(DgPos a0, DgPos a1, DgPos a2, DgPos b0, DgPos b1, DgPos b2, DgPos& p, DgPos& q, double eps)
 {
-	// ﰢ, , 鿡 ﰢ   Ÿ
+	// 삼각형, 평면, 평면에서 삼각형 각 점까지 거리
 	DgPos a[3] = { a0, a1, a2 }, b[3] = { b0, b1, b2 };
 	DgPlane planeA(a0, a1, a2), planeB(b0, b1, b2);
 	double da[3], db[3];
 
-	// Case 1: ﰢ A  planeB /Ʒʿ ִ : 
+	// Case 1: 삼각형 A가 평면 planeB 위/아래쪽에 있는 경우: 비교차
 	for (int i = 0; i < 3; ++i)
 	{
 		da[i] = planeB.eval(a[i]);
-		if (std::fabs(da[i]) < eps) // planeB  پ ִٸ
+		if (std::fabs(da[i]) < eps) // planeB에 거의 붙어 있다면
 		{
 			da[i] = 0.0;
 			a[i] = ::proj(a[i], planeB);
 		}
 	}
 	if ((da[0] > 0.0 && da[1] > 0.0 && da[2] > 0.0) || (da[0] < 0.0 && da[1] < 0.0 && da[2] < 0.0))
-		return 0;	// 
+		return 0;	// 비교차
 
-	// Case 1: ﰢ B  planeA /Ʒʿ ִ : 
+	// Case 1: 삼각형 B가 평면 planeA 위/아래쪽에 있는 경우: 비교차
 	for (int i = 0; i < 3; ++i)
 	{
 		db[i] = planeA.eval(b[i]);
-		if (std::fabs(db[i]) < eps)	// planeA  پ ִٸ
+		if (std::fabs(db[i]) < eps)	// planeA에 거의 붙어 있다면
 		{
 			db[i] = 0.0;
 			b[i] = ::proj(b[i], planeA);
 		}
 	}
 	if ((db[0] > 0.0 && db[1] > 0.0 && db[2] > 0.0) || (db[0] < 0.0 && db[1] < 0.0 && db[2] < 0.0))
-		return 0;	// 
+		return 0;	// 비교차
 
-	// Case 2: ﰢ A B  鿡  ( θ ȯϰ, ټ   )
+	// Case 2: 삼각형 A과 B가 동일 평면에 놓인 경우(교차 여부만 반환하고, 다수의 교차점은 계산하지 않음)
 	if (da[0] == 0.0 && da[1] == 0.0 && da[2] == 0.0)
 	{
-		// Case 2(a):   ʴ : 
+		// Case 2(a): 경계원이 교차하지 않는 경우: 비교차
 		DgPos c1 = a[2] + (a[0] - a[2]) / 3.0 + (a[1] - a[2]) / 3.0;
 		DgPos c2 = b[2] + (b[0] - b[2]) / 3.0 + (b[1] - b[2]) / 3.0;
 		double r1 = std::max({ dist(c1, a[0]), dist(c1, a[1]), dist(c1, a[2])});
 		double r2 = std::max({ dist(c2, b[0]), dist(c2, b[1]), dist(c2, b[2]) });
-		if (r1 + r2 < dist(c1, c2))	return 0;	// 
+		if (r1 + r2 < dist(c1, c2))	return 0;	// 비교차
 
-		// Case 2(b):  ﰢ  ϳ ϴ : ( ̹ȯ).
+		// Case 2(b): 두 삼각형의 에지쌍이 하나라도 교차하는 경우: 교차(교차점 미반환).
 		DgPos r, s;
 		for (int i = 0; i < 3; ++i)
 			for (int j = 0; j < 3; ++j)
 				if (intersect_edge_edge(a[i], a[(i + 1) % 3], b[j], b[(j + 1) % 3], r, s))
-					return -1;	//   
+					return -1;	// 동일 평면 교차
 
-		// Case 2(c): ϳ ﰢ ٸ ﰢ ο Ե 
+		// Case 2(c): 하나의 삼각형이 다른 삼각형의 내부에 포함된 경우
 		for (int i = 0; i < 3; ++i)
 		{
 			DgVec3 uvw = get_barycentric_coords(a[i], b[0], b[1], b[2]);
 			if (uvw[0] >= 0.0 && uvw[1] >= 0.0 && uvw[2] >= 0.0)
-				return -1;	// Case 2(b)  ,   ˻ 
+				return -1;	// Case 2(b)를 통과 했으니, 한 점 검사로 충분
 
 			uvw = get_barycentric_coords(b[i], a[0], a[1], a[2]);
 			if (uvw[0] >= 0.0 && uvw[1] >= 0.0 && uvw[2] >= 0.0)
-				return -1;	// Case 2(b)  ,   ˻ 
+				return -1;	// Case 2(b)를 통과 했으니, 한 점 검사로 충분
 		}
 
-		// Case 2(a):  鿡   ʴ : 
-		return 0;	// 
+		// Case 2(a): 한 평면에 있지만 교차하지 않는 경우: 비교차
+		return 0;	// 비교차
 	}
 
-	// Case 3: (κ )ﰢ B  planeA ϴ 
+	// Case 3: (대부분의 경우)삼각형 B가 평면 planeA와 교차하는 경우
 	if (db[0] != 0.0 && db[1] != 0.0 && db[2] != 0.0)
 	{
-		// ﰢ B  planeA   rs Ѵ.
+		// 삼각형 B과 평면 planeA의 교차 선분 rs를 구한다.
 		DgPos r, s;
 		for (int i0 = 0; i0 < 3; ++i0)
 		{
@@ -1434,28 +2228,28 @@ int intersect_tri_tri(DgPos a0, DgPos a1, DgPos a2, DgPos b0, DgPos b1, DgPos b2
 			}
 		}
 
-		//  rs ﰢ A   pq Ѵ.
+		// 교차선분 rs와 삼각형 A와 교차 선분 pq를 구한다.
 		return intersect_edge_tri(r, s, a[0], a[1], a[2], p, q);
 	}
 
-	// Case 4: ﰢ B   Ǵ    planeA  
+	// Case 4: 삼각형 B의 한 점 또는 두 점이 평면 planeA에 놓인 경우
 	int i0 = (db[0] == 0.0) ? 0 : (db[1] == 0.0) ? 1 : 2;
 	int i1 = (i0 + 1) % 3;
 	int i2 = (i0 + 2) % 3;
 	DgPos r(b[i0]), s(b[i0]);
 
-	// ﰢ B  planeA   
+	// 삼각형 B와 평면 planeA와 나머지 교차점 계산
 	if (db[i1] * db[i2] <= 0.0)
 		s = b[i1] + (db[i1] / (db[i1] - db[i2])) * (b[i2] - b[i1]);
 	else
-		return 0; //    , 
+		return 0; // 한 점 교차인 경우, 비교차
 
-	//  rs ﰢ A   pq Ѵ.
+	// 교차선분 rs와 삼각형 A와 교차 선분 pq를 구한다.
 	return intersect_edge_tri(r, s, a[0], a[1], a[2], p, q);
 }
 
 /*********************/
-/* DgPos Ŭ  */
+/* DgPos 클래스 구현 */
 /*********************/
 DgPos::DgPos(double x, double y, double z)
 {
@@ -1630,46 +2424,46 @@ std::istream& operator >>(std::istream& is, DgPos& p)
 }
 
 /************************/
-/* DgVertex Ŭ  */
+/* DgVertex 클래스 구현 */
 /************************/
 
 std::vector<DgEdge*> DgVertex::getEdges(bool bCCW)
 {
-	// ݽð   ʴ´ٸ  迭 ȯѴ.
+	// 반시계 방향으로 정렬하지 않는다면 에지 배열을 반환한다.
 	if (!bCCW)
 		return mEdges;
 
-	//  ̶  迭 ȯѴ.
+	// 고립 정점이라면 빈 배열을 반환한다.
 	if (mEdges.empty())
 		return std::vector<DgEdge*>();
 
-	// ð  ȸ
+	// 시계 방향 순회
 	std::vector<DgEdge*> edgeList;
 	DgEdge* e = mEdges[0];
 	do {
-		if (e->mMate == nullptr) break; // (1):    
+		if (e->mMate == nullptr) break; // 조건(1): 경계 에지를 만난 경우
 		edgeList.emplace_back(e);
 		e = e->mMate->mNext;
-	} while (e != mEdges[0]); // (2): ۿ ǵƿ 
+	} while (e != mEdges[0]); // 조건(2): 시작에지로 되돌아온 경우
 
-	//   : (1)  
+	// 경계 정점인 경우: 조건(1)로 나온 경우
 	if (mEdges.size() != edgeList.size())
 	{
-		// ݽð  ȸ
+		// 반시계 방향 순회
 		edgeList.clear();
 		do {
 			edgeList.emplace_back(e);
 			e = e->mNext->mNext->mMate;
 		} while (e != nullptr);
 
-		// Non-manifold  
+		// Non-manifold 정점의 경우
 		if (mEdges.size() != edgeList.size())
 		{
 			edgeList.clear();
 			throw std::runtime_error("Non-manifold vertex...\n");
 		}
 	}
-	else //   ƴ : (2)  
+	else // 경계 정점이 아닌 경우: 조건(2)로 나온 경우
 		std::reverse(edgeList.begin(), edgeList.end());
 
 	return edgeList;
@@ -1689,12 +2483,12 @@ std::vector<DgVertex*> DgVertex::getOneRingVerts(bool bCCW)
 
 DgVec3 DgVertex::getAvgNormal(bool bWgt)
 {
-	//  ó
+	// 예외 처리
 	DgVec3 N;
 	if (mEdges.empty())
 		return N;
 
-	//  ġ ϴ 
+	// 각도 가중치를 고려하는 경우
 	if (bWgt)
 	{
 		std::vector<double> weights;
@@ -1721,7 +2515,7 @@ DgVec3 DgVertex::getAvgNormal(bool bWgt)
 			}
 		}
 	}
-	else // ܼ  ϴ 
+	else // 단순 평균을 구하는 경우
 	{
 		for (DgEdge* e : mEdges)
 		{
@@ -1747,5 +2541,5 @@ bool DgVertex::isBndry()
 }
 
 /************************/
-/* DgNormal Ŭ  */
+/* DgNormal 클래스 구현 */
 /************************/
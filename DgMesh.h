@@ -1,6 +1,6 @@
 #pragma once
 
-//  
+// 전방 선언
 class DgMesh;
 class DgEdge;
 class DgVertex;
@@ -9,218 +9,220 @@ class DgNormal;
 class DgFace;
 class DgMaterial;
 class DgVec3;
+class DgMappedFile;
+class DgShader;
 
 /*!
  *	\class	DgPos
- *	\brief	3 ġ Ÿ Ŭ
+ *	\brief	3차원 위치를 나타내는 클래스
  */
 class DgPos
 {
 public:
-	/*! \brief 3 ġ ǥ */
+	/*! \brief 3차원 위치 좌표 */
 	double mPos[3];
 
 public:
 	/*!
-	*	\brief	
+	*	\brief	생성자
 	*
-	*	\param[in]	x	x ǥ
-	*	\param[in]	y	y ǥ
-	*	\param[in]	z	z ǥ
+	*	\param[in]	x	x 좌표
+	*	\param[in]	y	y 좌표
+	*	\param[in]	z	z 좌표
 	*/
 	DgPos(double x = 0.0, double y = 0.0, double z = 0.0);
 
 	/*!
-	*	\brief	
+	*	\brief	생성자
 	*
-	*	\param[in]	Coords	3 ǥ(x, y, z)
+	*	\param[in]	Coords	3차원 좌표(x, y, z)
 	*/
 	DgPos(double* Pos);
 
 	/*!
-	*	\brief	
+	*	\brief	생성자
 	*
-	*	\param[in]	Coords	3 ǥ(x, y, z)
+	*	\param[in]	Coords	3차원 좌표(x, y, z)
 	*/
 	DgPos(float* Pos);
 
 	/*!
-	*	\brief	 
+	*	\brief	복사 생성자
 	*
-	*	\param[in]	cpy  ü
+	*	\param[in]	cpy 복사될 객체
 	*
-	*	\return  ڽ ȯѴ.
+	*	\return 복사된 자신을 반환한다.
 	*/
 	DgPos(const DgPos& cpy);
 
 	/*!
-	*	\brief  Ҹ
+	*	\brief  소멸자
 	*/
 	~DgPos();
 
 	/*!
-	*	\brief	Ʈ ǥ Ѵ.
+	*	\brief	포인트의 좌표를 설정한다.
 	*
-	*	\param[in]	x x ǥ
-	*	\param[in]	y y ǥ
-	*	\param[in]	z z ǥ
+	*	\param[in]	x x 좌표
+	*	\param[in]	y y 좌표
+	*	\param[in]	z z 좌표
 	*
-	*	\return  ڽ ȯѴ.
+	*	\return 설정된 자신을 반환한다.
 	*/
 	DgPos& setCoords(double x, double y, double z);
 
 	/*!
-	 * \brief  \a p  \a q Ÿ  Ѵ.
+	 * \brief 점 \a p에서 점 \a q까지의 거리 제곱을 구한다.
 	 *
-	 * \param[in] p ù ° 
-	 * \param[in] q  ° 
+	 * \param[in] p 첫 번째 점
+	 * \param[in] q 두 번째 점
 	 *
-	 * \return  \a p  \a q Ÿ  ȯѴ.
+	 * \return 점 \a p에서 점 \a q까지의 거리 제곱을 반환한다.
 	 */
 	double distance_sq(const DgPos& p, const DgPos& q);
 
 	/*!
-	 * \brief  \a p  \a q Ÿ Ѵ.
+	 * \brief 점 \a p에서 점 \a q까지의 거리를 구한다.
 	 *
-	 * \param[in] p ù ° 
-	 * \param[in] q  ° 
+	 * \param[in] p 첫 번째 점
+	 * \param[in] q 두 번째 점
 	 *
-	 * \return  \a p  \a q Ÿ ȯѴ.
+	 * \return 점 \a p에서 점 \a q까지의 거리를 반환한다.
 	 */
 	double dist(const DgPos& p, const DgPos& q);
 
 	/*!
-	*	\brief	 
+	*	\brief	대입 연산자
 	*
-	*	\param[in]	rhs		 ǿ
+	*	\param[in]	rhs		오른쪽 피연산자
 	*
-	*	\return Ե ڽ ȯѴ.
+	*	\return 대입된 자신을 반환한다.
 	*/
 	DgPos& operator =(const DgPos& rhs);
 
 	/*!
-	*	\brief	͸ Ѵ.
+	*	\brief	벡터를 더한다.
 	*
-	*	\param[in]	v	 
+	*	\param[in]	v	더할 벡터
 	*
-	*	\return  ڽ ȯѴ.
+	*	\return 변경된 자신을 반환한다.
 	*/
 	DgPos& operator +=(const DgVec3& v);
 
 	/*!
-	*	\brief	͸ .
+	*	\brief	벡터를 뺀다.
 	*
-	*	\param[in]	v	 
+	*	\param[in]	v	뺄 벡터
 	*
-	*	\return  ڽ ȯѴ.
+	*	\return 변경된 자신을 반환한다.
 	*/
 	DgPos& operator -=(const DgVec3& v);
 
 	/*!
-	*	\brief	ε ([])
+	*	\brief	인덱스 연산자([])
 	*
-	*	\param[in]	idx ε
+	*	\param[in]	idx 인덱스
 	*
-	*	\return Ʈ idx °  ۷ ȯѴ.
+	*	\return 포인트의 idx 번째 원소의 레퍼런스를 반환한다.
 	*/
 	double& operator [](const int& idx);
 
 	/*!
-	*	\brief	 ü ε ([])
+	*	\brief	상수 객체의 인덱스 연산자([])
 	*
-	*	\param[in]	idx ε
+	*	\param[in]	idx 인덱스
 	*
-	*	\return Ʈ idx °  ۷ ȯѴ.
+	*	\return 포인트의 idx 번째 원소의 레퍼런스를 반환한다.
 	*/
 	const double& operator [](const int& idx) const;
 
 	/*!
-	*	\brief	 ġ  ͸ Ѵ.
+	*	\brief	두 위치의 차이 벡터를 구한다.
 	*
-	*	\param[in]	p	ù ° ġ
-	*	\param[in]	q	 ° ġ
+	*	\param[in]	p	첫 번째 위치
+	*	\param[in]	q	두 번째 위치
 	*
-	*	\return q p ϴ ͸ ȯѴ.
+	*	\return q에서 p로 향하는 벡터를 반환한다.
 	*/
 	friend DgVec3 operator -(const DgPos& p, const DgPos& q);
 
 	/*!
-	*	\brief	ġ ͸ .
+	*	\brief	위치에서 벡터를 뺀다.
 	*
-	*	\param[in]	p	ġ
-	*	\param[in]	v	
+	*	\param[in]	p	위치
+	*	\param[in]	v	벡터
 	*
-	*	\return ο ġ ȯѴ.
+	*	\return 새로운 위치를 반환한다.
 	*/
 	friend DgPos operator -(const DgPos& p, const DgVec3& v);
 
 	/*!
-	*	\brief	ġ ͸ Ѵ.
+	*	\brief	위치에서 벡터를 더한다.
 	*
-	*	\param[in]	p	ġ
-	*	\param[in]	v	
+	*	\param[in]	p	위치
+	*	\param[in]	v	벡터
 	*
-	*	\return ο ġ ȯѴ.
+	*	\return 새로운 위치를 반환한다.
 	*/
 	friend DgPos operator +(const DgPos& p, const DgVec3& v);
 
 	/*!
-	*	\brief	ġ ͸ Ѵ.
+	*	\brief	위치에서 벡터를 더한다.
 	*
-	*	\param[in]	v	
-	*	\param[in]	p	ġ
+	*	\param[in]	v	벡터
+	*	\param[in]	p	위치
 	*
-	*	\return ο ġ ȯѴ.
+	*	\return 새로운 위치를 반환한다.
 	*/
 	friend DgPos operator +(const DgVec3& v, const DgPos& p);
 
 	/*!
-	*	\brief	 ġ  Ѵ.
+	*	\brief	두 위치가 같은지 조사한다.
 	*
-	*	\param[in]	p	ù ° ġ
-	*	\param[in]	q	  ġ
+	*	\param[in]	p	첫 번째 위치
+	*	\param[in]	q	두 번재 위치
 	*
-	*	\return  ġ  true, ٸ false ȯѴ.
+	*	\return 두 위치가 같으면 true, 다르면 false를 반환한다.
 	*/
 	friend bool operator ==(const DgPos& p, const DgPos& q);
 
 	/*!
-	*	\brief	 ġ ٸ Ѵ.
+	*	\brief	두 위치가 다른지 조사한다.
 	*
-	*	\param[in]	p	ù ° ġ
-	*	\param[in]	q	  ġ
+	*	\param[in]	p	첫 번째 위치
+	*	\param[in]	q	두 번재 위치
 	*
-	*	\return  ġ ٸ true,  false ȯѴ.
+	*	\return 두 위치가 다르면 true, 같으면 false를 반환한다.
 	*/
 	friend bool operator !=(const DgPos& p, const DgPos& q);
 
 	/*!
-	 *	\brief	 ġ ǥ  ũ⸦ Ѵ.
+	 *	\brief	두 위치의 좌표 순서 크기를 비교한다.
 	 *
-	 *	\param[in]	p	ù ° ġ
-	 *	\param[in]	q	  ġ
+	 *	\param[in]	p	첫 번째 위치
+	 *	\param[in]	q	두 번재 위치
 	 *
-	 *	\return p ġ q ġ ̸ true, ƴϸ false ȯѴ.
+	 *	\return p의 위치가 q의 위치보다 앞이면 true, 아니면 false를 반환한다.
 	 */
 	friend bool operator <(const DgPos& p, const DgPos& q);
 
 	/*!
-	*	\brief	 (<<)
+	*	\brief	출력 연산자(<<)
 	*
-	*	\param[out]	os		 Ʈ
-	*	\param[in]	p		 ü
+	*	\param[out]	os		출력 스트림
+	*	\param[in]	p		출력할 객체
 	*
-	*	\return µ Ʈ ü ȯѴ.
+	*	\return 출력된 스트림 객체를 반환한다.
 	*/
 	friend std::ostream& operator <<(std::ostream& os, const DgPos& p);
 
 	/*!
-	*	\brief	Է (>>)
+	*	\brief	입력 연산자(>>)
 	*
-	*	\param[in]	is	Է Ʈ
-	*	\param[out]	v	Է°  
+	*	\param[in]	is	입력 스트림
+	*	\param[out]	v	입력값이 저장될 벡터
 	*
-	*	\return Է° ŵ Է Ʈ ȯѴ.
+	*	\return 입력값이 제거된 입력 스트림을 반환한다.
 	*/
 	friend std::istream& operator >>(std::istream& is, DgPos& p);
 
@@ -228,24 +230,24 @@ public:
 
 /*!
  *	\class	DgVertex
- *	\brief	 ǥϴ Ŭ
+ *	\brief	정점을 표현하는 클래스
  */
 class DgVertex
 {
 public:
-	/*! \brief  ǥ */
+	/*! \brief 정점의 좌표 */
 	double mPos[3];	
 
-	/*! \brief  Ե ޽  */
+	/*! \brief 정점이 포함된 메쉬 포인터 */
 	DgMesh* mMesh;
 
-	/*! \brief  ε */
+	/*! \brief 정점의 인덱스 */
 	int mIdx;
 
-	/*! \brief  3 ǥ */
+	/*! \brief 정점의 3차원 좌표 */
 	DgPos mPos;
 
-	/*! \brief  ϴ  迭 */
+	/*! \brief 정점에서 시작하는 하프에지 배열 */
 	std::vector<DgEdge *> mEdges;
 public:
 	DgVertex(double x, double y, double z) {
@@ -256,37 +258,37 @@ public:
 	~DgVertex() {}
 
 	/*!
-	 *	\brief	 ϴ  迭 ȯѴ.
+	 *	\brief	정점에서 시작하는 에지 배열을 반환한다.
 	 *
-	 *	\param[in]	bCCW	ݽð  Ϸ true, ƴϸ false
+	 *	\param[in]	bCCW	반시계 방향으로 정렬하려면 true, 아니면 false
 	 *
-	 *	\return  ϴ  迭 ȯѴ.
+	 *	\return 정점에서 시작하는 에지 배열을 반환한다.
 	 */
 	std::vector<DgEdge*> getEdges(bool bCCW = false);
 
 	/*!
-	 *	\brief	 1 ̿  Ѵ.
+	 *	\brief	정점의 1링 이웃 정점을 구한다.
 	 *
-	 *	\param[in]	bCCW	ݽð  Ϸ true, ƴϸ false
+	 *	\param[in]	bCCW	반시계 방향으로 정렬하려면 true, 아니면 false
 	 *
-	 *	\return 1 ̿  Ʈ ȯѴ.
+	 *	\return 1링을 이웃 정점의 리스트를 반환한다.
 	 */
 	std::vector<DgVertex*> getOneRingVerts(bool bCCW);
 
 	/*!
-	 *	\brief	    Ѵ.
-	 *	\note	(*)ֺ  ġ Ǵ ,  ġ ݿϿ  ϹǷ ſ ؾ Ѵ.
+	 *	\brief	정점의 평균 단위 법선을 구한다.
+	 *	\note	(*)주변 정점의 위치가 변경되는 경우, 변경된 위치를 반영하여 법선을 계산하므로 매우 주의해야 한다.
 	 *
-	 *	\param	bWgt[in]	 ġ  
+	 *	\param	bWgt[in]	각도 가중치 적용 여부
 	 *
-	 *	\return     ȯѴ.
+	 *	\return 정점의 평균 단위 법선을 반환한다.
 	 */
 	DgVec3 getAvgNormal(bool bWgt = false);
 
 	/* !
-	 *	\brief	  θ Ѵ.
+	 *	\brief	경계 정점 여부를 조사한다.
 	 *
-	 *	\return  ̸ true, ƴϸ false ȯѴ.
+	 *	\return 경계 정점이면 true, 아니면 false를 반환한다.
 	 */
 	bool isBndry();
 
@@ -294,110 +296,110 @@ public:
 
 /*!
  *	\class	DgEdge
- *	\brief	ﰢ (Halfedge) ǥϴ Ŭ
+ *	\brief	삼각형의 하프에지(Halfedge)를 표현하는 클래스
  *
- *	\author ȣ, 
+ *	\author 박정호, 윤승현
  *	\date	25 Jan 2018
  */
 class DgEdge
 {
 public:
-	/*! \brief     */
+	/*! \brief 에지 시작점에 연결된 정점 */
 	DgVertex* mVert;
 
-	/*! \brief    ؼ */
+	/*! \brief 에지 시작점에 연결된 텍셀 */
 	DgTexel* mTexel;
 
-	/*! \brief     */
+	/*! \brief 에지 시작점에 연결된 법선 */
 	DgNormal* mNormal;
 
-	/*! \brief  Ե ﰢ   */
+	/*! \brief 에지가 포함된 삼각형에 대한 포인터 */
 	DgFace* mFace;
 
-	/*! \brief ﰢ ϴ     */
+	/*! \brief 삼각형을 구성하는 다음 에지에 대한 포인터 */
 	DgEdge* mNext;
 
-	/*! \brief  ﰢ ݴ    */
+	/*! \brief 인접한 삼각형의 반대편 에지에 대한 포인터 */
 	DgEdge* mMate;
 
-	/*! \brief   Į(, , ġ, , Ư¡  ,  )  : ʱⰪ(0.0), Ư¡ (-1.0), ̻ (-1.0) */
+	/*! \brief 에지와 연관된 스칼라(비용, 길이, 가중치, 길이, 특징 에지 여부, 사용 여부) 등의 정보: 초기값(0.0), 특징 에지(-1.0), 미사용 에지(-1.0) */
 	double mCostOrLen;
 
 public:
 	/*!
-	 *	\brief	
+	 *	\brief	생성자
 	 *
-	 *	\param[in]	pVert	     
-	 *	\param[in]	pTexel	   ؼ  
-	 *	\param[in]	pNormal      
+	 *	\param[in]	pVert	에지의 시작점에 연결할 정점에 대한 포인터
+	 *	\param[in]	pTexel	에지의 시작점에 연결할 텍셀에 대한 포인터
+	 *	\param[in]	pNormal 에지의 시작점에 연결할 법선에 대한 포인터
 	 */
 	DgEdge(DgVertex* pVert, DgTexel* pTexel, DgNormal* pNormal);
 
 	/*!
-	 *	\brief	Ҹ
+	 *	\brief	소멸자
 	 */
 	virtual ~DgEdge();
 
 	/*!
-	 *	\brief	  ȯѴ.
+	 *	\brief	다음 에지를 반환한다.
 	 *
-	 *	\return   ȯѴ.
+	 *	\return 다음 에지를 반환한다.
 	 */
 	DgEdge* next() { return mNext; }
 
 	/*!
-	 *	\brief	  ȯѴ.
+	 *	\brief	이전 에지를 반환한다.
 	 *
-	 *	\return   ȯѴ.
+	 *	\return 이전 에지를 반환한다.
 	 */
 	DgEdge* prev() { return mNext->mNext; }
 
 	/*!
-	 *	\brief	   ȯѴ.
+	 *	\brief	에지의 시작 정점을 반환한다.
 	 *
-	 *	\return    ȯѴ.
+	 *	\return 에지의 시작 정점을 반환한다.
 	 */
 	DgVertex* sv() { return mVert; }
 
 	/*!
-	 *	\brief	   ȯѴ.
+	 *	\brief	에지의 끝 정점을 반환한다.
 	 *
-	 *	\return    ȯѴ.
+	 *	\return 에지의 끝 정점을 반환한다.
 	 */
 	DgVertex* ev() { return mNext->mVert; }
 
 	/*!
-	 *	\brief	  ﰢ Ѵ.
+	 *	\brief	에지를 공유한 삼각형을 구한다.
 	 *
-	 *	\return   ﰢ Ʈ ȯѴ.
+	 *	\return 에지를 공유한 삼각형의 리스트를 반환한다.
 	 */
 	std::vector<DgFace*> getFaces();
 
 	/*!
-	 *	\brief	  θ Ѵ.
+	 *	\brief	경계 에지 여부를 조사한다.
 	 *
-	 *	\return  ̸ true, ƴϸ false ȯѴ.
+	 *	\return 경계 에지이면 true, 아니면 false를 반환한다.
 	 */
 	bool isBndry();
 
 	/*!
-	 *	\brief	ﰢ  ֺ ִ (0 ~ 180) Ѵ.
+	 *	\brief	삼각형에서 에지가 마주보고 있는 각도(0 ~ 180)를 계산한다.
 	 *
-	 *	\param[in]	bRadian	ȯ  ̸ true, ƴϸ false
+	 *	\param[in]	bRadian	반환값이 라디안 이면 true, 아니면 false
 	 *
-	 *	\return ﰢ  ֺ ִ  ȯѴ.
+	 *	\return 삼각형에서 에지가 마주보고 있는 각도를 반환한다.
 	 */
 	double getAngle(bool bRadian);
 };
 
 /*!
  *	\class	DgTexel
- *	\brief	ؽó ǥ ǥϴ Ŭ
+ *	\brief	텍스처 좌표를 표현하는 클래스
  */
 class DgTexel
 {
 public:
-	/*! \brief ؽó ǥ(s, t) */
+	/*! \brief 텍스처 좌표(s, t) */
 	double mST[2];	
 
 public:
@@ -410,16 +412,16 @@ public:
 
 /*!
  *	\class	DgNormal
- *	\brief	 ǥϴ Ŭ
+ *	\brief	법선을 표현하는 클래스
  */
 class DgNormal
 {
 public:
 
-	/*! \brief  ε */
+	/*! \brief 법선의 인덱스 */
 	int mIdx;
 
-	/*! \brief   */
+	/*! \brief 법선의 방향 */
 	double mDir[3];
 
 public:
@@ -440,20 +442,20 @@ public:
 
 /*!
  *	\class	DgFace
- *	\brief	ﰢ ǥϴ Ŭ
+ *	\brief	삼각형을 표현하는 클래스
  */
 class DgFace
 {
 public:
-	int mMtlIdx;		/*! \brief ﰢ ϴ  ε */
-	int mVertIdxs[3];	/*! \brief ﰢ ϴ   ε */
-	int mTexelIdxs[3];	/*! \brief ﰢ   Ҵ ؼ ε */
-	int mNormalIdxs[3];	/*! \brief ﰢ   Ҵ  ε */
+	int mMtlIdx;		/*! \brief 삼각형이 사용하는 재질의 인덱스 */
+	int mVertIdxs[3];	/*! \brief 삼각형을 구성하는 세 정점의 인덱스 */
+	int mTexelIdxs[3];	/*! \brief 삼각형 세 정점에 할당된 텍셀의 인덱스 */
+	int mNormalIdxs[3];	/*! \brief 삼각형 세 정점에 할당된 법선의 인덱스 */
 
-	/*! \brief ﰢ ε */
+	/*! \brief 삼각형의 인덱스 */
 	int mIdx;
 
-	/*! \brief ﰢ     */
+	/*! \brief 삼각형의 시작 에지에 대한 포인터 */
 	DgEdge* mEdge;
 
 public:
@@ -472,84 +474,85 @@ public:
 	~DgFace() {}
 
 	/*!
-	 *	\brief	ﰢ  Ʈ ȯѴ.
+	 *	\brief	삼각형의 에지 리스트를 반환한다.
 	 *
-	 *	\return ﰢ  Ʈ ȯѴ.
+	 *	\return 삼각형의 에지 리스트를 반환한다.
 	 */
 	std::vector<DgEdge*> getEdges() { return { mEdge, mEdge->mNext, mEdge->mNext->mNext }; }
 
 	/*!
-	 *	\brief	ﰢ  ǥ ȯѴ.
+	 *	\brief	삼각형에서 정점의 좌표를 반환한다.
 	 *
-	 *	\param[in]	vidx	ﰢ ϴ  ε(0, 1, 2)
+	 *	\param[in]	vidx	삼각형을 구성하는 정점 인덱스(0, 1, 2)
 	 *
-	 *	\return ε ϴ  ǥ ȯѴ.
+	 *	\return 인덱스에 대응하는 정점의 좌표를 반환한다.
 	 */
 	DgPos getVertexPos(int vidx);
 
 	/*!
-	 *	\brief	ﰢ  ͸ ȯѴ.
+	 *	\brief	삼각형 정점의 포인터를 반환한다.
 	 *
-	 *	\param[in]	vidx	ﰢ ϴ  ε(0, 1, 2)
+	 *	\param[in]	vidx	삼각형을 구성하는 정점의 인덱스(0, 1, 2)
 	 *
-	 *	\return ε Ǵ  ͸ ȯѴ.
+	 *	\return 인덱스에 대응되는 정점의 포인터를 반환한다.
 	 */
 	DgVertex* getVertex(int vIdx);
 
 
 	/*!
-	 *	\brief	ﰢ  ͸ ȯѴ.
+	 *	\brief	삼각형의 에지 포인터를 반환한다.
 	 *
-	 *	\param[in]	eidx	ﰢ ϴ  ε(0, 1, 2)
+	 *	\param[in]	eidx	삼각형을 구성하는 에지의 인덱스(0, 1, 2)
 	 *
-	 *	\return ε Ǵ  ͸ ȯѴ.
+	 *	\return 인덱스에 대응되는 에지의 포인터를 반환한다.
 	 */
 	DgEdge* getEdge(int eidx);
 
 	/*!
-	 *	\brief	ﰢ  Ѵ.
+	 *	\brief	삼각형의 면적을 계산한다.
 	 *
-	 *	\return   ȯѴ.
+	 *	\return 계산된 면적을 반환한다.
 	 */
 	double getArea();
 
 	/*!
-	 *	\brief	ﰢ  ͸ Ѵ.
+	 *	\brief	삼각형의 단위 법선벡터를 계산한다.
 	 *
-	 *	\param[in]	bLocal	ü 𵨸 ǥ迡 ǥ   true,  ǥ迡 ǥ  false
+	 *	\param[in]	bLocal	객체의 모델링 좌표계에서 표현된 법선일 경우 true, 월드 좌표계에서 표현될 경우 false
 	 *
-	 *	\return ﰢ  ͸ ȯѴ.
+	 *	\return 삼각형의 단위 법선벡터를 반환한다.
 	 */
 	DgVec3 getFaceNormal(bool bLocal);
 
 	/*!
-	 *	\brief	ﰢ  ﰢ Ѵ.
+	 *	\brief	삼각형이 경계 삼각형인지 조사한다.
 	 *
-	 *	\return	 ﰢ̸ true, ƴϸ false ȯѴ.
+	 *	\return	경계 삼각형이면 true, 아니면 false를 반환한다.
 	 */
 	bool isBndryFace();
 
 	/*!
-	*	\brief	ﰢ Ե ޽ ͸ ȯѴ.
+	*	\brief	삼각형이 포함된 메쉬의 포인터를 반환한다.
 	*
-	*	\return ﰢ Ե ޽ ͸ ȯѴ.
+	*	\return 삼각형이 포함된 메쉬의 포인터를 반환한다.
 	*/
 	virtual	DgMesh* getMesh();
 };
 
 /*!
  *	\class	DgMaterial
- *	\brief	޽  ǥϴ Ŭ
+ *	\brief	메쉬 재질을 표현하는 클래스
  */
 class DgMaterial
 {
 public:
-	std::string mName;	/*! \brief  ̸ */
-	float mKa[3];		/*! \brief ֺ ݻ  */
-	float mKd[3];		/*! \brief ݻ籤 ݻ  */
-	float mKs[3];		/*! \brief ݻ籤 ݻ  */
-	float mNs;			/*! \brief ݻ  */
-	GLuint mTexId;		/*! \brief  ؽó ̵(1 ) */
+	std::string mName;	/*! \brief 재질의 이름 */
+	float mKa[3];		/*! \brief 주변광 반사 계수 */
+	float mKd[3];		/*! \brief 난반사광 반사 계수 */
+	float mKs[3];		/*! \brief 전반사광 반사 계수 */
+	float mNs;			/*! \brief 전반사 지수 */
+	GLuint mTexId;		/*! \brief 재질의 텍스처 아이디(1부터 시작) */
+	std::string mTexFile;	/*! \brief 텍스처 파일의 경로(메쉬 캐시에서 텍스처를 다시 읽을 때 사용) */
 
 public:
 	DgMaterial() {
@@ -564,26 +567,47 @@ public:
 
 /*!
  *	\class	DgMesh
- *	\brief	ﰢ  ޽  ǥϴ Ŭ
+ *	\brief	삼각형으로 구성된 메쉬 모델을 표현하는 클래스
  */
 class DgMesh
 {
 public:
-	std::string mName;					/*! \brief ޽ ̸ */
-	std::vector<DgVertex> mVerts;		/*! \brief ޽ ϴ  迭 */
-	std::vector<DgTexel> mTexels;		/*! \brief ޽ ϴ ؼ 迭 */
-	std::vector<DgNormal> mNormals;		/*! \brief ޽ ϴ  迭 */
-	std::vector<DgFace> mFaces;			/*! \brief ޽ ϴ ﰢ 迭 */
-	std::vector<DgMaterial> mMaterials;	/*! \brief ޽ ϴ  迭 */
-
-	std::vector<std::vector<unsigned int>> mVertexIndicesPerMtl;	/*!  ﰢ  ε ׷ */
-	GLuint mShaderId;												/*! \brief ޽ ϴ ̴ ̵ */
+	std::string mName;					/*! \brief 메쉬 이름 */
+	std::string mFilePath;				/*! \brief 메쉬를 임포트한 파일 경로(캐시 파일 위치의 기준, 직접 생성한 메쉬는 빈 문자열) */
+	std::vector<DgVertex> mVerts;		/*! \brief 메쉬를 구성하는 정점 배열 */
+	std::vector<DgTexel> mTexels;		/*! \brief 메쉬를 구성하는 텍셀 배열 */
+	std::vector<DgNormal> mNormals;		/*! \brief 메쉬를 구성하는 법선 배열 */
+	std::vector<DgFace> mFaces;			/*! \brief 메쉬를 구성하는 삼각형 배열 */
+	std::vector<DgMaterial> mMaterials;	/*! \brief 메쉬가 사용하는 재질 배열 */
+
+	std::vector<std::vector<unsigned int>> mVertexIndicesPerMtl;	/*! 재질별 삼각형 정점 인덱스 그룹 */
+	std::vector<std::pair<GLsizei, GLsizei>> mMtlRanges;			/*! \brief mEBO 안의 재질별 (시작 인덱스, 인덱스 개수) */
+	GLuint mShaderId;												/*! \brief 메쉬가 사용하는 쉐이더 아이디 */
 	GLuint mVAO;
 	GLuint mVBO;
 	GLuint mEBO;	
 	bool mBuffersInitialized;
 
-	/*! \brief ޽  ǥ */
+	/*! \brief 메쉬가 변경되어 다음 render에서 버퍼를 다시 업로드해야 하는지 여부 */
+	bool mBuffersDirty = false;
+
+	/*! \brief 인스턴스별 모델링 변환(비어 있으면 단위 행렬 인스턴스 하나로 그림) */
+	std::vector<glm::mat4> mInstMats;
+
+	/*! \brief 인스턴스 변환 버퍼(모델링 변환은 정점 속성 3~6, 법선 변환은 7~9, 인스턴스마다 한 번씩 진행) */
+	GLuint mInstVBO = 0;
+
+	/*! \brief 인스턴스 변환이 변경되어 다시 업로드해야 하는지 여부 */
+	bool mInstDirty = true;
+
+	/*! \brief 메쉬 캐시 파일의 매핑(첫 setupBuffers에서 정점 스트림을 바로 업로드한 후 해제) */
+	std::shared_ptr<DgMappedFile> mCacheFile;
+
+	/*! \brief 매핑된 캐시 파일 안의 인터리브 정점 스트림과 실수 개수 */
+	const float* mCacheStream = nullptr;
+	size_t mCacheStreamSize = 0;
+
+	/*! \brief 메쉬 로컬 좌표계 */
 	EgTransf mMC;
 
 public:
@@ -598,16 +622,70 @@ public:
 		if (mVAO) glDeleteVertexArrays(1, &mVAO);
 		if (mVBO) glDeleteBuffers(1, &mVBO);
 		if (mEBO) glDeleteBuffers(1, &mEBO);
+		if (mInstVBO) glDeleteBuffers(1, &mInstVBO);
 	};
 
 	void setupBuffers();
+
+	/*!
+	 *	\brief	GPU에 업로드할 인터리브 정점 스트림과 재질별 인덱스(mVertexIndicesPerMtl)를 구성한다.
+	 *	\note	재질이 없거나 범위 밖인 삼각형은 기본 재질을 추가하여 할당한다.
+	 *
+	 *	\param[out]	vertexData	정점별 (위치, 법선[, 텍셀]) 실수 배열
+	 */
+	void buildVertexStream(std::vector<float>& vertexData);
+
 	void computeNormal(int normalType);
 	void render();
 
-	/*! \brief ޽   ּ(mBndBox[0]) ִ(mBndBox[1]) */
+	/*!
+	 *	\brief	GPU 버퍼가 없거나 변경되었으면 다시 업로드한다.
+	 */
+	void updateBuffers();
+
+	/*!
+	 *	\brief	같은 기하 정보를 공유하는 인스턴스를 추가한다.
+	 *
+	 *	\param[in]	mat	인스턴스의 모델링 변환
+	 *
+	 *	\return 추가된 인스턴스의 인덱스를 반환한다.
+	 */
+	int addInstance(const glm::mat4& mat);
+
+	/*!
+	 *	\brief	그려질 인스턴스의 개수를 반환한다(인스턴스가 없으면 1).
+	 */
+	int getNumInstances() const { return mInstMats.empty() ? 1 : (int)mInstMats.size(); }
+
+	/*!
+	 *	\brief	텍스처를 사용하는 재질이 있는지 조사한다.
+	 */
+	bool hasTexture() const;
+
+	/*!
+	 *	\brief	재질의 유니폼(계수와 텍스처 유닛)을 현재 쉐이더 프로그램에 설정한다.
+	 *
+	 *	\param[in]	shader	현재 사용 중인 쉐이더
+	 *	\param[in]	mtlIdx	재질 인덱스
+	 */
+	void setMaterial(const DgShader& shader, int mtlIdx);
+
+	/*!
+	 *	\brief	재질에 속한 삼각형을 모든 인스턴스에 대하여 한 번의 호출로 그린다(mVAO가 바인딩되어 있어야 함).
+	 *
+	 *	\param[in]	mtlIdx	재질 인덱스
+	 */
+	void drawMaterial(int mtlIdx);
+
+	/*!
+	 *	\brief	메쉬의 정점, 삼각형 또는 재질을 변경한 후 호출하여 다음 render에서 GPU 버퍼를 다시 업로드한다.
+	 */
+	void invalidateBuffers() { mBuffersDirty = true; }
+
+	/*! \brief 메쉬의 경계 상자의 최소점(mBndBox[0])과 최대점(mBndBox[1]) */
 	DgPos mBndBox[2];
 
-	/*! \brief ޽  Ÿ: NORMAL_FACE Ǵ NORMAL_VERTEX */
+	/*! \brief 메쉬의 법선 타입: NORMAL_FACE 또는 NORMAL_VERTEX */
 	enum TypeNormal {
 		NORMAL_ASIS = 0,
 		NORMAL_FACE = 1,
@@ -616,473 +694,587 @@ public:
 
 	TypeNormal mNormalType;
 
-	/*! \brief     : (,  ǥ 迭)  */
+	/*! \brief 고속 렌더링을 위한 법선 버퍼: (재질명, 법선의 좌표 배열)로 구성됨 */
 	std::map<std::string, std::vector<float>> mNormalBuffer;
 
 	/*!
-	 *	\brief	޽ ﰢ ߰Ѵ.
+	 *	\brief	메쉬에 삼각형을 추가한다.
 	 *
-	 *	\param[in]	pFace	߰ ﰢ  
+	 *	\param[in]	pFace	추가할 삼각형에 대한 포인터
 	 */
 	void addFace(DgFace* pFace);
 
 	/*!
-	 *	\brief	޽  ߰Ѵ.
+	 *	\brief	메쉬에 정점을 추가한다.
 	 *
-	 *	\param[in]	pVert	߰   
+	 *	\param[in]	pVert	추가할 정점에 대한 포인터
 	 */
 	void addVertex(DgVertex* pVert);
 
 	/*!
-	 *	\brief	 ݴ   Ѵ.
+	 *	\brief	에지의 반대편 에지 정보를 갱신한다.
 	 *
-	 *	\param[in]	pVert	 
-	 *	\param[in]	date	 ˰ ¥
+	 *	\param[in]	pVert	정점의 포인터
+	 *	\param[in]	date	선택할 알고리즘의 날짜
 	 */
 	void updateEdgeMate(DgVertex* pVert = NULL);
 
 	/*!
-	 *	\brief	  Ʈ  ϰ, ο mNormals Ѵ.
-	 *	\note	 : 2021-04-16
+	 *	\brief	기존의 법선 리스트를 무조건 제거하고, 새로운 mNormals을 구성한다.
+	 *	\note	마지막 수정일: 2021-04-16
 	 *
-	 *	\param[in]	normalType	 (NORMAL_ASIS: , NORMAL_FACE: ﰢ , NORMAL_VERTEX:  )
+	 *	\param[in]	normalType	법선의 형태(NORMAL_ASIS: 기존, NORMAL_FACE: 삼각형 법선, NORMAL_VERTEX: 정점 법선)
 	 */
 	void updateNormal(TypeNormal normalType);
 
 	/*!
-	 *	\brief	޽ ѷδ  ڸ Ѵ.
+	 *	\brief	메쉬를 둘러싸는 경계 상자를 갱신한다.
 	 */
 	void updateBndBox();
 
 	/*!
-	 *	\brief	޽   ȯѴ.
+	 *	\brief	메쉬의 정점의 개수를 반환한다.
 	 *
-	 *	\return ޽   ȯѴ.
+	 *	\return 메쉬의 정점의 개수를 반환한다.
 	 */
 	int getNumVerts();
 
 };
 
 /*!
- *	\brief	OBJ  ƮϿ ޽  Ѵ.
+ *	\class	DgMappedFile
+ *	\brief	파일 전체를 읽기 전용으로 메모리에 매핑하는 클래스
+ */
+class DgMappedFile
+{
+public:
+	/*! \brief 매핑된 파일 데이터의 시작 주소(매핑되지 않았다면 nullptr) */
+	const char* mData = nullptr;
+
+	/*! \brief 매핑된 파일의 크기(byte) */
+	size_t mSize = 0;
+
+public:
+	DgMappedFile() {}
+	DgMappedFile(const DgMappedFile&) = delete;
+	DgMappedFile& operator =(const DgMappedFile&) = delete;
+	~DgMappedFile() { close(); }
+
+	/*!
+	 *	\brief	파일을 읽기 전용으로 매핑한다.
+	 *
+	 *	\param[in]	fname	파일 이름
+	 *
+	 *	\return 매핑에 성공하면 true, 파일이 없거나 비어 있으면 false를 반환한다.
+	 */
+	bool open(const char* fname);
+
+	/*!
+	 *	\brief	매핑을 해제한다.
+	 */
+	void close();
+
+private:
+	/*! \brief 운영체제의 파일 핸들과 매핑 핸들 */
+	void* mFile = nullptr;
+	void* mMapping = nullptr;
+};
+
+/*!
+ *	\class	DgShader
+ *	\brief	쉐이더 프로그램과 링크 시점에 구한 유니폼 위치를 저장하는 클래스
+ *	\note	카메라와 조명 유니폼은 CameraBlock(CAMERA_UBO_BINDING), SDF 볼륨 테이블은 SDFVolumeBlock(SDF_UBO_BINDING) 유니폼 버퍼로 전달된다.
+ */
+class DgShader
+{
+public:
+	/*! \brief 위치를 미리 구해 두는 유니폼 */
+	enum TypeUniform {
+		UNIFORM_MODEL = 0,
+		UNIFORM_KA,
+		UNIFORM_KD,
+		UNIFORM_KS,
+		UNIFORM_NS,
+		UNIFORM_TEX,
+		UNIFORM_SDF_ATLAS,
+		UNIFORM_MACRO_ATLAS,
+		UNIFORM_MACRO_SIZE,
+		UNIFORM_TILE_MASK,
+		UNIFORM_TILE_SIZE,
+		UNIFORM_SDF_MAX_LOD,
+		UNIFORM_DEBUG_STEPS,
+		NUM_UNIFORMS,
+	};
+
+	/*! \brief 쉐이더 프로그램 아이디 */
+	GLuint mId = 0;
+
+	/*! \brief 유니폼별 위치(-1: 프로그램에서 사용하지 않는 유니폼) */
+	GLint mLocs[NUM_UNIFORMS];
+
+public:
+	/*!
+	 *	\brief	생성자: 유니폼 위치를 구하고 유니폼 블록을 바인딩 지점에 연결한다.
+	 *
+	 *	\param[in]	id	링크된 쉐이더 프로그램 아이디
+	 */
+	DgShader(GLuint id = 0);
+
+	/*!
+	 *	\brief	유니폼의 위치를 반환한다.
+	 */
+	GLint getLoc(TypeUniform u) const { return mLocs[u]; }
+
+	/*!
+	 *	\brief	프로그램 아이디에 해당하는 쉐이더 정보를 반환한다(처음 요청될 때 한 번만 위치를 구함).
+	 *
+	 *	\param[in]	id	쉐이더 프로그램 아이디
+	 */
+	static const DgShader& get(GLuint id);
+};
+
+/*!
+ *	\brief	OBJ 파일을 임포트하여 메쉬 모델을 구성한다.
  * 
- *	\param[in]	fname	 ̸
+ *	\param[in]	fname	파일 이름
  */
 DgMesh* import_mesh_obj(const char* fname);
 
 /*!
- *	\brief	̴ α׷ Ѵ.
+ *	\brief	메쉬를 메모리 매핑 가능한 이진 캐시 파일로 저장한다.
+ *	\note	정점, 텍셀, 법선, 삼각형, 재질과 함께 setupBuffers가 업로드할 정점 스트림을 64바이트 경계에 저장한다.
+ *
+ *	\param[in]	pMesh	저장할 메쉬
+ *	\param[in]	fname	캐시 파일 이름
+ *	\param[in]	srcFile	원본 파일 이름(크기와 수정 시각을 기록하여 캐시의 유효성 확인에 사용)
+ *
+ *	\return 저장에 성공하면 true를 반환한다.
+ */
+bool save_mesh_cache(DgMesh* pMesh, const char* fname, const char* srcFile);
+
+/*!
+ *	\brief	이진 캐시 파일을 매핑하여 메쉬를 생성한다.
+ *
+ *	\param[in]	fname	캐시 파일 이름
+ *	\param[in]	srcFile	원본 파일 이름
+ *
+ *	\return 캐시가 없거나 원본보다 오래되었거나 형식이 다르면 nullptr를 반환한다.
+ */
+DgMesh* load_mesh_cache(const char* fname, const char* srcFile);
+
+/*!
+ *	\brief	쉐이더 프로그램을 생성한다.
  *
- *	\param[in]	vertexPath		 ̴  
- *	\param[in]	fragmentPath	׸Ʈ ̴  
+ *	\param[in]	vertexPath		정점 쉐이더 파일의 경로
+ *	\param[in]	fragmentPath	프래그먼트 쉐이더 파일의 경로
  * 
- *	\return	 α׷ ڵ ȯѴ.
+ *	\return	생성된 프로그램의 핸들을 반환한다.
  */
 GLuint load_shaders(const char* vertexPath, const char* fragmentPath);
 
 /*!
- * \brief  \a p  \a q \a t : (1 - t) Ѵ.
+ * \brief 점 \a p와 점 \a q를 \a t : (1 - t)로 내분한다.
  *
- * \param[in] p 3  
- * \param[in] q 3  
- * \param[in] t  
+ * \param[in] p 3차원 공간의 점
+ * \param[in] q 3차원 공간의 점
+ * \param[in] t 내분 비율
  *
- * \return  \a p \a q  ȯѴ.
+ * \return 점 \a p와 \a q의 내분점을 반환한다.
  */
 DgPos lerp(const DgPos& p, const DgPos& q, double t);
 
 
 /*********************/
-/*   DgVec3 Ŭ   */
+/*   DgVec3 클래스   */
 /*********************/
 
 /*!
  * \class   DgVec3
- * \brief   3 ͸ ǥϴ Ŭ
+ * \brief   3차원 벡터를 표현하는 클래스
  *
- * \author  (shyun@dongguk.edu)
+ * \author  윤승현(shyun@dongguk.edu)
  * \date    01 Jan 2001
  */
 class DgVec3
 {
 public:
-	/*! \brief 3  ǥ 迭 */
+	/*! \brief 3차원 벡터의 좌표 배열 */
 	double mPos[3];
 
 public:
 	/*!
-	 * \brief  
+	 * \brief  생성자
 	 *
-	 * \param[in] x   x ǥ
-	 * \param[in] y   y ǥ
-	 * \param[in] z   z ǥ
+	 * \param[in] x  벡터의 x 좌표
+	 * \param[in] y  벡터의 y 좌표
+	 * \param[in] z  벡터의 z 좌표
 	 */
 	DgVec3(double x = 0.0, double y = 0.0, double z = 0.0);
 
 	/*!
-	 * \brief  ̴ϼȶ Ʈ  
+	 * \brief  이니셜라이저 리스트를 사용한 생성자
 	 *
-	 * \param[in] coords	߰ȣ ǥ  ǥ {x, y, z}
+	 * \param[in] coords	중괄호로 표현된 벡터의 좌표 {x, y, z}
 	 */
 	DgVec3(std::initializer_list<double> coords);
 
 	/*!
-	 * \brief   
+	 * \brief  복사 생성자
 	 *
-	 * \param[in] cpy   ü
+	 * \param[in] cpy  복사될 객체
 	 */
 	DgVec3(const DgVec3& cpy);
 
 	/*!
-	 * \brief  Ҹ
+	 * \brief  소멸자
 	 */
 	~DgVec3();
 
 	/*!
-	 * \brief   ǥ Ѵ.
+	 * \brief  벡터의 좌표를 설정한다.
 	 *
-	 * \param[in] x   x ǥ
-	 * \param[in] y   y ǥ
-	 * \param[in] z   z ǥ
+	 * \param[in] x  설정할 x 좌표
+	 * \param[in] y  설정할 y 좌표
+	 * \param[in] z  설정할 z 좌표
 	 *
-	 * \return  ڽ ȯѴ.
+	 * \return 설정된 자신을 반환한다.
 	 */
 	DgVec3& setCoords(double x, double y, double z);
 
 	/*!
-	 * \brief   θ Ѵ.
+	 * \brief  영벡터 여부를 조사한다.
 	 *
-	 * \param[in] eps   
+	 * \param[in] eps  허용 오차
 	 *
-	 * \return ̸ true, ƴϸ false ȯѴ.
+	 * \return 영벡터이면 true, 아니면 false를 반환한다.
 	 */
 	bool isZero(double eps = 1e-9) const;
 
 	/*!
-	 * \brief  ͸ ̷ ȭѴ.
+	 * \brief  벡터를 단위길이로 정규화한다.
 	 *
-	 * \param[in] eps   Ǵ   
+	 * \param[in] eps  영벡터 판단을 위한 허용 오차
 	 *
-	 * \return ȭ ڽ ȯѴ.
+	 * \return 정규화된 자신을 반환한다.
 	 */
 	DgVec3& normalize(double eps = 1e-9);
 
 	/*!
-	 * \brief   
+	 * \brief  대입 연산자
 	 *
-	 * \param[in] rhs  Ե ü
+	 * \param[in] rhs  대입될 객체
 	 *
-	 * \return Ե ڽ ȯѴ.
+	 * \return 대입된 자신을 반환한다.
 	 */
 	DgVec3& operator =(const DgVec3& rhs);
 
 	/*!
-	 * \brief  ͸ Ѵ.
+	 * \brief  벡터를 더한다.
 	 *
-	 * \param[in] rhs   
+	 * \param[in] rhs  더할 벡터
 	 *
-	 * \return  ڽ ȯѴ.
+	 * \return 변경된 자신을 반환한다.
 	 */
 	DgVec3& operator +=(const DgVec3& rhs);
 
 	/*!
-	 * \brief  ͸ .
+	 * \brief  벡터를 뺀다.
 	 *
-	 * \param[in] rhs   
+	 * \param[in] rhs  뺄 벡터
 	 *
-	 * \return  ڽ ȯѴ.
+	 * \return 변경된 자신을 반환한다.
 	 */
 	DgVec3& operator -=(const DgVec3& rhs);
 
 	/*!
-	 * \brief  ͸  Ѵ.
+	 * \brief  벡터를 상수배 한다.
 	 *
-	 * \param[in] s  
+	 * \param[in] s  상수
 	 *
-	 * \return  ڽ ȯѴ.
+	 * \return 변경된 자신을 반환한다.
 	 */
 	DgVec3& operator *=(const double& s);
 
 	/*!
-	 * \brief  ͸  .
+	 * \brief  벡터를 상수로 나눈다.
 	 *
-	 * \param[in] s   
+	 * \param[in] s  나눌 상수
 	 *
-	 * \return  ڽ ȯѴ.
+	 * \return 변경된 자신을 반환한다.
 	 */
 	DgVec3& operator /=(const double& s);
 
 	/*!
-	 * \brief  ͸ Ѵ.
+	 * \brief  벡터를 외적한다.
 	 *
-	 * \param[in] rhs   
+	 * \param[in] rhs  외적할 벡터
 	 *
-	 * \return  ڽ ȯѴ.
+	 * \return 변경된 자신을 반환한다.
 	 */
 	DgVec3& operator ^=(const DgVec3& rhs);
 
 	/*!
-	 * \brief   (+)
+	 * \brief  단항 연산자(+)
 	 *
-	 * \return Ϻȣ  ü ȯѴ.
+	 * \return 동일부호를 갖는 객체를 반환한다.
 	 */
 	DgVec3 operator +() const;
 
 	/*!
-	 * \brief   (-)
+	 * \brief  단항 연산자(-)
 	 *
-	 * \return ݴȣ  ü ȯѴ.
+	 * \return 반대부호를 갖는 객체를 반환한다.
 	 */
 	DgVec3 operator -() const;
 
 	/*!
-	 * \brief  ε ([])
+	 * \brief  인덱스 연산자([])
 	 *
-	 * \param[in] idx   ε
+	 * \param[in] idx  참조 인덱스
 	 *
-	 * \return  idx°  ۷ ȯѴ.
+	 * \return 벡터의 idx번째 원소의 레퍼런스를 반환한다.
 	 */
 	double& operator [](const int& idx);
 
 	/*!
-	 * \brief  ü  ε ([])
+	 * \brief  상수객체에 대한 인덱스 연산자([])
 	 *
-	 * \param[in] idx  ε
+	 * \param[in] idx  인덱스
 	 *
-	 * \return  idx°  ۷ ȯѴ.
+	 * \return 벡터의 idx번째 원소의 레퍼런스를 반환한다.
 	 */
 	const double& operator [](const int& idx) const;
 
 	/*!
-	 * \brief   ͸ Ѵ.
+	 * \brief  두 벡터를 더한다.
 	 *
-	 * \param[in] v  ù ° 
-	 * \param[in] w   ° 
+	 * \param[in] v  첫 번째 벡터
+	 * \param[in] w  두 번째 벡터
 	 *
-	 * \return    ȯѴ.
+	 * \return 두 벡터의 합을 반환한다.
 	 */
 	friend DgVec3 operator +(const DgVec3& v, const DgVec3& w);
 
 	/*!
-	 * \brief   ͸ .
+	 * \brief  두 벡터를 뺀다.
 	 *
-	 * \param[in] v  ù ° 
-	 * \param[in] w   ° 
+	 * \param[in] v  첫 번째 벡터
+	 * \param[in] w  두 번째 벡터
 	 *
-	 * \return    ȯѴ.
+	 * \return 두 벡터의 차를 반환한다.
 	 */
 	friend DgVec3 operator -(const DgVec3& v, const DgVec3& w);
 
 	/*!
-	 * \brief  ͸  Ѵ.
+	 * \brief  벡터를 상수배 한다.
 	 *
-	 * \param[in] v  
-	 * \param[in] s  
+	 * \param[in] v  벡터
+	 * \param[in] s  상수
 	 *
-	 * \return  踦 ȯѴ.
+	 * \return 벡터의 상수배를 반환한다.
 	 */
 	friend DgVec3 operator *(const DgVec3& v, const double& s);
 
 	/*!
-	 * \brief  ͸  Ѵ.
+	 * \brief  벡터를 상수배 한다.
 	 *
-	 * \param[in] s  
-	 * \param[in] v  
+	 * \param[in] s  상수
+	 * \param[in] v  벡터
 	 *
-	 * \return  踦 ȯѴ.
+	 * \return 벡터의 상수배를 반환한다.
 	 */
 	friend DgVec3 operator *(const double& s, const DgVec3& v);
 
 	/*!
-	 * \brief     Ѵ.
+	 * \brief  두 벡터의 내적을 구한다.
 	 *
-	 * \param[in] v  ù ° 
-	 * \param[in] w   ° 
+	 * \param[in] v  첫 번째 벡터
+	 * \param[in] w  두 번째 벡터
 	 *
-	 * \return     ȯѴ.
+	 * \return 두 벡터의 내적 결과를 반환한다.
 	 */
 	friend double operator *(const DgVec3& v, const DgVec3& w);
 
 	/*!
-	 * \brief   ͸ Ѵ.
+	 * \brief  역수 벡터를 구한다.
 	 *
-	 * \param[in] s  
-	 * \param[in] v  
+	 * \param[in] s  상수
+	 * \param[in] v  벡터
 	 *
-	 * \return   (s/x, s/y, s/z) ȯѴ.
+	 * \return 역수 벡터 (s/x, s/y, s/z)를 반환한다.
 	 */
 	friend DgVec3 operator /(const double& s, const DgVec3& v);
 
 	/*!
-	 * \brief  ͸  .
+	 * \brief  벡터를 상수로 나눈다.
 	 *
-	 * \param[in] v  
-	 * \param[in] s  
+	 * \param[in] v  벡터
+	 * \param[in] s  상수
 	 *
-	 * \return   ͸ ȯѴ.
+	 * \return 상수로 나누어진 벡터를 반환한다.
 	 */
 	friend DgVec3 operator /(const DgVec3& v, const double& s);
 
 	/*!
-	 * \brief     ͸ Ѵ.
+	 * \brief  두 벡터의 외적 벡터를 구한다.
 	 *
-	 * \param[in] v  ù ° 
-	 * \param[in] w   ° 
+	 * \param[in] v  첫 번째 벡터
+	 * \param[in] w  두 번째 벡터
 	 *
-	 * \return   (v X w) ȯѴ.
+	 * \return 외적 벡터 (v X w)를 반환한다.
 	 */
 	friend DgVec3 operator ^(const DgVec3& v, const DgVec3& w);
 
 	/*!
-	 * \brief   Ͱ  Ѵ.
+	 * \brief  두 벡터가 같은지 조사한다.
 	 *
-	 * \param[in] v  ù ° 
-	 * \param[in] w   ° 
+	 * \param[in] v  첫 번째 벡터
+	 * \param[in] w  두 번째 벡터
 	 *
-	 * \return  Ͱ  true, ٸ false ȯѴ.
+	 * \return 두 벡터가 같으면 true, 다르면 false를 반환한다.
 	 */
 	friend bool operator ==(const DgVec3& v, const DgVec3& w);
 
 	/*!
-	 * \brief   Ͱ ٸ Ѵ.
+	 * \brief  두 벡터가 다른지 조사한다.
 	 *
-	 * \param[in] v  ù ° 
-	 * \param[in] w   ° 
+	 * \param[in] v  첫 번째 벡터
+	 * \param[in] w  두 번째 벡터
 	 *
-	 * \return  Ͱ ٸ true,  false ȯѴ.
+	 * \return 두 벡터가 다르면 true, 같으면 false를 반환한다.
 	 */
 	friend bool operator !=(const DgVec3& v, const DgVec3& w);
 
 	/*!
-	 * \brief   (<<)
+	 * \brief  출력 연산자(<<)
 	 *
-	 * \param[out] os   Ʈ
-	 * \param[in]  v    
+	 * \param[out] os  출력 스트림
+	 * \param[in]  v   출력할 벡터
 	 *
-	 * \return Ͱ µ Ʈ ȯѴ.
+	 * \return 벡터가 출력된 스트림을 반환한다.
 	 */
 	friend std::ostream& operator <<(std::ostream& os, const DgVec3& v);
 
 	/*!
-	 * \brief  Է (>>)
+	 * \brief  입력 연산자(>>)
 	 *
-	 * \param[in]  is  Է½Ʈ
-	 * \param[out] v   Է°  
+	 * \param[in]  is  입력스트림
+	 * \param[out] v   입력값이 저장될 벡터
 	 *
-	 * \return Է° ŵ Է½Ʈ ȯѴ.
+	 * \return 입력값이 제거된 입력스트림을 반환한다.
 	 */
 	friend std::istream& operator >>(std::istream& is, DgVec3& v);
 };
 
 /***********************/
-/*   DgVec3 ƿ Լ  */
+/*   DgVec3 유틸 함수  */
 /***********************/
 
 /*!
- * \brief    u  v   ͸ Ѵ.
+ * \brief   벡터 u를 벡터 v에 직교 투영한 벡터를 구한다.
  *
- * \param[in] u   
- * \param[in] v   
+ * \param[in] u  대상 벡터
+ * \param[in] v  참조 벡터
  *
- * \return   u  v 翵Ų ͸ ȯѴ.
+ * \return  벡터 u를 벡터 v에 사영시킨 벡터를 반환한다.
  */
 DgVec3 proj(const DgVec3& u, const DgVec3& v);
 
 /*!
- * \brief    v   ͸ Ѵ.
+ * \brief   벡터 v에 수직한 단위 벡터를 구한다.
  *
- * \param[in] v   
+ * \param[in] v  대상 벡터
  *
- * \return   v   ͸ Ͽ ȯѴ.
+ * \return  벡터 v에 수직한 단위 벡터를 구하여 반환한다.
  */
 DgVec3 ortho(const DgVec3& v);
 
 /*!
- * \brief    u, v, w Ľ Ѵ.
+ * \brief   벡터 u, v, w의 행렬식을 계산한다.
  *
- * \param[in] u  
- * \param[in] v  
- * \param[in] w  
+ * \param[in] u  벡터
+ * \param[in] v  벡터
+ * \param[in] w  벡터
  *
- * \return   u, v, w Ľ  ȯѴ.
+ * \return  벡터 u, v, w의 행렬식의 값을 반환한다.
  */
 double det(const DgVec3& u, const DgVec3& v, const DgVec3& w);
 
 /*!
- * \brief    v ũ⸦ Ѵ.
+ * \brief   벡터 v의 크기를 구한다.
  *
- * \param[in] v   
+ * \param[in] v  대상 벡터
  *
- * \return   \a v ũ⸦ ȯѴ.
+ * \return  벡터 \a v의 크기를 반환한다.
  */
 double norm(const DgVec3& v);
 
 /*!
- * \brief    v ũ  Ѵ.
+ * \brief   벡터 v의 크기의 제곱을 계산한다.
  *
- * \param[in] v   
+ * \param[in] v  대상 벡터
  *
- * \return   \a v ũ  ȯѴ.
+ * \return  벡터 \a v의 크기의 제곱을 반환한다.
  */
 double norm_sq(const DgVec3& v);
 
 /*!
- * \brief      ̰(0 ~ 180) Ѵ.
+ * \brief   두 벡터 사이의 사이각(0 ~ 180)을 구한다.
  *
- * \param[in] u        
- * \param[in] v        
- * \param[in] radian   (true: radian, false: degree)
+ * \param[in] u       시작 벡터
+ * \param[in] v       끝 벡터
+ * \param[in] radian  각도의 형태(true: radian, false: degree)
  *
- * \return   \a u  \a v ̰(,  )
+ * \return  벡터 \a u에서 벡터 \a v까지의 사이각(예각, 방향 상관없음)
  */
 double angle(const DgVec3& u, const DgVec3& v, bool radian = false);
 
 /*!
- * \brief      ̰(0 ~ 360) Ѵ.
+ * \brief   두 벡터 사이의 사이각(0 ~ 360)을 구한다.
  *
- * \param[in] u        
- * \param[in] v        
- * \param[in] axis    ȸ 
- * \param[in] radian   (true: radian, false: degree)
+ * \param[in] u       시작 벡터
+ * \param[in] v       끝 벡터
+ * \param[in] axis    회전축 벡터
+ * \param[in] radian  각도의 형태(true: radian, false: degree)
  *
- * \return   \a u  \a v ̰(axis   ݽð )
+ * \return  벡터 \a u에서 벡터 \a v까지의 사이각(axis 벡터 기준 반시계 방향)
  */
 double angle(const DgVec3& u, const DgVec3& v, const DgVec3& axis, bool radian = false);
 
 
 /**********************/
-/*     Ȯ Լ  */
+/*    교차 확인 함수  */
 /**********************/
 
 /*!
- * \brief   ﰢ    θ ˻Ѵ.
- * \note    : Real-time rendering
+ * \brief   삼각형과 경계 상자의 교차 여부를 검사한다.
+ * \note    참고문헌: Real-time rendering
  *
- * \param[in]  u0       ﰢ ù ° .
- * \param[in]  u1       ﰢ  ° .
- * \param[in]  u2       ﰢ  ° .
- * \param[in]  box_min    ּ.
- * \param[in]  box_max    ִ.
+ * \param[in]  u0       삼각형의 첫 번째 정점.
+ * \param[in]  u1       삼각형의 두 번째 정점.
+ * \param[in]  u2       삼각형의 세 번째 정점.
+ * \param[in]  box_min  경계 상자의 최소점.
+ * \param[in]  box_max  경계 상자의 최대점.
  *
- * \return true:  , false:  ʴ .
+ * \return true: 교차 성공, false: 교차하지 않는 경우.
  */
 bool intersect_tri_box(DgPos u0, DgPos u1, DgPos u2, DgPos box_min, DgPos box_max);
 
 /*!
- *	\brief   3  ﰢ ﰢ  ο  (, ) Ѵ.
- *	\note    : Real-time rendering (ERIT )
+ *	\brief   3차원 공간에서 삼각형과 삼각형의 교차 여부와 교차 선분(시작점, 끝점)을 계산한다.
+ *	\note    참고문헌: Real-time rendering (ERIT 방법)
  *
- *	\param[in]	a0		ﰢ A ù ° 
- *	\param[in]	a1		ﰢ A  ° 
- *	\param[in]	a2		ﰢ A  ° 
- *	\param[in]	b0		ﰢ B ù ° 
- *	\param[in]	b1		ﰢ B  ° 
- *	\param[in]	b2		ﰢ B  ° 
- *	\param[out]	p		  ù °  
- *	\param[out]	q		   °  
- *	\param[in]	eps		 
+ *	\param[in]	a0		삼각형 A의 첫 번째 정점
+ *	\param[in]	a1		삼각형 A의 두 번째 정점
+ *	\param[in]	a2		삼각형 A의 세 번째 정점
+ *	\param[in]	b0		삼각형 B의 첫 번째 정점
+ *	\param[in]	b1		삼각형 B의 두 번째 정점
+ *	\param[in]	b2		삼각형 B의 세 번째 정점
+ *	\param[out]	p		교차 선분의 첫 번째 점이 저장됨
+ *	\param[out]	q		교차 선분의 두 번째 점이 저장됨
+ *	\param[in]	eps		허용 오차
  *
- *	\return		ġ  ؼ ﰢ B  ʿ(-1), (0),  (1)
+ *	\return		수치 안정성을 위해서 삼각형 B의 교란이 필요(-1), 비교차(0), 정상 교차(1)
  */
 int intersect_tri_tri(
 	DgPos a0, DgPos a1, DgPos a2,
@@ -1091,13 +1283,13 @@ int intersect_tri_tri(
 	double eps = 1e-9);
 
 /*!
-*	\brief	    θ ˻Ѵ.
+*	\brief	평면과 경계 상자의 교차 여부를 검사한다.
 *
-*	\param	n[in]			 
-*	\param	p[in]			  
-*	\param	halfsize[in]	 ߽ϴ      
+*	\param	n[in]			평면의 법선
+*	\param	p[in]			평면 위의 점
+*	\param	halfsize[in]	원점을 중심으로하는 경계 상자의 각 축 길이의 반
 *
-*	\return   ڰ ϸ true, ƴϸ false ȯѴ.
+*	\return 평면과 경계 상자가 교차하면 true, 아니면 false를 반환한다.
 */
 static bool intersect_plane_box(DgVec3 n, DgVec3 p, DgVec3 halfsize)
 {
@@ -1123,17 +1315,17 @@ static bool intersect_plane_box(DgVec3 n, DgVec3 p, DgVec3 halfsize)
 }
 
 /******************/
-/*   Create Լ  */
+/*   Create 함수  */
 /******************/
 
 /*!
- *	\biref	޽  Ѵ.
+ *	\biref	메쉬 정점을 생성한다.
  *
- *	\param[in]	x	 x ǥ
- *	\param[in]	y	 y ǥ
- *	\param[in]	z	 z ǥ
+ *	\param[in]	x	정점의 x 좌표
+ *	\param[in]	y	정점의 y 좌표
+ *	\param[in]	z	정점의 z 좌표
  *
- *	\return   ͸ ȯѴ.
+ *	\return 생성된 정점의 포인터를 반환한다.
  */
 DgVertex* create_vertex(double x, double y, double z)
 {
@@ -1141,13 +1333,13 @@ DgVertex* create_vertex(double x, double y, double z)
 }
 
 /*!
- *	\brief	޽ ﰢ Ѵ.
+ *	\brief	메쉬 삼각형을 생성한다.
  *
- *	\param[in]	v0			ﰢ ù ° 
- *	\param[in]	v1			ﰢ  ° 
- *	\param[in]	v2			ﰢ  ° 
- *	\param[in]	pMtl		ﰢ ϴ   
- *	\param[in]	groupName	ﰢ  ׷ ̸
+ *	\param[in]	v0			삼각형의 첫 번째 정점
+ *	\param[in]	v1			삼각형의 두 번째 정점
+ *	\param[in]	v2			삼각형의 세 번째 정점
+ *	\param[in]	pMtl		삼각형이 사용하는 재질에 대한 포인터
+ *	\param[in]	groupName	삼각형이 속한 그룹의 이름
  */
 DgFace* create_face(DgVertex* v0, DgVertex* v1, DgVertex* v2, DgMaterial* pMtl, std::string GroupName)
 {
@@ -1,11 +1,57 @@
 #include "DgViewer.h"
 
+/*!
+*	@brief	씬이 소유한 GL 객체, 볼륨, BVH, 메쉬를 해제
+*	@note	DgBvh는 DgScene.h에서 전방 선언만 되므로 완전한 타입이 보이는 이곳에서 삭제해야 함
+*/
+DgScene::~DgScene()
+{
+	if (mSDFAtlasID != 0)
+		glDeleteTextures(1, &mSDFAtlasID);
+	if (mMacroAtlasID != 0)
+		glDeleteTextures(1, &mMacroAtlasID);
+	if (mTileMaskID != 0)
+		glDeleteTextures(1, &mTileMaskID);
+	if (mSDFUBO != 0)
+		glDeleteBuffers(1, &mSDFUBO);
+	if (mSDFPassVAO != 0)
+		glDeleteVertexArrays(1, &mSDFPassVAO);
+	for (int i = 0; i < SDF_PBO_RING; ++i)
+	{
+		if (mSDFPBOFences[i] != nullptr)
+			glDeleteSync(mSDFPBOFences[i]);
+		if (mSDFPBOPtrs[i] != nullptr)
+		{
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, mSDFPBOs[i]);
+			glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+		}
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	if (mSDFPBOs[0] != 0)
+		glDeleteBuffers(SDF_PBO_RING, mSDFPBOs);
+	if (mCameraUBO != 0)
+		glDeleteBuffers(1, &mCameraUBO);
+	for (DgVolume* v : mSDFList)
+		delete v;
+	for (auto& item : mPickBvhs)
+		delete item.second;
+
+	glDeleteVertexArrays(1, &mGroundVAO);
+	glDeleteBuffers(1, &mGroundVBO);
+
+	for (DgMesh* m : mMeshList)
+		delete m;
+	
+	for (GLuint id : mShaders)
+		glDeleteProgram(id);
+}
+
 void DgScene::createGroundMesh()
 {
-	// -10 10 1.0   ڼ 
+	// -10부터 10까지 1.0 단위 간격으로 격자선 생성
 	for (float x = -10.0f; x <= 10.0f; x += 1.0f)
 	{
-		// : (x, 0, -10) ~ (x, 0, 10)
+		// 수직선: (x, 0, -10) ~ (x, 0, 10)
 		mGroundVerts.push_back(x);
 		mGroundVerts.push_back(0.0f);
 		mGroundVerts.push_back(-10.0f);
@@ -14,7 +60,7 @@ void DgScene::createGroundMesh()
 		mGroundVerts.push_back(0.0f);
 		mGroundVerts.push_back(10.0f);
 
-		// : (-10, 0, x) ~ (10, 0, x)
+		// 수평선: (-10, 0, x) ~ (10, 0, x)
 		mGroundVerts.push_back(-10.0f);
 		mGroundVerts.push_back(0.0f);
 		mGroundVerts.push_back(x);
@@ -24,31 +70,31 @@ void DgScene::createGroundMesh()
 		mGroundVerts.push_back(x);
 	}
 	
-	// VAO(Vertex Array Object) VBO(Vertex Buffer Object) 
-	glGenVertexArrays(1, &mGroundVAO);  // VAO 1 
-	glGenBuffers(1, &mGroundVBO);       // VBO 1 
+	// VAO(Vertex Array Object)와 VBO(Vertex Buffer Object) 생성
+	glGenVertexArrays(1, &mGroundVAO);  // VAO 1개 생성
+	glGenBuffers(1, &mGroundVBO);       // VBO 1개 생성
 
-	// VAO ε (   VAO )
+	// VAO 바인딩 (이후 설정은 이 VAO에 저장됨)
 	glBindVertexArray(mGroundVAO);
 	{
-		// VBO ε   ε
-		glBindBuffer(GL_ARRAY_BUFFER, mGroundVBO);  //  Ÿ 
+		// VBO 바인딩 및 데이터 업로드
+		glBindBuffer(GL_ARRAY_BUFFER, mGroundVBO);  // 버퍼 타입 지정
 
-		//  ͸ GPU ޸𸮿 ( Ƿ STATIC_DRAW)
+		// 정점 데이터를 GPU 메모리에 복사(변경되지 않으므로 STATIC_DRAW)
 		glBufferData(GL_ARRAY_BUFFER, mGroundVerts.size() * sizeof(float), mGroundVerts.data(), GL_STATIC_DRAW);
 
-		//  Ӽ  (location = 0, vec3 ġ ǥ)
+		// 정점 속성 설정 (location = 0, vec3 위치 좌표)
 		glVertexAttribPointer(
 			0,                  // layout(location = 0)
-			3,                  // vec3: 3 float
-			GL_FLOAT,           //  Ÿ
-			GL_FALSE,           // ȭ  ( ġ ȭ )
-			3 * sizeof(float),  // stride:   3 float (12 bytes)
-			(void*)0            //   (迭 ù ġ)
+			3,                  // vec3: 3개의 float
+			GL_FLOAT,           // 데이터 타입
+			GL_FALSE,           // 정규화 여부 (정점 위치는 정규화하지 않음)
+			3 * sizeof(float),  // stride: 한 점당 3개의 float (12 bytes)
+			(void*)0            // 시작 오프셋 (배열 첫 위치부터)
 		);
-		glEnableVertexAttribArray(0);  // location 0  Ȱȭ
+		glEnableVertexAttribArray(0);  // location 0 사용 활성화
 	}
-	glBindVertexArray(0);   // VAO ε ( ٸ ü    ʵ)
+	glBindVertexArray(0);   // VAO 언바인딩 (추후 다른 객체 설정에 영향을 주지 않도록)
 }
 
 void DgScene::getSphereCoords(double x, double y, float* px, float* py, float* pz)
@@ -67,10 +113,10 @@ void DgScene::getSphereCoords(double x, double y, float* px, float* py, float* p
 
 void DgScene::showWindow()
 {
-	//  ° ƴϸ Ѵ.
+	// 오픈 상태가 아니면 리턴한다.
 	if (!mOpen)	return;
 
-	//  ÷(window flag) Ѵ.
+	// 윈도우 플래그(window flag)를 설정한다.
 	static bool no_titlebar = false;
 	static bool no_scrollbar = false;
 	static bool no_menu = true;
@@ -97,7 +143,7 @@ void DgScene::showWindow()
 	if (no_docking)         window_flags |= ImGuiWindowFlags_NoDocking;
 	if (unsaved_document)   window_flags |= ImGuiWindowFlags_UnsavedDocument;
 
-	//  츦 ϰ, collapsed ¶ ٷ Ѵ.
+	// 장면 윈도우를 생성하고, collapsed된 상태라면 바로 리턴한다.
 	bool* openPtr = (no_close ? nullptr : &mOpen);
 	if (!ImGui::Begin("SceneGL", openPtr, window_flags))
 	{
@@ -105,16 +151,16 @@ void DgScene::showWindow()
 		return;
 	}
 
-	// 콺 ̺Ʈ ó
+	// 마우스 이벤트를 처리
 	processMouseEvent();
 
-	// Ű ̺Ʈ ó
+	// 키보드 이벤트를 처리
 	processKeyboardEvent();
 
-	//   
+	// 장면과 도구를 렌더링
 	renderScene();
 
-	// Context ˾ ޴ 
+	// Context 팝업 메뉴를 렌더링
 	renderContextPopup();
 
 	ImGui::End();
@@ -124,18 +170,18 @@ void DgScene::processMouseEvent()
 {
 	if (ImGui::IsWindowHovered(ImGuiHoveredFlags_None))
 	{
-		//     (0, 0) 콺 ǥ(x, y) Ѵ.
+		// 현재 윈도우의 좌측 상단을 기준(0, 0)으로 마우스 좌표(x, y)를 구한다.
 		ImVec2 pos = ImGui::GetMousePos() - ImGui::GetCursorScreenPos();
 		int x = (int)pos.x, y = (int)pos.y;
 		ImVec2 delta = ImGui::GetIO().MouseDelta;
-		ImGuiIO& io = ImGui::GetIO();								// Ctrl  Ȯ
+		ImGuiIO& io = ImGui::GetIO();								// Ctrl 상태 확인
 
-		if (io.KeyCtrl && ImGui::IsMouseClicked(ImGuiMouseButton_Left))			//  ư Ŭ 
+		if (io.KeyCtrl && ImGui::IsMouseClicked(ImGuiMouseButton_Left))			// 왼쪽 버튼을 클릭한 경우
 		{
 			mStartPos[0] = pos[0];
 			mStartPos[1] = pos[1];
 		}
-		else if (io.KeyCtrl && ImGui::IsMouseDragging(ImGuiMouseButton_Left))	//  ư 巡ϴ 
+		else if (io.KeyCtrl && ImGui::IsMouseDragging(ImGuiMouseButton_Left))	// 왼쪽 버튼으로 드래깅하는 경우
 		{
 			float px, py, pz, qx, qy, qz;
 			getSphereCoords(mStartPos[0], mStartPos[1], &px, &py, &pz);
@@ -149,16 +195,21 @@ void DgScene::processMouseEvent()
 			mStartPos[0] = pos[0];
 			mStartPos[1] = pos[1];
 		}
-		else if (ImGui::IsMouseReleased(ImGuiMouseButton_Left))		// Ŭߴ  ư  
+		else if (ImGui::IsMouseClicked(ImGuiMouseButton_Left))		// Ctrl 없이 왼쪽 버튼을 클릭한 경우
+		{
+			if (pickMesh(pos[0], pos[1]))
+				printf("Picked %s: instance = %d, face = %d, pos = (%.4f, %.4f, %.4f)\n", mPickMesh->mName.c_str(), mPickInstance, mPickFace, mPickPos[0], mPickPos[1], mPickPos[2]);
+		}
+		else if (ImGui::IsMouseReleased(ImGuiMouseButton_Left))		// 클릭했던 왼쪽 버튼을 놓는 경우
 		{
 			mStartPos[0] = mStartPos[1] = 0.0;
 		}
-		else if (io.KeyCtrl && ImGui::IsMouseClicked(ImGuiMouseButton_Middle))	// ߰ ư Ŭ 
+		else if (io.KeyCtrl && ImGui::IsMouseClicked(ImGuiMouseButton_Middle))	// 중간 버튼을 클릭한 경우
 		{
 			mStartPos[0] = pos[0];
 			mStartPos[1] = pos[1];
 		}
-		else if (io.KeyCtrl && ImGui::IsMouseDragging(ImGuiMouseButton_Middle))	// ߰ ư 巡ϴ 
+		else if (io.KeyCtrl && ImGui::IsMouseDragging(ImGuiMouseButton_Middle))	// 중간 버튼으로 드래깅하는 경우
 		{
 			float dx = (float)(pos[0] - mStartPos[0]) * 0.01f;
 			float dy = (float)(mStartPos[1] - pos[1]) * 0.01f;
@@ -166,23 +217,23 @@ void DgScene::processMouseEvent()
 			mStartPos[0] = pos[0];
 			mStartPos[1] = pos[1];
 		}
-		else if (ImGui::IsMouseReleased(ImGuiMouseButton_Middle))	// Ŭߴ ߰ ư  
+		else if (ImGui::IsMouseReleased(ImGuiMouseButton_Middle))	// 클릭했던 중간 버튼을 놓은 경우
 		{
 		}
-		else if (ImGui::IsMouseClicked(ImGuiMouseButton_Right))		//  ư Ŭ 
+		else if (ImGui::IsMouseClicked(ImGuiMouseButton_Right))		// 오른쪽 버튼을 클릭한 경우
 		{
 		}
-		else if (ImGui::IsMouseDragging(ImGuiMouseButton_Right))	//  ư 巡ϴ  
+		else if (ImGui::IsMouseDragging(ImGuiMouseButton_Right))	// 오른쪽 버튼으로 드래깅하는 경우 
 		{
 		}
-		else if (ImGui::IsMouseReleased(ImGuiMouseButton_Right))	// Ŭߴ  ư  
+		else if (ImGui::IsMouseReleased(ImGuiMouseButton_Right))	// 클릭했던 오른쪽 버튼을 놓은 경우
 		{
 		}
-		else if (delta.x != 0.0f || delta.y != 0.0f)				// ׳ ̴ 
+		else if (delta.x != 0.0f || delta.y != 0.0f)				// 그냥 움직이는 경우
 		{
 		}
 
-		//  /ƿ Ѵ.
+		// 장면의 줌인/아웃을 수행한다.
 		if (ImGui::GetIO().MouseWheel != 0.0f)
 		{
 			int dir = (ImGui::GetIO().MouseWheel > 0.0) ? 1 : -1;
@@ -191,9 +242,68 @@ void DgScene::processMouseEvent()
 	}
 }
 
+bool DgScene::pickMesh(float x, float y)
+{
+	mPickMesh = nullptr;
+	mPickFace = -1;
+	mPickInstance = -1;
+	if (mSceneSize[0] <= 0.0f || mSceneSize[1] <= 0.0f)
+		return false;
+
+	// 마지막 프레임의 변환 행렬로 화면 좌표를 지나는 광선을 구한다.
+	float nx = 2.0f * x / mSceneSize[0] - 1.0f;
+	float ny = 1.0f - 2.0f * y / mSceneSize[1];
+	glm::mat4 invMat = glm::inverse(mProjMat * mViewMat);
+	glm::vec4 p0 = invMat * glm::vec4(nx, ny, -1.0f, 1.0f);
+	glm::vec4 p1 = invMat * glm::vec4(nx, ny, 1.0f, 1.0f);
+	p0 /= p0.w;
+	p1 /= p1.w;
+	DgPos org(p0.x, p0.y, p0.z);
+	DgVec3 dir(p1.x - p0.x, p1.y - p0.y, p1.z - p0.z);
+
+	// 메쉬별 BVH와 교차시켜 가장 가까운 교차점을 구한다.
+	// 인스턴스마다 광선을 인스턴스의 지역 좌표계로 변환하여 교차시키며, 광선 파라미터 t는 어파인 변환에 대해 불변이다.
+	double tmin = 1.0;
+	for (DgMesh* pMesh : mMeshList)
+	{
+		if (pMesh->mFaces.empty())
+			continue;
+		DgBvh*& pBvh = mPickBvhs[pMesh];
+		if (pBvh == nullptr)
+			pBvh = new DgBvh(pMesh, DgBvh::BUILD_SAH);
+
+		for (int i = 0; i < pMesh->getNumInstances(); ++i)
+		{
+			DgPos localOrg = org;
+			DgVec3 localDir = dir;
+			if (!pMesh->mInstMats.empty())
+			{
+				glm::mat4 invInst = glm::inverse(pMesh->mInstMats[i]);
+				glm::vec4 o = invInst * glm::vec4(p0.x, p0.y, p0.z, 1.0f);
+				glm::vec4 d = invInst * glm::vec4(p1.x - p0.x, p1.y - p0.y, p1.z - p0.z, 0.0f);
+				localOrg = DgPos(o.x, o.y, o.z);
+				localDir = DgVec3(d.x, d.y, d.z);
+			}
+
+			double t;
+			DgFace* pFace = NULL;
+			if (pBvh->intersectRay(localOrg, localDir, tmin, t, &pFace))
+			{
+				tmin = t;
+				mPickMesh = pMesh;
+				mPickFace = (int)(pFace - pMesh->mFaces.data());
+				mPickInstance = i;
+			}
+		}
+	}
+	if (mPickMesh != nullptr)
+		mPickPos = org + tmin * dir;
+	return mPickMesh != nullptr;
+}
+
 void DgScene::renderScene()
 {
-	//  (3D Scene)  Ͽ,  ۸ Ѵ.
+	// 현재 윈도우(3D Scene)의 정보를 구하여, 렌더링 버퍼를 갱신한다.
 	ImVec2 sceneSize = ImGui::GetContentRegionAvail();
 	if (sceneSize[0] != mSceneSize[0] || sceneSize[1] != mSceneSize[1])
 	{
@@ -201,123 +311,162 @@ void DgScene::renderScene()
 		mFrameBuf.rescaleFrameBuffer((int)sceneSize[0], (int)sceneSize[1]);
 	}
 
-	//  Į ۿ 
+	// 장면 칼라 버퍼에 렌더링
 	mFrameBuf.bind();
 	{
 		glViewport(0, 0, (GLsizei)mSceneSize[0], (GLsizei)mSceneSize[1]);
 		glClearColor(1.0, 1.0, 1.0, 1.0);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);				
 
-		//  ȯ  
+		// 투영 변환 행렬 설정
 		glm::mat4 projMat = glm::perspective(glm::radians(30.0f), mSceneSize[0] / mSceneSize[1], 1.0f, 1000.0f);
 
-		//  ȯ 
-		glm::mat4 viewMat(1.0f);                                                //   ʱȭ, M = I
-		viewMat = glm::translate(viewMat, glm::vec3(0.0, 0.0, mZoom));           //  ȯ, M = I * T
-		viewMat = viewMat * mRotMat;                                             // ȸ ȯ, M = I * T * R
-		viewMat = glm::translate(viewMat, glm::vec3(mPan[0], mPan[1], mPan[2]));   // Pan ȯ, M = I * T * R * Pan
+		// 관측 변환 행렬
+		glm::mat4 viewMat(1.0f);                                                // 단위 행렬 초기화, M = I
+		viewMat = glm::translate(viewMat, glm::vec3(0.0, 0.0, mZoom));           // 줌 변환, M = I * T
+		viewMat = viewMat * mRotMat;                                             // 회전 변환, M = I * T * R
+		viewMat = glm::translate(viewMat, glm::vec3(mPan[0], mPan[1], mPan[2]));   // Pan 변환, M = I * T * R * Pan
+		mViewMat = viewMat;
+		mProjMat = projMat;
 
-		// ٴ 
+		// 카메라와 조명 데이터는 프레임마다 한 번만 유니폼 버퍼로 전달한다.
+		updateCameraBlock(viewMat, projMat);
+		mNumDrawCalls = 1;
+		mNumStateChanges = 2;
+
+		// 바닥 렌더링
 		{
-			// 𵨸 ȯ ( )
+			// 모델링 변환 행렬(단위 행렬)
 			glm::mat4 modelMat(1.0f);
-			glUseProgram(mShaders[0]);
+			const DgShader& shader = DgShader::get(mShaders[0]);
+			glUseProgram(shader.mId);
 
-			//  ̴ Ķ 
-			glUniformMatrix4fv(glGetUniformLocation(mShaders[0], "uModel"), 1, GL_FALSE, glm::value_ptr(modelMat));
-			glUniformMatrix4fv(glGetUniformLocation(mShaders[0], "uView"), 1, GL_FALSE, glm::value_ptr(viewMat));
-			glUniformMatrix4fv(glGetUniformLocation(mShaders[0], "uProjection"), 1, GL_FALSE, glm::value_ptr(projMat));
+			// 정점 쉐이더에 파라미터 전달
+			glUniformMatrix4fv(shader.getLoc(DgShader::UNIFORM_MODEL), 1, GL_FALSE, glm::value_ptr(modelMat));
 
-			// ٴ  ׸
+			// 바닥 평면 그리기
 			glBindVertexArray(mGroundVAO);
 			glDrawArrays(GL_LINES, 0, mGroundVerts.size() / 3);
 			glBindVertexArray(0);
 			glUseProgram(0);
 		}
 
-		//  
-		for (DgMesh* pMesh : mMeshList)
-		{
-			// 𵨸 ȯ ( )
-			glm::mat4 modelMat(1.0f);
-
-			// ̴ α׷ 
-			GLuint shaderProgram = pMesh->mShaderId;
-			glUseProgram(shaderProgram);
-
-			//  ̴ Ķ 
-			glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "uModel"), 1, GL_FALSE, glm::value_ptr(modelMat));
-			glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "uView"), 1, GL_FALSE, glm::value_ptr(viewMat));
-			glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "uProjection"), 1, GL_FALSE, glm::value_ptr(projMat));
+		// 모델 렌더링
+		renderMeshes();
 
-			//  Ӽ  ġ 
-			glm::vec3 viewPos = glm::vec3(glm::inverse(viewMat)[3]);
-			glm::vec3 lightPos = glm::vec3(glm::inverse(viewMat)[3]);
-			glUniform3fv(glGetUniformLocation(shaderProgram, "uViewPos"), 1, glm::value_ptr(viewPos));
-			glUniform3fv(glGetUniformLocation(shaderProgram, "uLightPos"), 1, glm::value_ptr(lightPos));
-			glUniform3fv(glGetUniformLocation(shaderProgram, "uLightColor"), 1, glm::value_ptr(glm::vec3(1.0f)));
+		// SDF 볼륨 렌더링(모든 볼륨을 한 번의 전체 화면 패스로 레이마칭)
+		syncSDFAtlas();
+		updateSDFVolumes(viewMat, projMat);
+		renderSDFVolumes();
 
+		// FPS 렌더링
+		renderFps();					
+	}
+	mFrameBuf.unbind();
 
-			//  Ӹ ð  
-			float timeValue = static_cast<float>(glfwGetTime());
-
-			// uTime ġ 
-			GLint timeLoc = glGetUniformLocation(shaderProgram, "uTime");
+	ImTextureID textureID = (void*)(uintptr_t)mFrameBuf.getFrameTexture();
+	ImGui::Image(textureID, ImGui::GetContentRegionAvail(), ImVec2(0, 1), ImVec2(1, 0));
+}
 
-			//   
-			glUseProgram(shaderProgram);
-			glUniform1f(timeLoc, timeValue);
+void DgScene::renderMeshes()
+{
+	// 메쉬의 재질별로 (쉐이더, 텍스처, VAO, 재질) 정렬 키를 만들어 렌더 큐를 구성한다.
+	mRenderQueue.clear();
+	for (DgMesh* pMesh : mMeshList)
+	{
+		pMesh->updateBuffers();
+		bool bTexture = pMesh->hasTexture();
+		for (int i = 0; i < NUM(pMesh->mMtlRanges) && i < NUM(pMesh->mMaterials); ++i)
+		{
+			if (pMesh->mMtlRanges[i].second == 0)
+				continue;
+			GLuint texId = bTexture ? pMesh->mMaterials[i].mTexId : 0;
+			unsigned long long key = ((unsigned long long)(pMesh->mShaderId & 0xffff) << 48) | ((unsigned long long)(texId & 0xffff) << 32) |
+				((unsigned long long)(pMesh->mVAO & 0xffff) << 16) | (unsigned long long)(i & 0xffff);
+			mRenderQueue.push_back({ key, pMesh, i });
+		}
+	}
+	std::sort(mRenderQueue.begin(), mRenderQueue.end(), [](const DgDrawItem& a, const DgDrawItem& b) { return a.mKey < b.mKey; });
 
-			//   ϱ
-			pMesh->render();
-			glUseProgram(0);
+	// 이전 항목과 다른 상태만 바인딩하며 그린다.
+	const DgShader* pShader = nullptr;
+	const DgMesh* pCurrMesh = nullptr;
+	GLuint currVAO = 0, currTex = 0;
+	bool bTexBound = false;
+	for (const DgDrawItem& item : mRenderQueue)
+	{
+		DgMesh* pMesh = item.mMesh;
+		if (pShader == nullptr || pShader->mId != pMesh->mShaderId)
+		{
+			pShader = &DgShader::get(pMesh->mShaderId);
+			glUseProgram(pShader->mId);
+			pCurrMesh = nullptr;
+			mNumStateChanges++;
 		}
-		for (DgVolume* pVolume : mSDFList)
+		if (pCurrMesh != pMesh)
 		{
-			if(pVolume==nullptr ||mSDFID ==0) continue;
+			// 모델링 변환 행렬(단위 행렬)
 			glm::mat4 modelMat(1.0f);
-
-			GLuint shaderProgram = mShaders[4];
-			glUseProgram(shaderProgram);
-			glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "uModel"), 1, GL_FALSE, glm::value_ptr(modelMat));
-			glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "uView"), 1, GL_FALSE, glm::value_ptr(viewMat));
-			glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "uProjection"), 1, GL_FALSE, glm::value_ptr(projMat));
-
-			glm::vec3 viewPos = glm::vec3(glm::inverse(viewMat)[3]);
-			glm::vec3 lightPos = glm::vec3(glm::inverse(viewMat)[3]);
-			glUniform3fv(glGetUniformLocation(shaderProgram, "uViewPos"), 1, glm::value_ptr(viewPos));
-			glUniform3fv(glGetUniformLocation(shaderProgram, "uLightPos"), 1, glm::value_ptr(lightPos));
-			glUniform3fv(glGetUniformLocation(shaderProgram, "uLightColor"), 1, glm::value_ptr(glm::vec3(1.0f)));
-
-			glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "uInvView"), 1, GL_FALSE, glm::value_ptr(glm::inverse(viewMat)));
-			glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "uInvProj"), 1, GL_FALSE, glm::value_ptr(glm::inverse(projMat)));
-			glUniform2f(glGetUniformLocation(shaderProgram, "uResolution"), mSceneSize[0], mSceneSize[1]);
+			glUniformMatrix4fv(pShader->getLoc(DgShader::UNIFORM_MODEL), 1, GL_FALSE, glm::value_ptr(modelMat));
+			pCurrMesh = pMesh;
+		}
+		if (currVAO != pMesh->mVAO)
+		{
+			glBindVertexArray(pMesh->mVAO);
+			currVAO = pMesh->mVAO;
+			mNumStateChanges++;
+		}
+		GLuint texId = pMesh->mMaterials[item.mMtlIdx].mTexId;
+		if (pMesh->hasTexture() && (!bTexBound || currTex != texId))
+		{
 			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_3D, mSDFID);
-			glUniform1i(glGetUniformLocation(shaderProgram, "uSDFVolume"), 0);
-
-			//    
-			glUniform3f(glGetUniformLocation(shaderProgram, "uVolumeMin"), (float)pVolume->mMin.mPos[0], (float)pVolume->mMin.mPos[1], (float)pVolume->mMin.mPos[2]);
-			glUniform3f(glGetUniformLocation(shaderProgram, "uVolumeMax"), (float)pVolume->mMax.mPos[0], (float)pVolume->mMax.mPos[1], (float)pVolume->mMax.mPos[2]);
+			glBindTexture(GL_TEXTURE_2D, texId);
+			currTex = texId;
+			bTexBound = true;
+			mNumStateChanges++;
+		}
 
-			pVolume->mMesh->render();
+		pMesh->setMaterial(*pShader, item.mMtlIdx);
+		pMesh->drawMaterial(item.mMtlIdx);
+		mNumDrawCalls++;
+	}
 
-			glBindTexture(GL_TEXTURE_3D, 0);
-			glUseProgram(0);
-		}
+	glBindVertexArray(0);
+	glUseProgram(0);
+}
 
-		// FPS 
-		renderFps();					
+void DgScene::updateCameraBlock(const glm::mat4& viewMat, const glm::mat4& projMat)
+{
+	// 처음 호출될 때 유니폼 버퍼를 생성하여 바인딩 지점에 연결한다.
+	if (mCameraUBO == 0)
+	{
+		glGenBuffers(1, &mCameraUBO);
+		glBindBuffer(GL_UNIFORM_BUFFER, mCameraUBO);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(DgCameraBlock), nullptr, GL_DYNAMIC_DRAW);
+		glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_UBO_BINDING, mCameraUBO);
 	}
-	mFrameBuf.unbind();
 
-	ImTextureID textureID = (void*)(uintptr_t)mFrameBuf.getFrameTexture();
-	ImGui::Image(textureID, ImGui::GetContentRegionAvail(), ImVec2(0, 1), ImVec2(1, 0));
+	// 역행렬은 프레임마다 한 번만 계산한다(광원은 카메라 위치에 둠).
+	DgCameraBlock block;
+	memset(&block, 0, sizeof(block));
+	block.mView = viewMat;
+	block.mProj = projMat;
+	block.mInvView = glm::inverse(viewMat);
+	block.mInvProj = glm::inverse(projMat);
+	block.mViewPos = glm::vec3(block.mInvView[3]);
+	block.mLightPos = block.mViewPos;
+	block.mLightColor = glm::vec3(1.0f);
+	block.mTime = static_cast<float>(glfwGetTime());
+	block.mResolution = glm::vec2(mSceneSize[0], mSceneSize[1]);
+
+	glBindBuffer(GL_UNIFORM_BUFFER, mCameraUBO);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(DgCameraBlock), &block);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
 }
 
 void DgScene::renderFps()
 {
-	//   ġ  Ѵ.
+	// 출력할 윈도우의 위치와 투명도를 설정한다.
 	const float D = 10.0f;
 	static int corner = 3;
 	float W = ImGui::GetWindowSize().x;
@@ -337,17 +486,18 @@ void DgScene::renderFps()
 	}
 	ImGui::SetNextWindowBgAlpha(0.35f);
 
-	// 콺 ǥ Ѵ.
+	// 마우스 좌표를 구한다.
 	ImGuiIO& io = ImGui::GetIO();
 	ImVec2 pos = ImGui::GetMousePos() - ImGui::GetCursorScreenPos();
 
-	// 츦 ϰ ޽ Ѵ.
+	// 윈도우를 생성하고 메시지를 출력한다.
 	bool open = true;
 	bool* p_open = &open;
 	ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 7.0f);
 	if (ImGui::Begin("Example: Simple overlay", p_open, (corner != -1 ? ImGuiWindowFlags_NoMove : 0) | ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav))
 	{
 		ImGui::Text("Rendering Speed: %.1f FPS", io.Framerate);
+		ImGui::Text("Draw Calls: %d, State Changes: %d", mNumDrawCalls, mNumStateChanges);
 		ImGui::Separator();
 		if (ImGui::IsMousePosValid())
 			ImGui::Text("Mouse Position: (%d,%d)", (int)pos.x, (int)pos.y);
@@ -371,7 +521,7 @@ void DgScene::renderFps()
 
 void DgScene::processKeyboardEvent()
 {
-	// Ű ̺Ʈ óѴ.
+	// 키보드 이벤트를 처리한다.
 	if (ImGui::IsWindowHovered(ImGuiHoveredFlags_None))
 	{
 		if (ImGui::IsKeyPressed(ImGuiKey_Escape))
@@ -409,6 +559,10 @@ void DgScene::renderContextPopup()
 			return;
 		}
 		
+		// --- SDF 디버그 ---
+		ImGui::MenuItem("SDF Step Heatmap", nullptr, &mShowStepHeatmap);
+		ImGui::Separator();
+
 		// --- per-mesh ---
 		for (size_t i = 0; i < mMeshList.size(); ++i)
 		{
@@ -424,7 +578,7 @@ void DgScene::renderContextPopup()
 
 			if (ImGui::BeginMenu(menuLabel))
 			{
-				// 1~9 
+				// 1~9 라벨
 				for (int s = 0; s < showCount; ++s)
 				{
 					bool selected = (M->mShaderId == mShaders[s]);
@@ -442,24 +596,479 @@ void DgScene::renderContextPopup()
 
 void DgScene::createSDF(DgVolume& volume)
 {
-	//SDF ؽó ID 
-	if (mSDFID == 0)
-		glGenTextures(1, &mSDFID);
+	//볼륨 전체를 변경된 것으로 표시하고 아틀라스에 반영한다(해상도가 같으면 텍스처를 다시 할당하지 않음).
+	volume.markAllDirty();
+	syncSDFAtlas();
+}
+
+void DgScene::syncSDFAtlas()
+{
+	// 볼륨 목록, 해상도, 저장 형식 중 하나라도 바뀌었으면 아틀라스를 다시 구성한다.
+	bool changed = false;
+	int n = 0;
+	for (DgVolume* pVolume : mSDFList)
+	{
+		if (pVolume == nullptr || pVolume->mDim[0] <= 0 || pVolume->mDim[1] <= 0 || pVolume->mDim[2] <= 0)
+			continue;
+		if (n == MAX_SDF_VOLUMES)
+			break;
+		if (pVolume->mMacroData.empty())
+			pVolume->computeMacroGrid();
+
+		if (n >= NUM(mSDFSlots) || mSDFSlots[n].mVolume != pVolume || mSDFSlots[n].mStorageType != pVolume->getStorageType())
+			changed = true;
+		else
+			for (int a = 0; a < 3; ++a)
+				if (mSDFSlots[n].mDim[a] != pVolume->mDim[a] || mSDFSlots[n].mMacroDim[a] != pVolume->mMacroDim[a])
+					changed = true;
+		n++;
+	}
+	if (changed || n != NUM(mSDFSlots))
+	{
+		buildSDFAtlas();
+		return;
+	}
+
+	// 구성이 같으면 변경된 브릭만 올린다.
+	for (const DgSDFSlot& slot : mSDFSlots)
+		if (slot.mVolume->mNumDirtyBricks > 0)
+			uploadDirtyBricks(slot);
+}
+
+void DgScene::buildSDFAtlas()
+{
+	// 볼륨을 z 방향으로 쌓아 아틀라스 크기와 배치 위치를 정하고, 가장 정밀한 볼륨의 저장 형식을 아틀라스 형식으로 사용한다.
+	mSDFSlots.clear();
+	int atlasDim[3] = { 1, 1, 0 }, macroDim[3] = { 1, 1, 0 };
+	DgVolume::TypeQuant atlasType = DgVolume::QUANT_SNORM8;
+	for (DgVolume* pVolume : mSDFList)
+	{
+		if (pVolume == nullptr || pVolume->mDim[0] <= 0 || pVolume->mDim[1] <= 0 || pVolume->mDim[2] <= 0)
+			continue;
+		if (NUM(mSDFSlots) == MAX_SDF_VOLUMES)
+		{
+			printf("SDF atlas: only the first %d volumes are rendered\n", MAX_SDF_VOLUMES);
+			break;
+		}
+		if (pVolume->mMacroData.empty())
+			pVolume->computeMacroGrid();
+		else
+			pVolume->updateMacroGrid();
 
-	glBindTexture(GL_TEXTURE_3D, mSDFID);
+		// 밉 레벨마다 볼륨이 정확히 절반 크기의 텍셀에 대응하도록 z 시작 위치를 2^SDF_MIP_LEVELS의 배수로 맞춘다.
+		const int align = 1 << SDF_MIP_LEVELS;
+		atlasDim[2] = (atlasDim[2] + align - 1) / align * align;
+		DgSDFSlot slot = {
+			pVolume, atlasDim[2], macroDim[2],
+			{ pVolume->mDim[0], pVolume->mDim[1], pVolume->mDim[2] },
+			{ pVolume->mMacroDim[0], pVolume->mMacroDim[1], pVolume->mMacroDim[2] },
+			pVolume->getStorageType()
+		};
+		mSDFSlots.push_back(slot);
+		atlasType = MIN(atlasType, pVolume->getStorageType());
+		for (int a = 0; a < 2; ++a)
+		{
+			atlasDim[a] = MAX(atlasDim[a], pVolume->mDim[a]);
+			macroDim[a] = MAX(macroDim[a], pVolume->mMacroDim[a]);
+		}
+		atlasDim[2] += pVolume->mDim[2];
+		macroDim[2] += pVolume->mMacroDim[2];
+	}
+	if (mSDFSlots.empty())
+		return;
+	for (int a = 0; a < 3; ++a)
+		atlasDim[a] = (atlasDim[a] + (1 << SDF_MIP_LEVELS) - 1) >> SDF_MIP_LEVELS << SDF_MIP_LEVELS;
+
+	//SDF 아틀라스 생성(해상도나 형식이 바뀐 경우에만 다시 할당, 볼륨 사이의 보간은 쉐이더에서 볼륨별 텍셀 범위로 좌표를 제한하여 막음)
+	static const GLenum internalFormats[3] = { GL_R32F, GL_R16F, GL_R8_SNORM };
+	if (mSDFAtlasID == 0)
+		glGenTextures(1, &mSDFAtlasID);
+	glBindTexture(GL_TEXTURE_3D, mSDFAtlasID);
+	if (atlasDim[0] != mAtlasDim[0] || atlasDim[1] != mAtlasDim[1] || atlasDim[2] != mAtlasDim[2] || internalFormats[atlasType] != mAtlasFormat)
+	{
+		for (int l = 0; l <= SDF_MIP_LEVELS; ++l)
+			glTexImage3D(GL_TEXTURE_3D, l, internalFormats[atlasType], atlasDim[0] >> l, atlasDim[1] >> l, atlasDim[2] >> l, 0, GL_RED, GL_FLOAT, nullptr);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAX_LEVEL, SDF_MIP_LEVELS);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+		for (int a = 0; a < 3; ++a)
+			mAtlasDim[a] = atlasDim[a];
+		mAtlasFormat = internalFormats[atlasType];
+	}
 
-	//GPU ε
-	glTexImage3D(GL_TEXTURE_3D, 0, GL_R32F,	volume.mDim[0], volume.mDim[1], volume.mDim[2], 0, GL_RED, GL_FLOAT, volume.mData.data());
+	//볼륨별 GPU 업로드(양자화된 볼륨은 정규화된 half/byte 그대로, 희소 격자는 밀집 배열로 변환하여 업로드)
+	std::vector<float> denseData;
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	for (const DgSDFSlot& slot : mSDFSlots)
+	{
+		DgVolume* pVolume = slot.mVolume;
+		if (pVolume->mQuantData.empty())
+		{
+			const float* pData = pVolume->getDenseData(denseData);
+			glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, slot.mAtlasZ, pVolume->mDim[0], pVolume->mDim[1], pVolume->mDim[2], GL_RED, GL_FLOAT, pData);
+		}
+		else
+		{
+			GLenum type = (pVolume->mQuantType == DgVolume::QUANT_FLOAT16) ? GL_HALF_FLOAT : GL_BYTE;
+			glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, slot.mAtlasZ, pVolume->mDim[0], pVolume->mDim[1], pVolume->mDim[2], GL_RED, type, pVolume->mQuantData.data());
+		}
 
-	//ؽó Ķ 
-	glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-	glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-	glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_BORDER);
+		// 보수적 피라미드를 밉 레벨로 올린다.
+		int lo[3] = { 0, 0, 0 }, hi[3] = { pVolume->mDim[0] - 1, pVolume->mDim[1] - 1, pVolume->mDim[2] - 1 };
+		if (pVolume->mNumDirtyBricks > 0 || pVolume->mMipData[0].empty())
+			pVolume->computeMipPyramid();
+		uploadSDFMips(slot, lo, hi);
+		pVolume->clearDirty();
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	//매크로 셀별 최소 거리 아틀라스 생성(셀 단위로 읽으므로 보간하지 않음)
+	if (mMacroAtlasID == 0)
+		glGenTextures(1, &mMacroAtlasID);
+	glBindTexture(GL_TEXTURE_3D, mMacroAtlasID);
+	if (macroDim[0] != mMacroAtlasDim[0] || macroDim[1] != mMacroAtlasDim[1] || macroDim[2] != mMacroAtlasDim[2])
+	{
+		glTexImage3D(GL_TEXTURE_3D, 0, GL_R32F, macroDim[0], macroDim[1], macroDim[2], 0, GL_RED, GL_FLOAT, nullptr);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+		for (int a = 0; a < 3; ++a)
+			mMacroAtlasDim[a] = macroDim[a];
+	}
+	for (const DgSDFSlot& slot : mSDFSlots)
+	{
+		const DgVolume* pVolume = slot.mVolume;
+		glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, slot.mMacroZ, pVolume->mMacroDim[0], pVolume->mMacroDim[1], pVolume->mMacroDim[2], GL_RED, GL_FLOAT, pVolume->mMacroData.data());
+	}
 
 	glBindTexture(GL_TEXTURE_3D, 0);
 }
+
+void DgScene::uploadDirtyBricks(const DgSDFSlot& slot)
+{
+	DgVolume* pVolume = slot.mVolume;
+	pVolume->updateMacroGrid();
+
+	glBindTexture(GL_TEXTURE_3D, mSDFAtlasID);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	int BX = pVolume->getBrickDim(0), BY = pVolume->getBrickDim(1), BZ = pVolume->getBrickDim(2);
+	int lo[3], hi[3];
+	pVolume->getDirtyBox(lo, hi);
+	if (pVolume->mNumDirtyBricks * 2 > BX * BY * BZ)
+	{
+		// 대부분의 브릭이 바뀌었으면 볼륨 전체를 한 번에 올린다.
+		std::vector<float> denseData;
+		if (pVolume->mQuantData.empty())
+			glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, slot.mAtlasZ, pVolume->mDim[0], pVolume->mDim[1], pVolume->mDim[2], GL_RED, GL_FLOAT, pVolume->getDenseData(denseData));
+		else
+			glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, slot.mAtlasZ, pVolume->mDim[0], pVolume->mDim[1], pVolume->mDim[2], GL_RED,
+				(pVolume->mQuantType == DgVolume::QUANT_FLOAT16) ? GL_HALF_FLOAT : GL_BYTE, pVolume->mQuantData.data());
+	}
+	else
+	{
+		// 변경된 브릭을 스테이징 PBO에 빈틈없이 복사하고, 버퍼가 차면 전송 후 다음 버퍼로 넘어간다.
+		size_t brickBytes = (size_t)SDF_BRICK_SIZE * SDF_BRICK_SIZE * SDF_BRICK_SIZE * pVolume->getSampleSize();
+		std::vector<std::pair<int, size_t>> bricks;
+		unsigned char* pStaging = mapSDFStaging();
+		size_t used = 0;
+		for (int b = 0; b < BX * BY * BZ; ++b)
+		{
+			if (!pVolume->mDirtyBricks[b])
+				continue;
+			if (used + brickBytes > SDF_PBO_SIZE)
+			{
+				flushSDFStaging(slot, bricks);
+				bricks.clear();
+				pStaging = mapSDFStaging();
+				used = 0;
+			}
+			bricks.push_back({ b, used });
+			used += pVolume->copyBrick(b % BX, (b / BX) % BY, b / (BX * BY), pStaging + used);
+		}
+		flushSDFStaging(slot, bricks);
+	}
+
+	// 변경된 영역의 영향을 받는 밉 레벨 샘플만 다시 계산하여 올린다.
+	pVolume->updateMipPyramid(lo, hi);
+	uploadSDFMips(slot, lo, hi);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	// 매크로 격자는 작으므로 볼륨의 매크로 영역 전체를 다시 올린다.
+	glBindTexture(GL_TEXTURE_3D, mMacroAtlasID);
+	glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, slot.mMacroZ, pVolume->mMacroDim[0], pVolume->mMacroDim[1], pVolume->mMacroDim[2], GL_RED, GL_FLOAT, pVolume->mMacroData.data());
+	glBindTexture(GL_TEXTURE_3D, 0);
+	pVolume->clearDirty();
+}
+
+void DgScene::uploadSDFMips(const DgSDFSlot& slot, const int lo[3], const int hi[3])
+{
+	// 아틀라스 형식의 반올림이 값을 키우지 않도록 양자화된 볼륨은 텍스처 값으로 변환한 뒤 한 단계 아래로 내려서 올린다.
+	const DgVolume* pVolume = slot.mVolume;
+	DgVolume::TypeQuant type = pVolume->getStorageType();
+	float invScale = (type == DgVolume::QUANT_FLOAT32) ? 1.0f : 1.0f / pVolume->mQuantScale;
+	std::vector<float> region;
+	for (int l = 1; l <= SDF_MIP_LEVELS; ++l)
+	{
+		int mipLo[3], mipHi[3];
+		pVolume->getMipRegion(l, lo, hi, mipLo, mipHi);
+		const int* dim = pVolume->mMipDim[l - 1];
+		const std::vector<float>& data = pVolume->mMipData[l - 1];
+		int nx = mipHi[0] - mipLo[0] + 1, ny = mipHi[1] - mipLo[1] + 1, nz = mipHi[2] - mipLo[2] + 1;
+		if (nx <= 0 || ny <= 0 || nz <= 0)
+			continue;
+
+		region.resize((size_t)nx * ny * nz);
+		for (int k = 0; k < nz; ++k)
+			for (int j = 0; j < ny; ++j)
+				for (int i = 0; i < nx; ++i)
+				{
+					float v = data[(mipLo[0] + i) + (mipLo[1] + j) * dim[0] + (mipLo[2] + k) * dim[0] * dim[1]] * invScale;
+					if (type == DgVolume::QUANT_FLOAT16)
+						v -= ABS(v) / 1024.0f + 1.0f / 16384.0f;
+					else if (type == DgVolume::QUANT_SNORM8)
+						v = MAX(v - 1.0f / 127.0f, -1.0f);
+					region[i + j * nx + k * nx * ny] = v;
+				}
+		glTexSubImage3D(GL_TEXTURE_3D, l, mipLo[0], mipLo[1], (slot.mAtlasZ >> l) + mipLo[2], nx, ny, nz, GL_RED, GL_FLOAT, region.data());
+	}
+}
+
+unsigned char* DgScene::mapSDFStaging()
+{
+	// 처음 호출될 때 PBO 링을 생성한다(ARB_buffer_storage를 지원하면 한 번만 영구 매핑).
+	if (mSDFPBOs[0] == 0)
+	{
+		glGenBuffers(SDF_PBO_RING, mSDFPBOs);
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		for (int i = 0; i < SDF_PBO_RING; ++i)
+		{
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, mSDFPBOs[i]);
+			if (GLEW_ARB_buffer_storage)
+			{
+				glBufferStorage(GL_PIXEL_UNPACK_BUFFER, SDF_PBO_SIZE, nullptr, flags);
+				mSDFPBOPtrs[i] = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, SDF_PBO_SIZE, flags);
+			}
+			else
+				glBufferData(GL_PIXEL_UNPACK_BUFFER, SDF_PBO_SIZE, nullptr, GL_STREAM_DRAW);
+		}
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+
+	// 이 버퍼를 읽는 이전 업로드가 끝날 때까지 기다린다.
+	GLsync& fence = mSDFPBOFences[mSDFPBOIndex];
+	if (fence != nullptr)
+	{
+		glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+	if (mSDFPBOPtrs[mSDFPBOIndex] != nullptr)
+		return (unsigned char*)mSDFPBOPtrs[mSDFPBOIndex];
+
+	// 영구 매핑을 지원하지 않으면 펜스로 동기화했으므로 동기화 없이 매핑한다.
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, mSDFPBOs[mSDFPBOIndex]);
+	void* ptr = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, SDF_PBO_SIZE, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	return (unsigned char*)ptr;
+}
+
+void DgScene::flushSDFStaging(const DgSDFSlot& slot, const std::vector<std::pair<int, size_t>>& bricks)
+{
+	const DgVolume* pVolume = slot.mVolume;
+	GLenum type = (pVolume->getStorageType() == DgVolume::QUANT_FLOAT16) ? GL_HALF_FLOAT : (pVolume->getStorageType() == DgVolume::QUANT_SNORM8) ? GL_BYTE : GL_FLOAT;
+	int BX = pVolume->getBrickDim(0), BY = pVolume->getBrickDim(1);
+
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, mSDFPBOs[mSDFPBOIndex]);
+	if (mSDFPBOPtrs[mSDFPBOIndex] == nullptr)
+		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+	// 브릭마다 PBO의 오프셋에서 아틀라스의 부분 영역으로 전송한다(격자 경계의 브릭은 잘린 크기).
+	for (const std::pair<int, size_t>& brick : bricks)
+	{
+		int b[3] = { brick.first % BX, (brick.first / BX) % BY, brick.first / (BX * BY) }, size[3];
+		for (int a = 0; a < 3; ++a)
+			size[a] = MIN(SDF_BRICK_SIZE, pVolume->mDim[a] - b[a] * SDF_BRICK_SIZE);
+		glTexSubImage3D(GL_TEXTURE_3D, 0, b[0] * SDF_BRICK_SIZE, b[1] * SDF_BRICK_SIZE, slot.mAtlasZ + b[2] * SDF_BRICK_SIZE,
+			size[0], size[1], size[2], GL_RED, type, (const void*)brick.second);
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	// 전송이 끝나면 이 버퍼를 다시 쓸 수 있도록 펜스를 두고 다음 버퍼로 넘어간다.
+	mSDFPBOFences[mSDFPBOIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	mSDFPBOIndex = (mSDFPBOIndex + 1) % SDF_PBO_RING;
+}
+
+void DgScene::updateSDFVolumes(const glm::mat4& viewMat, const glm::mat4& projMat)
+{
+	if (mSDFSlots.empty())
+		return;
+
+	// 볼륨 테이블을 채운다.
+	DgSDFVolumeBlock block;
+	memset(&block, 0, sizeof(block));
+	block.mNumVolumes = NUM(mSDFSlots);
+	for (int i = 0; i < block.mNumVolumes; ++i)
+	{
+		const DgVolume* pVolume = mSDFSlots[i].mVolume;
+		const glm::mat4& M = pVolume->mModelMat;
+		DgSDFVolumeEntry& e = block.mVolumes[i];
+		e.mInvModel = glm::inverse(M);
+
+		// 격자 공간의 거리에 곱하면 월드 거리를 넘지 않도록 가장 작은 축 스케일을 사용한다.
+		float scale = MIN(glm::length(glm::vec3(M[0])), MIN(glm::length(glm::vec3(M[1])), glm::length(glm::vec3(M[2]))));
+		e.mBoundsMin = glm::vec4((float)pVolume->mMin[0], (float)pVolume->mMin[1], (float)pVolume->mMin[2], scale);
+		e.mBoundsMax = glm::vec4((float)pVolume->mMax[0], (float)pVolume->mMax[1], (float)pVolume->mMax[2], 0.0f);
+		e.mAtlasOffset = glm::vec4(0.0f, 0.0f, (float)mSDFSlots[i].mAtlasZ, 0.0f);
+		e.mDim = glm::vec4((float)pVolume->mDim[0], (float)pVolume->mDim[1], (float)pVolume->mDim[2], pVolume->mQuantData.empty() ? 1.0f : pVolume->mQuantScale);
+		e.mMacroOffset = glm::vec4(0.0f, 0.0f, (float)mSDFSlots[i].mMacroZ, 0.0f);
+	}
+
+	if (mSDFUBO == 0)
+	{
+		glGenBuffers(1, &mSDFUBO);
+		glBindBuffer(GL_UNIFORM_BUFFER, mSDFUBO);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(DgSDFVolumeBlock), nullptr, GL_DYNAMIC_DRAW);
+		glBindBufferBase(GL_UNIFORM_BUFFER, SDF_UBO_BINDING, mSDFUBO);
+	}
+	glBindBuffer(GL_UNIFORM_BUFFER, mSDFUBO);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(DgSDFVolumeBlock), &block);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	// 볼륨 AABB의 화면 투영 사각형이 겹치는 타일에 볼륨 비트를 기록한다.
+	int W = MAX(1, (int)mSceneSize[0]), H = MAX(1, (int)mSceneSize[1]);
+	int tileDim[2] = { (W + SDF_TILE_SIZE - 1) / SDF_TILE_SIZE, (H + SDF_TILE_SIZE - 1) / SDF_TILE_SIZE };
+	mTileMask.assign(tileDim[0] * tileDim[1], 0u);
+	glm::mat4 viewProj = projMat * viewMat;
+	for (int i = 0; i < block.mNumVolumes; ++i)
+	{
+		const DgVolume* pVolume = mSDFSlots[i].mVolume;
+		glm::mat4 MVP = viewProj * pVolume->mModelMat;
+		float xmin = FLT_MAX, ymin = FLT_MAX, xmax = -FLT_MAX, ymax = -FLT_MAX;
+		bool behind = false;
+		for (int c = 0; c < 8; ++c)
+		{
+			glm::vec4 corner((float)((c & 1) ? pVolume->mMax[0] : pVolume->mMin[0]),
+				(float)((c & 2) ? pVolume->mMax[1] : pVolume->mMin[1]),
+				(float)((c & 4) ? pVolume->mMax[2] : pVolume->mMin[2]), 1.0f);
+			glm::vec4 clip = MVP * corner;
+			if (clip.w <= 1.0e-4f)
+			{
+				behind = true;	// 카메라 뒤의 꼭짓점이 있으면 화면 전체를 덮는다고 가정
+				break;
+			}
+			float x = (clip.x / clip.w * 0.5f + 0.5f) * W;
+			float y = (clip.y / clip.w * 0.5f + 0.5f) * H;
+			xmin = MIN(xmin, x); xmax = MAX(xmax, x);
+			ymin = MIN(ymin, y); ymax = MAX(ymax, y);
+		}
+		if (behind)
+		{
+			xmin = ymin = 0.0f;
+			xmax = (float)W;
+			ymax = (float)H;
+		}
+		if (xmax < 0.0f || ymax < 0.0f || xmin >= W || ymin >= H)
+			continue;
+
+		int tx0 = MAX(0, (int)xmin / SDF_TILE_SIZE), tx1 = MIN(tileDim[0] - 1, (int)xmax / SDF_TILE_SIZE);
+		int ty0 = MAX(0, (int)ymin / SDF_TILE_SIZE), ty1 = MIN(tileDim[1] - 1, (int)ymax / SDF_TILE_SIZE);
+		for (int ty = ty0; ty <= ty1; ++ty)
+			for (int tx = tx0; tx <= tx1; ++tx)
+				mTileMask[tx + ty * tileDim[0]] |= (1u << i);
+	}
+
+	// 타일 마스크를 업로드한다(화면 크기가 바뀐 경우에만 텍스처를 다시 할당).
+	if (mTileMaskID == 0)
+	{
+		glGenTextures(1, &mTileMaskID);
+		glBindTexture(GL_TEXTURE_2D, mTileMaskID);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	}
+	glBindTexture(GL_TEXTURE_2D, mTileMaskID);
+	if (tileDim[0] != mTileDim[0] || tileDim[1] != mTileDim[1])
+	{
+		mTileDim[0] = tileDim[0];
+		mTileDim[1] = tileDim[1];
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, tileDim[0], tileDim[1], 0, GL_RED_INTEGER, GL_UNSIGNED_INT, mTileMask.data());
+	}
+	else
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, tileDim[0], tileDim[1], GL_RED_INTEGER, GL_UNSIGNED_INT, mTileMask.data());
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void DgScene::renderSDFVolumes()
+{
+	if (mSDFSlots.empty() || mSDFAtlasID == 0)
+		return;
+
+	// 정점 버퍼 없이 gl_VertexID로 전체 화면 삼각형을 만든다(코어 프로파일은 VAO 바인딩이 필요).
+	if (mSDFPassVAO == 0)
+		glGenVertexArrays(1, &mSDFPassVAO);
+
+	const DgShader& shader = DgShader::get(mShaders[10]);
+	glUseProgram(shader.mId);
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_3D, mSDFAtlasID);
+	glUniform1i(shader.getLoc(DgShader::UNIFORM_SDF_ATLAS), 0);
+
+	// 빈 공간 건너뛰기용 매크로 셀 아틀라스
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_3D, mMacroAtlasID);
+	glUniform1i(shader.getLoc(DgShader::UNIFORM_MACRO_ATLAS), 1);
+	glUniform1f(shader.getLoc(DgShader::UNIFORM_MACRO_SIZE), (float)SDF_MACRO_SIZE);
+
+	// 타일별 볼륨 마스크
+	glActiveTexture(GL_TEXTURE2);
+	glBindTexture(GL_TEXTURE_2D, mTileMaskID);
+	glUniform1i(shader.getLoc(DgShader::UNIFORM_TILE_MASK), 2);
+	glUniform1i(shader.getLoc(DgShader::UNIFORM_TILE_SIZE), SDF_TILE_SIZE);
+	glUniform1i(shader.getLoc(DgShader::UNIFORM_SDF_MAX_LOD), SDF_MIP_LEVELS);
+	glUniform1i(shader.getLoc(DgShader::UNIFORM_DEBUG_STEPS), mShowStepHeatmap ? 1 : 0);
+
+	glBindVertexArray(mSDFPassVAO);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	glBindVertexArray(0);
+	mNumDrawCalls++;
+	mNumStateChanges += 5;
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_3D, 0);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_3D, 0);
+	glUseProgram(0);
+}
+
+DgMesh* DgScene::addMeshInstance(const char* fname, const glm::mat4& mat)
+{
+	// 파일마다 메쉬는 한 번만 임포트하여 장면에 추가하고
+	DgMesh*& pMesh = mInstancedMeshes[fname];
+	if (pMesh == nullptr)
+	{
+		pMesh = import_mesh_obj(fname);
+		if (pMesh == nullptr)
+		{
+			mInstancedMeshes.erase(fname);
+			return nullptr;
+		}
+		pMesh->mName = std::filesystem::path(fname).stem().string();
+		pMesh->mShaderId = mShaders[2];
+		mMeshList.push_back(pMesh);
+	}
+
+	// 같은 기하 정보에 인스턴스 변환만 추가한다(재질별 한 번의 glDrawElementsInstanced로 그려짐).
+	pMesh->addInstance(mat);
+	return pMesh;
+}
+
 void DgScene::addSDFVolume(DgVolume* volume)
 {
 	mSDFList.push_back(volume);
@@ -2,6 +2,84 @@
 #include "DgViewer.h"
 
 class DgVolume;
+class DgBvh;
+
+// 한 번의 레이마칭 패스로 그리는 최대 SDF 볼륨 개수(타일 마스크의 비트 수)
+#define MAX_SDF_VOLUMES 32
+
+// 변경된 SDF 브릭을 올리는 스테이징 PBO 링의 버퍼 개수와 버퍼 하나의 크기(byte)
+#define SDF_PBO_RING 3
+#define SDF_PBO_SIZE (4 << 20)
+
+/*!
+ *	\struct	DgCameraBlock
+ *	\brief	쉐이더의 CameraBlock 유니폼 버퍼와 같은 std140 배치의 프레임별 카메라/조명 데이터
+ */
+struct DgCameraBlock
+{
+	glm::mat4 mView;		// 관측 변환 행렬
+	glm::mat4 mProj;		// 투영 변환 행렬
+	glm::mat4 mInvView;		// 관측 변환의 역행렬
+	glm::mat4 mInvProj;		// 투영 변환의 역행렬
+	glm::vec3 mViewPos;		// 카메라 위치
+	float mTime;			// 시간
+	glm::vec3 mLightPos;	// 광원 위치
+	float mPad0;
+	glm::vec3 mLightColor;	// 광원 색
+	float mPad1;
+	glm::vec2 mResolution;	// 화면 해상도
+	float mPad2[2];
+};
+
+/*!
+ *	\struct	DgSDFVolumeEntry
+ *	\brief	쉐이더의 SDFVolumeBlock에 저장되는 볼륨별 변환 및 아틀라스 정보(std140 배치)
+ */
+struct DgSDFVolumeEntry
+{
+	glm::mat4 mInvModel;	// 월드 좌표 → 볼륨 격자 공간 변환
+	glm::vec4 mBoundsMin;	// xyz: 격자 공간 최소점, w: 격자 공간 거리 → 월드 거리 배율
+	glm::vec4 mBoundsMax;	// xyz: 격자 공간 최대점
+	glm::vec4 mAtlasOffset;	// xyz: SDF 아틀라스 안의 시작 텍셀
+	glm::vec4 mDim;			// xyz: 볼륨 해상도, w: 텍스처 값 → 부호거리 배율(양자화된 볼륨의 대역 거리)
+	glm::vec4 mMacroOffset;	// xyz: 매크로 아틀라스 안의 시작 셀
+};
+
+/*!
+ *	\struct	DgSDFVolumeBlock
+ *	\brief	쉐이더의 SDFVolumeBlock 유니폼 버퍼와 같은 std140 배치의 볼륨 테이블
+ */
+struct DgSDFVolumeBlock
+{
+	DgSDFVolumeEntry mVolumes[MAX_SDF_VOLUMES];
+	int mNumVolumes;
+	int mPad[3];
+};
+
+/*!
+ *	\struct	DgSDFSlot
+ *	\brief	SDF 아틀라스에 배치된 볼륨과 배치 위치(볼륨은 z 방향으로 쌓아서 배치)
+ */
+struct DgSDFSlot
+{
+	DgVolume* mVolume;		// 배치된 볼륨
+	int mAtlasZ;			// SDF 아틀라스에서 볼륨이 시작하는 z 텍셀
+	int mMacroZ;			// 매크로 아틀라스에서 볼륨이 시작하는 z 셀
+	int mDim[3];			// 배치할 때의 볼륨 해상도
+	int mMacroDim[3];		// 배치할 때의 매크로 격자 해상도
+	int mStorageType;		// 배치할 때의 볼륨 저장 형식(DgVolume::TypeQuant)
+};
+
+/*!
+ *	\struct	DgDrawItem
+ *	\brief	렌더 큐에 들어가는 재질 단위의 그리기 항목
+ */
+struct DgDrawItem
+{
+	unsigned long long mKey;	// 정렬 키: (쉐이더, 텍스처, VAO, 재질) 순서로 16비트씩
+	DgMesh* mMesh;				// 그릴 메쉬
+	int mMtlIdx;				// 그릴 재질 인덱스
+};
 
 class DgScene
 {
@@ -17,15 +95,52 @@ public:
 	std::vector<DgMesh*> mMeshList;
 	std::vector<GLuint> mShaders;
 
-	// ȭ   
+	// 화면 조작을 위한 변수
 	float mZoom;
 	ImVec2 mStartPos;
 	glm::mat4 mRotMat;
 	glm::vec3 mPan;
 
+	// 마우스 피킹을 위한 변수
+	glm::mat4 mViewMat;						// 마지막으로 렌더링한 프레임의 관측 변환 행렬
+	glm::mat4 mProjMat;						// 마지막으로 렌더링한 프레임의 투영 변환 행렬
+	std::map<DgMesh*, DgBvh*> mPickBvhs;	// 메쉬별 피킹용 BVH(처음 피킹할 때 생성)
+	DgMesh* mPickMesh = nullptr;			// 피킹된 메쉬
+	int mPickFace = -1;						// 피킹된 삼각형의 인덱스
+	int mPickInstance = -1;					// 피킹된 인스턴스의 인덱스(mInstMats의 인덱스, 인스턴스가 없으면 0)
+	DgPos mPickPos;							// 피킹된 점의 위치
+
+	// 모든 쉐이더가 공유하는 프레임별 카메라 유니폼 버퍼
+	GLuint mCameraUBO = 0;
+
+	// 레이마칭 스텝 수를 색으로 표시하는 디버그 모드
+	bool mShowStepHeatmap = false;
+
+	// 인스턴싱으로 그리는 공유 메쉬: (파일 이름, mMeshList에 포함된 메쉬)
+	std::map<std::string, DgMesh*> mInstancedMeshes;
+
+	// 상태 변경을 줄이기 위해 정렬하여 그리는 렌더 큐와 프레임별 통계
+	std::vector<DgDrawItem> mRenderQueue;
+	int mNumDrawCalls = 0;					// 지난 프레임의 그리기 호출 횟수
+	int mNumStateChanges = 0;				// 지난 프레임의 쉐이더, VAO, 텍스처 바인딩 횟수
+
 private:
-	GLuint mSDFID = 0; // ؽó ID
-	std::vector<DgVolume*> mSDFList; //DgVolume ü  Ʈ
+	GLuint mSDFAtlasID = 0; //모든 볼륨을 담는 SDF 아틀라스 텍스처 ID
+	GLuint mMacroAtlasID = 0; //빈 공간 건너뛰기용 매크로 셀 최소 거리 아틀라스 텍스처 ID
+	int mAtlasDim[3] = { 0, 0, 0 }; //SDF 아틀라스 해상도
+	int mMacroAtlasDim[3] = { 0, 0, 0 }; //매크로 아틀라스 해상도
+	GLenum mAtlasFormat = 0; //SDF 아틀라스 내부 형식
+	GLuint mSDFPBOs[SDF_PBO_RING] = { 0 }; //변경된 브릭을 올리는 스테이징 PBO 링
+	void* mSDFPBOPtrs[SDF_PBO_RING] = { nullptr }; //영구 매핑된 PBO 주소(ARB_buffer_storage를 지원하는 경우)
+	GLsync mSDFPBOFences[SDF_PBO_RING] = { nullptr }; //PBO를 읽는 업로드가 끝났는지 확인하는 펜스
+	int mSDFPBOIndex = 0; //다음에 사용할 PBO
+	std::vector<DgSDFSlot> mSDFSlots; //아틀라스에 배치된 볼륨 목록
+	GLuint mSDFUBO = 0; //볼륨별 변환 및 아틀라스 정보 유니폼 버퍼
+	GLuint mTileMaskID = 0; //화면 타일별로 겹치는 볼륨 비트 마스크 텍스처 ID
+	int mTileDim[2] = { 0, 0 }; //타일 마스크 해상도
+	std::vector<unsigned int> mTileMask; //타일 마스크 CPU 버퍼
+	GLuint mSDFPassVAO = 0; //전체 화면 레이마칭 패스용 빈 VAO
+	std::vector<DgVolume*> mSDFList; //DgVolume 객체 관리 리스트
 	DgScene()
 	{
 		mOpen = true;
@@ -35,23 +150,10 @@ private:
 		mRotMat = glm::rotate(mRotMat, glm::radians(30.0f), glm::vec3(1, 0, 0)); // pitch
 		mRotMat = glm::rotate(mRotMat, glm::radians(60.0f), glm::vec3(0, 1, 0)); // yaw
 		mPan = glm::vec3(0.0f);
+		mViewMat = glm::mat4(1.0f);
+		mProjMat = glm::mat4(1.0f);
 	}
-	~DgScene()
-	{
-		if (mSDFID != 0)
-			glDeleteTextures(1, &mSDFID);
-		for (DgVolume* v : mSDFList)
-			delete v;
-
-		glDeleteVertexArrays(1, &mGroundVAO);
-		glDeleteBuffers(1, &mGroundVBO);
-
-		for (DgMesh* m : mMeshList)
-			delete m;
-		
-		for (GLuint id : mShaders)
-			glDeleteProgram(id);
-	}
+	~DgScene();
 	
 
 public:
@@ -68,20 +170,33 @@ public:
 		return mOpen;
 	}
 
-	void initOpenGL() {						// OpenGL ʱ 
+	void initOpenGL() {						// OpenGL 초기 설정
 		glEnable(GL_DEPTH_TEST);
 		glEnable(GL_CULL_FACE);
 		glCullFace(GL_BACK);
 	}
 
-	void createGroundMesh();				// ٴ  ޽ 
-	void getSphereCoords(double x, double y, float* px, float* py, float* pz);		//  ǥ 
-	void showWindow();																// SceneGL  
-	void renderScene();																//  
-	void renderFps();																// FPS 
-	void renderContextPopup();														// ؽƮ ˾ 
-	void processMouseEvent();														// 콺 ̺Ʈ ó
-	void processKeyboardEvent();	// Ű ̺Ʈ ó
-	void createSDF(DgVolume &volume);
+	void createGroundMesh();				// 바닥 평면 메쉬 생성
+	void getSphereCoords(double x, double y, float* px, float* py, float* pz);		// 구면 좌표 계산
+	void showWindow();																// SceneGL 윈도우 출력
+	void renderScene();																// 장면 렌더링
+	void updateCameraBlock(const glm::mat4& viewMat, const glm::mat4& projMat);	// 프레임별 카메라 유니폼 버퍼 갱신
+	void renderMeshes();															// 렌더 큐를 정렬하여 메쉬 렌더링
+	void renderFps();																// FPS 렌더링
+	void renderContextPopup();														// 컨텍스트 팝업 렌더링
+	void processMouseEvent();														// 마우스 이벤트 처리
+	void processKeyboardEvent();	// 키보드 이벤트 처리
+	bool pickMesh(float x, float y);																// 화면 좌표 (x, y)의 메쉬 피킹
+	DgMesh* addMeshInstance(const char* fname, const glm::mat4& mat);				// 공유 메쉬의 인스턴스 추가
+	void createSDF(DgVolume &volume);												// 볼륨 전체를 변경된 것으로 표시하고 SDF 아틀라스에 반영
 	void addSDFVolume(DgVolume* volume);
+	DgVolume* getActiveSDFVolume() { return mSDFList.empty() ? nullptr : mSDFList.back(); }	// 속성 윈도우에서 편집할 볼륨(마지막으로 추가된 볼륨)
+	void syncSDFAtlas();															// 볼륨 구성이 바뀌면 아틀라스를 다시 구성하고, 아니면 변경된 브릭만 업로드
+	void buildSDFAtlas();															// 모든 볼륨을 SDF 아틀라스와 매크로 아틀라스에 배치하여 업로드
+	void uploadDirtyBricks(const DgSDFSlot& slot);									// 볼륨의 변경된 브릭을 스테이징 PBO 링을 거쳐 아틀라스에 업로드
+	unsigned char* mapSDFStaging();													// 다음 스테이징 PBO를 쓰기 가능한 상태로 반환
+	void flushSDFStaging(const DgSDFSlot& slot, const std::vector<std::pair<int, size_t>>& bricks);	// 스테이징 PBO에 복사한 브릭을 아틀라스로 전송
+	void uploadSDFMips(const DgSDFSlot& slot, const int lo[3], const int hi[3]);	// 레벨 0의 샘플 박스에 해당하는 밉 레벨 영역을 아틀라스에 업로드
+	void updateSDFVolumes(const glm::mat4& viewMat, const glm::mat4& projMat);	// 볼륨 테이블과 타일별 볼륨 마스크 갱신
+	void renderSDFVolumes();														// 모든 볼륨을 한 번의 전체 화면 패스로 레이마칭
 };
@@ -2,7 +2,7 @@
 
 /*!
  *	\class	DgSweep
- *	\brief	DgSweep  Ŭ
+ *	\brief	DgSweep 관련 클래스
  */
 class DgSweep
 {
@@ -10,17 +10,22 @@
 #include <map>
 #include <queue>
 #include <numeric>
+#include <charconv>
+#include <memory>
+#include <unordered_map>
+#include <omp.h>
+#include <emmintrin.h>
 
-// GLEW/GLFW   
+// GLEW/GLFW 관련 헤더 파일
 #include "./include/gl/glew.h"
 #include "./include/glfw/glfw3.h"
 
-// GLM   
+// GLM 관려 헤더 파일
 #include "./include/glm/glm.hpp"
 #include "./include/glm/gtc/matrix_transform.hpp"
 #include "./include/glm/gtc/type_ptr.hpp"
 
-// IMGUI   
+// IMGUI 관련 헤더 파일
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include "./include/ImGui/imgui.h"
 #include "./include/ImGui/imgui_internal.h"
@@ -29,7 +34,7 @@
 #include "./include/ImGui/imgui_file_dlg.h"
 #include "./include/ImGui/imgui_console.h"
 
-// ü  
+// 자체 헤더 파일
 #include "ImGuiManager.h"
 #include "DgMesh.h"
 #include "DgVolume.h"
@@ -39,19 +44,29 @@
 #include "DgBoolean.h"
 #include "DgBvh.h"
 
-// Window cpp  Լ
+// Window관련 cpp에서 구현된 함수
 void ShowWindowToolBar(bool* p_open);
 void ShowWindowSceneLayer(bool* p_open);
 void ShowWindowModelProperty(bool* p_open);
 
-//   
+// 전역 변수 선언
 extern bool show_window_tool_bar;
 extern bool show_window_scene_layer;
 extern bool show_window_model_property;
 
-// ũ 
+// 매크로 정의
 #define MTYPE_EPS	1.0e-6
 #define MAX_BVH_DEPTH 10
+#define MAX_BVH_LEAF_SIZE 4
+#define NUM_SAH_BINS 16
+#define BVH_STACK_SIZE 256
+#define BVH_BATCH_SIZE 256
+#define BVH_PACKET_SIZE 8
+#define BVH_LBVH_THRESHOLD 1000000
+#define VERTEX_CACHE_SIZE 16
+#define CAMERA_UBO_BINDING 0
+#define SDF_UBO_BINDING 1
+#define SDF_TILE_SIZE 16
 #define RAD2DEG(X)	((X) * 57.29577951308232)
 #define M_PI       3.14159265358979323846
 
@@ -64,10 +79,10 @@ extern bool show_window_model_property;
 #define EQ(X, Y, EPS)	(ABS((X) - (Y)) < EPS)
 #define EQ_ZERO(X, EPS) (ABS(X) < EPS)
 
-//    ϴ ũ
+// 벡터의 원소의 개수를 구하는 매크로
 #define NUM(List) ((int)(List.size()))
 
-//  E     ϴ ũ
+// 에지 E의 시작 정점과 끝 정점을 구하는 매크로
 #define SV(E)	(E)->mVert
 #define EV(E)	(E)->mNext->mVert
 #define SP(E)	(E)->mVert->mPos
@@ -76,6 +91,6 @@ extern bool show_window_model_property;
 #define PREV(E)	(E)->mNext->mNext
 #define MATE(E)	(E)->mMate
 
-//  E1, E2 Ʈ  Ȯϴ ũ
+// 에지 E1, E2가 메이트 에지인지를 확인하는 매크로
 #define IS_MATE_EDGE(E1, E2) (((E1)->mVert) == ((E2)->mNext->mVert))
 
@@ -1,5 +1,188 @@
 #include "DgViewer.h"
 
+// 양자화 인코딩/디코딩을 스레드에 나누어 줄 블록 크기(샘플 개수)
+#define QUANT_BLOCK_SIZE 4096
+
+/*!
+*	@brief	[-1, 1] 범위의 실수를 반정밀도(half) 비트로 변환(가수는 짝수 반올림)
+*	@note	반정밀도 정규수보다 작은 크기는 0으로 저장한다.
+*/
+static inline unsigned short float_to_half(float f)
+{
+	unsigned int x;
+	memcpy(&x, &f, sizeof(x));
+	unsigned int sign = (x >> 16) & 0x8000u;
+	unsigned int absx = x & 0x7fffffffu;
+	unsigned int h = ((absx + 0x00000fffu + ((absx >> 13) & 1u)) >> 13) - (112u << 10);	// 지수 바이어스 127 -> 15
+	h = (absx < 0x38800000u) ? 0u : h;
+	return (unsigned short)(sign | h);
+}
+
+/*!
+*	@brief	float_to_half로 저장한 반정밀도 비트를 실수로 복원
+*/
+static inline float half_to_float(unsigned short h)
+{
+	unsigned int bits = ((unsigned int)(h & 0x7fffu) << 13) + (112u << 23);
+	bits = ((h & 0x7c00u) == 0) ? 0u : bits;
+	bits |= (unsigned int)(h & 0x8000u) << 16;
+	float f;
+	memcpy(&f, &bits, sizeof(f));
+	return f;
+}
+
+/*!
+*	@brief	8비트 부호 정규화 정수를 실수로 복원(OpenGL의 SNORM 변환 규칙과 동일)
+*/
+static inline float snorm8_to_float(signed char c)
+{
+	return MAX(c / 127.0f, -1.0f);
+}
+
+/*!
+*	@brief	SSE2로 4개씩 부호거리를 정규화하여 half로 인코딩
+*
+*	@param	in[in]		부호거리 배열
+*	@param	out[out]	half 비트 배열
+*	@param	n[in]		샘플 개수
+*	@param	band[in]	대역 거리(정규화 배율)
+*
+*	@return	대역 안의 샘플에 대한 최대 복원 오차를 반환
+*/
+static float encode_half(const float* in, unsigned short* out, int n, float band)
+{
+	const __m128 vInvBand = _mm_set1_ps(1.0f / band), vBand = _mm_set1_ps(band);
+	const __m128 vOne = _mm_set1_ps(1.0f), vMinusOne = _mm_set1_ps(-1.0f);
+	const __m128 vAbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+	const __m128i vOne32 = _mm_set1_epi32(1), vRound = _mm_set1_epi32(0x0fff), vBias = _mm_set1_epi32(112 << 10);
+	const __m128i vSignMask = _mm_set1_epi32(0x8000), vMinNormal = _mm_set1_epi32(0x38800000);
+	const __m128i vMant = _mm_set1_epi32(0x7fff), vExpBias = _mm_set1_epi32(112 << 23), vExp = _mm_set1_epi32(0x7c00);
+	__m128 vErr = _mm_setzero_ps();
+
+	int i = 0;
+	for (; i + 4 <= n; i += 4)
+	{
+		// 인코딩
+		__m128 d = _mm_loadu_ps(in + i);
+		__m128i x = _mm_castps_si128(_mm_min_ps(_mm_max_ps(_mm_mul_ps(d, vInvBand), vMinusOne), vOne));
+		__m128i sign = _mm_and_si128(_mm_srli_epi32(x, 16), vSignMask);
+		__m128i absx = _mm_and_si128(x, _mm_castps_si128(vAbsMask));
+		__m128i lsb = _mm_and_si128(_mm_srli_epi32(absx, 13), vOne32);
+		__m128i h = _mm_sub_epi32(_mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(absx, vRound), lsb), 13), vBias);
+		h = _mm_andnot_si128(_mm_cmplt_epi32(absx, vMinNormal), h);
+		h = _mm_or_si128(h, sign);
+
+		// 부호 확장 후 16비트로 묶어서 저장
+		__m128i h16 = _mm_srai_epi32(_mm_slli_epi32(h, 16), 16);
+		_mm_storel_epi64((__m128i*)(out + i), _mm_packs_epi32(h16, h16));
+
+		// 디코딩하여 대역 안의 오차를 누적
+		__m128i bits = _mm_add_epi32(_mm_slli_epi32(_mm_and_si128(h, vMant), 13), vExpBias);
+		bits = _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(h, vExp), _mm_setzero_si128()), bits);
+		bits = _mm_or_si128(bits, _mm_slli_epi32(sign, 16));
+		__m128 err = _mm_and_ps(_mm_sub_ps(_mm_mul_ps(_mm_castsi128_ps(bits), vBand), d), vAbsMask);
+		__m128 inBand = _mm_cmplt_ps(_mm_and_ps(d, vAbsMask), vBand);
+		vErr = _mm_max_ps(vErr, _mm_and_ps(err, inBand));
+	}
+
+	float errs[4];
+	_mm_storeu_ps(errs, vErr);
+	float maxErr = MAX(MAX(errs[0], errs[1]), MAX(errs[2], errs[3]));
+	for (; i < n; ++i)
+	{
+		out[i] = float_to_half(MIN(MAX(in[i] / band, -1.0f), 1.0f));
+		if (ABS(in[i]) < band)
+			maxErr = MAX(maxErr, ABS(half_to_float(out[i]) * band - in[i]));
+	}
+	return maxErr;
+}
+
+/*!
+*	@brief	SSE2로 4개씩 half를 부호거리로 디코딩
+*/
+static void decode_half(const unsigned short* in, float* out, int n, float scale)
+{
+	const __m128 vScale = _mm_set1_ps(scale);
+	const __m128i vMant = _mm_set1_epi32(0x7fff), vExpBias = _mm_set1_epi32(112 << 23);
+	const __m128i vExp = _mm_set1_epi32(0x7c00), vSignMask = _mm_set1_epi32(0x8000);
+
+	int i = 0;
+	for (; i + 4 <= n; i += 4)
+	{
+		__m128i h = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)(in + i)), _mm_setzero_si128());
+		__m128i bits = _mm_add_epi32(_mm_slli_epi32(_mm_and_si128(h, vMant), 13), vExpBias);
+		bits = _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(h, vExp), _mm_setzero_si128()), bits);
+		bits = _mm_or_si128(bits, _mm_slli_epi32(_mm_and_si128(h, vSignMask), 16));
+		_mm_storeu_ps(out + i, _mm_mul_ps(_mm_castsi128_ps(bits), vScale));
+	}
+	for (; i < n; ++i)
+		out[i] = half_to_float(in[i]) * scale;
+}
+
+/*!
+*	@brief	SSE2로 4개씩 부호거리를 정규화하여 8비트 부호 정규화 정수로 인코딩
+*
+*	@return	대역 안의 샘플에 대한 최대 복원 오차를 반환
+*/
+static float encode_snorm8(const float* in, signed char* out, int n, float band)
+{
+	const __m128 vInvBand = _mm_set1_ps(1.0f / band), vBand = _mm_set1_ps(band);
+	const __m128 vOne = _mm_set1_ps(1.0f), vMinusOne = _mm_set1_ps(-1.0f);
+	const __m128 v127 = _mm_set1_ps(127.0f), vInv127 = _mm_set1_ps(1.0f / 127.0f);
+	const __m128 vAbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+	__m128 vErr = _mm_setzero_ps();
+
+	int i = 0;
+	for (; i + 4 <= n; i += 4)
+	{
+		// 짝수 반올림으로 정수 변환 후 8비트로 묶어서 저장
+		__m128 d = _mm_loadu_ps(in + i);
+		__m128 x = _mm_min_ps(_mm_max_ps(_mm_mul_ps(d, vInvBand), vMinusOne), vOne);
+		__m128i c = _mm_cvtps_epi32(_mm_mul_ps(x, v127));
+		__m128i c16 = _mm_packs_epi32(c, c);
+		int packed = _mm_cvtsi128_si32(_mm_packs_epi16(c16, c16));
+		memcpy(out + i, &packed, 4);
+
+		// 디코딩하여 대역 안의 오차를 누적
+		__m128 dec = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(c), vInv127), vMinusOne);
+		__m128 err = _mm_and_ps(_mm_sub_ps(_mm_mul_ps(dec, vBand), d), vAbsMask);
+		__m128 inBand = _mm_cmplt_ps(_mm_and_ps(d, vAbsMask), vBand);
+		vErr = _mm_max_ps(vErr, _mm_and_ps(err, inBand));
+	}
+
+	float errs[4];
+	_mm_storeu_ps(errs, vErr);
+	float maxErr = MAX(MAX(errs[0], errs[1]), MAX(errs[2], errs[3]));
+	for (; i < n; ++i)
+	{
+		out[i] = (signed char)lrintf(MIN(MAX(in[i] / band, -1.0f), 1.0f) * 127.0f);
+		if (ABS(in[i]) < band)
+			maxErr = MAX(maxErr, ABS(snorm8_to_float(out[i]) * band - in[i]));
+	}
+	return maxErr;
+}
+
+/*!
+*	@brief	SSE2로 4개씩 8비트 부호 정규화 정수를 부호거리로 디코딩
+*/
+static void decode_snorm8(const signed char* in, float* out, int n, float scale)
+{
+	const __m128 vScale = _mm_set1_ps(scale / 127.0f), vMin = _mm_set1_ps(-scale);
+
+	int i = 0;
+	for (; i + 4 <= n; i += 4)
+	{
+		int packed;
+		memcpy(&packed, in + i, 4);
+		__m128i c = _mm_cvtsi32_si128(packed);
+		c = _mm_unpacklo_epi8(c, c);
+		c = _mm_srai_epi32(_mm_unpacklo_epi16(c, c), 24);	// 8비트 부호 확장
+		_mm_storeu_ps(out + i, _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(c), vScale), vMin));
+	}
+	for (; i < n; ++i)
+		out[i] = snorm8_to_float(in[i]) * scale;
+}
+
 DgVolume::DgVolume()
 {
 	mMesh = nullptr;
@@ -45,6 +228,13 @@ DgVolume::DgVolume(DgVolume& cpy)
 	mSpacing[0] = cpy.mSpacing[0];
 	mSpacing[1] = cpy.mSpacing[1];
 	mSpacing[2] = cpy.mSpacing[2];
+
+	mNumThreads = cpy.mNumThreads;
+	mBandWidth = cpy.mBandWidth;
+	mSparse = cpy.mSparse;
+	mSignType = cpy.mSignType;
+	mQuantType = cpy.mQuantType;
+	mClampBand = cpy.mClampBand;
 }
 DgVolume::~DgVolume()
 {
@@ -57,18 +247,19 @@ void DgVolume::setDimensions(int dimX, int dimY, int dimZ)
 	mDim[0] = dimX;
 	mDim[1] = dimY;
 	mDim[2] = dimZ;
+	markAllDirty();
 }
 
 /*!
-*	@brief	Է ޽   (AABB)
+*	@brief	입력 메쉬의 격자 공간을 정의(AABB)
 *
-*	@param	DgMesh& mesh	Է  ޽
-*	@param	padding[in]		  ߰ е  (⺻: 0.1f)
+*	@param	DgMesh& mesh	입력 받은 메쉬
+*	@param	padding[in]		격자 공간에 추가할 패딩 비율 (기본값: 0.1f)
 *
 */
 void DgVolume::setGridSpace(const DgMesh& mesh, float padding)
 {
-	// Է ޽ AABB 
+	// 입력 메쉬의 AABB 계산
 	DgPos minPos(mesh.mVerts[0].mPos[0], mesh.mVerts[0].mPos[1], mesh.mVerts[0].mPos[2]);
 	DgPos maxPos(mesh.mVerts[0].mPos[0], mesh.mVerts[0].mPos[1], mesh.mVerts[0].mPos[2]);
 	for (const DgVertex& v : mesh.mVerts) {
@@ -79,121 +270,1276 @@ void DgVolume::setGridSpace(const DgMesh& mesh, float padding)
 		if (v.mPos[1] > maxPos.mPos[1]) maxPos.mPos[1] = v.mPos[1];
 		if (v.mPos[2] > maxPos.mPos[2]) maxPos.mPos[2] = v.mPos[2];
 	}
-	// е 
+	// 패딩 적용
 	double paddingX = (maxPos.mPos[0] - minPos.mPos[0]) * padding;
 	double paddingY = (maxPos.mPos[1] - minPos.mPos[1]) * padding;
 	double paddingZ = (maxPos.mPos[2] - minPos.mPos[2]) * padding;
 
-	//   
+	// 격자 공간 설정
 	mMin = DgPos(minPos.mPos[0] - paddingX, minPos.mPos[1] - paddingY, minPos.mPos[2] - paddingZ);
 	mMax = DgPos(maxPos.mPos[0] + paddingX, maxPos.mPos[1] + paddingY, maxPos.mPos[2] + paddingZ);
 
-	//  ػ󵵿    
+	// 격자 해상도에 따라 격자 간격 계산
 	mSpacing[0] = (mMax.mPos[0] - mMin.mPos[0]) / (mDim[0] - 1);
 	mSpacing[1] = (mMax.mPos[1] - mMin.mPos[1]) / (mDim[1] - 1); 
 	mSpacing[2] = (mMax.mPos[2] - mMin.mPos[2]) / (mDim[2] - 1);
 }
 
 /*!
-*	@brief	 ÿ Ͽ ȣŸ  mData 
+*	@brief	격자 샘플에 대하여 부호거리 값을 mData에 저장
+*	@note	메쉬에 대한 BVH를 한 번만 생성하고, 격자를 SDF_BRICK_SIZE^3 크기의 브릭으로 나누어
+*			mNumThreads개의 스레드가 브릭 단위로 동적 분배(dynamic schedule)하여 계산
+*			각 샘플은 독립적으로 계산되므로 스레드 개수와 무관하게 직렬 계산과 동일한 결과를 얻음
 *
 */
 void DgVolume::computeSDF()
 {
+	int N_X = mDim[0];
+	int N_Y = mDim[1];
+	int N_Z = mDim[2];
+
+	// 1) 메쉬에 대한 BVH 생성(파일에서 임포트한 메쉬는 옆에 저장된 BVH 캐시를 사용)
+	std::string cacheFile = mMesh->mFilePath.empty() ? "" : mMesh->mFilePath + ".bvh";
+	DgBvh bvh(mMesh, cacheFile.c_str(), DgBvh::BUILD_SAH);
+
+	// 이전 양자화 결과를 버린다(계산이 끝나면 mQuantType에 따라 다시 양자화).
+	mQuantData.clear();
+	mQuantData.shrink_to_fit();
+
+	// 희소 격자 모드라면 표면 근처 브릭만 할당하여 계산한다.
+	if (mSparse)
+	{
+		mData.clear();
+		mData.shrink_to_fit();
+		computeSparseSDF(bvh);
+		quantize();
+		getSampleRange(mDistRange[0], mDistRange[1]);
+		markAllDirty();
+		return;
+	}
+
+	// 2) mData 벡터 크기 설정
+	mData.assign(N_X * N_Y * N_Z, std::numeric_limits<float>::max());
+
+	// 좁은 대역 모드라면 대역 샘플만 정확히 계산한다.
+	if (mBandWidth > 0)
+	{
+		computeNarrowBandSDF(bvh);
+		quantize();
+		getSampleRange(mDistRange[0], mDistRange[1]);
+		markAllDirty();
+		return;
+	}
 
+	// 3) 격자를 브릭 단위로 분할
+	int NB_X = (N_X + SDF_BRICK_SIZE - 1) / SDF_BRICK_SIZE;
+	int NB_Y = (N_Y + SDF_BRICK_SIZE - 1) / SDF_BRICK_SIZE;
+	int NB_Z = (N_Z + SDF_BRICK_SIZE - 1) / SDF_BRICK_SIZE;
+	int numBricks = NB_X * NB_Y * NB_Z;
+
+	// 4) 브릭을 스레드에 동적으로 분배하여 계산
+	int numThreads = (mNumThreads > 0) ? mNumThreads : omp_get_max_threads();
+#pragma omp parallel for schedule(dynamic, 1) num_threads(numThreads)
+	for (int b = 0; b < numBricks; ++b)
+	{
+		int bi = b % NB_X;
+		int bj = (b / NB_X) % NB_Y;
+		int bk = b / (NB_X * NB_Y);
+		computeBrickSDF(bvh, bi, bj, bk);
+	}
+
+	// 5) 양자화 저장 형식이면 mData를 양자화된 배열로 대체하고, 스컬프팅에 사용할 거리 범위를 구한다.
+	quantize();
+	getSampleRange(mDistRange[0], mDistRange[1]);
+	markAllDirty();
+}
+
+/*!
+*	@brief	격자 샘플 (i, j, k)의 부호거리를 BVH로 계산
+*	@note	SIGN_WINDING_NUMBER 모드는 와인딩 넘버가 0.5보다 크면 내부로 판정하므로
+*			열린 메쉬나 자기 교차 메쉬에서도 부호가 안정적임
+*
+*	@param	bvh[in]		메쉬의 BVH
+*	@param	i, j, k[in]	격자 샘플의 인덱스
+*
+*	@return	샘플 위치에서 메쉬까지의 부호거리를 반환
+*/
+float DgVolume::computeSampleSDF(DgBvh& bvh, int i, int j, int k)
+{
+	// 격자 샘플의 실제 좌표 계산
+	DgPos p(mMin.mPos[0] + i * mSpacing[0],
+			mMin.mPos[1] + j * mSpacing[1],
+			mMin.mPos[2] + k * mSpacing[2]);
+
+	// BVH 질의로 메쉬와 샘플좌표의 부호거리 계산
+	DgPos q;
+	DgFace* pFace = NULL;
+	if (mSignType != SIGN_PSEUDO_NORMAL)
+	{
+		double d = bvh.computeDistance(p, q, &pFace, false);
+		return static_cast<float>(isInside(bvh, p) ? -d : d);
+	}
+	return static_cast<float>(bvh.computeDistance(p, q, &pFace, true));
+}
+
+/*!
+*	@brief	점 p가 메쉬 내부인지 판정
+*	@note	SIGN_RAY_PARITY 모드는 서로 다른 세 방향의 반직선이 교차하는 삼각형 수의 홀짝으로 투표하여
+*			광선이 에지나 정점을 지나면서 생기는 중복 교차의 영향을 줄임
+*
+*	@param	bvh[in]		메쉬의 BVH
+*	@param	p[in]		점의 위치
+*
+*	@return	내부이면 true, 외부이면 false를 반환
+*/
+bool DgVolume::isInside(DgBvh& bvh, const DgPos& p)
+{
+	if (mSignType == SIGN_WINDING_NUMBER)
+		return bvh.computeWindingNumber(p) > 0.5;
+
+	// 좌표축과 정렬되지 않은 세 방향으로 투표한다.
+	static const DgVec3 dirs[3] = {
+		DgVec3(0.5773, 0.5774, 0.5774),
+		DgVec3(-0.6123, 0.3536, 0.7071),
+		DgVec3(0.1543, -0.7715, -0.6172),
+	};
+	int votes = 0;
+	for (const DgVec3& dir : dirs)
+		votes += bvh.countRayHits(p, dir) % 2;
+	return votes >= 2;
+}
+
+/*!
+*	@brief	브릭 (bi, bj, bk)에 포함된 격자 샘플의 부호거리를 계산
+*
+*	@param	bvh[in]			메쉬의 BVH
+*	@param	bi, bj, bk[in]	브릭의 인덱스
+*/
+void DgVolume::computeBrickSDF(DgBvh& bvh, int bi, int bj, int bk)
+{
+	int N_X = mDim[0];
+	int N_Y = mDim[1];
+
+	int i0 = bi * SDF_BRICK_SIZE, i1 = MIN(i0 + SDF_BRICK_SIZE, mDim[0]);
+	int j0 = bj * SDF_BRICK_SIZE, j1 = MIN(j0 + SDF_BRICK_SIZE, mDim[1]);
+	int k0 = bk * SDF_BRICK_SIZE, k1 = MIN(k0 + SDF_BRICK_SIZE, mDim[2]);
+
+	for (int k = k0; k < k1; k++)
+		for (int j = j0; j < j1; j++)
+			for (int i = i0; i < i1; i++)
+				mData[i + j * N_X + k * N_X * N_Y] = computeSampleSDF(bvh, i, j, k);
+}
+
+/*!
+*	@brief	삼각형 근처 대역의 샘플만 정확히 계산하고 나머지는 fast sweeping으로 채움
+*	@note	각 삼각형의 AABB를 mBandWidth개 격자만큼 확장하여 격자에 래스터화한 샘플을 대역으로 사용
+*
+*	@param	bvh[in]		메쉬의 BVH
+*/
+void DgVolume::computeNarrowBandSDF(DgBvh& bvh)
+{
+	int N_X = mDim[0];
+	int N_Y = mDim[1];
+
+	// 1) 삼각형의 AABB를 격자에 래스터화하여 대역 샘플을 표시
+	std::vector<char> band(mData.size(), 0);
+	for (const DgFace& f : mMesh->mFaces)
+	{
+		int idx0[3], idx1[3];
+		for (int a = 0; a < 3; ++a)
+		{
+			double fmin = DBL_MAX, fmax = -DBL_MAX;
+			for (int v = 0; v < 3; ++v)
+			{
+				double x = mMesh->mVerts[f.mVertIdxs[v]].mPos[a];
+				fmin = MIN(fmin, x);
+				fmax = MAX(fmax, x);
+			}
+			idx0[a] = (int)std::floor((fmin - mMin[a]) / mSpacing[a]) - mBandWidth;
+			idx1[a] = (int)std::ceil((fmax - mMin[a]) / mSpacing[a]) + mBandWidth;
+			idx0[a] = MAX(idx0[a], 0);
+			idx1[a] = MIN(idx1[a], mDim[a] - 1);
+		}
+
+		for (int k = idx0[2]; k <= idx1[2]; k++)
+			for (int j = idx0[1]; j <= idx1[1]; j++)
+				for (int i = idx0[0]; i <= idx1[0]; i++)
+					band[i + j * N_X + k * N_X * N_Y] = 1;
+	}
+
+	std::vector<int> bandIdxs;
+	for (int i = 0; i < (int)band.size(); ++i)
+		if (band[i])
+			bandIdxs.push_back(i);
+
+	// 2) 대역 샘플의 부호거리를 BVH 일괄 질의로 정확히 계산
+	int numThreads = (mNumThreads > 0) ? mNumThreads : omp_get_max_threads();
+	int numBand = (int)bandIdxs.size();
+	std::vector<DgPos> pts(numBand);
+	for (int n = 0; n < numBand; ++n)
+	{
+		int index = bandIdxs[n];
+		int i = index % N_X;
+		int j = (index / N_X) % N_Y;
+		int k = index / (N_X * N_Y);
+		pts[n] = DgPos(mMin.mPos[0] + i * mSpacing[0],
+					   mMin.mPos[1] + j * mSpacing[1],
+					   mMin.mPos[2] + k * mSpacing[2]);
+	}
+	std::vector<double> dists(numBand);
+	bool bPseudoNormal = (mSignType == SIGN_PSEUDO_NORMAL);
+	bvh.computeDistances(pts.data(), numBand, dists.data(), NULL, NULL, bPseudoNormal, true, numThreads);
+
+#pragma omp parallel for schedule(dynamic, 64) num_threads(numThreads)
+	for (int n = 0; n < numBand; ++n)
+	{
+		double d = dists[n];
+		if (!bPseudoNormal && isInside(bvh, pts[n]))
+			d = -d;
+		mData[bandIdxs[n]] = static_cast<float>(d);
+	}
+
+	// 3) 대역 밖의 샘플은 fast sweeping으로 채운다.
+	fastSweep(band);
+}
+
+/*!
+*	@brief	이웃 샘플의 거리 a[3]와 축별 간격 h[3]로 아이코날 방정식 |grad u| = 1의 풍상(upwind) 해를 계산
+*
+*/
+static double solve_eikonal(double a[3], double h[3])
+{
+	// 이웃 거리의 오름차순으로 정렬
+	for (int m = 0; m < 2; ++m)
+		for (int n = 0; n < 2 - m; ++n)
+			if (a[n] > a[n + 1])
+			{
+				std::swap(a[n], a[n + 1]);
+				std::swap(h[n], h[n + 1]);
+			}
+
+	// 한 축만 사용하는 해
+	double u = a[0] + h[0];
+	if (u <= a[1])
+		return u;
+
+	// 두 축, 세 축을 사용하는 해: sum((u - a_n) / h_n)^2 = 1
+	for (int m = 2; m <= 3; ++m)
+	{
+		double A = 0.0, B = 0.0, C = -1.0;
+		for (int n = 0; n < m; ++n)
+		{
+			double w = 1.0 / SQR(h[n]);
+			A += w;
+			B += a[n] * w;
+			C += SQR(a[n]) * w;
+		}
+		double disc = MAX(B * B - A * C, 0.0);
+		u = (B + SQRT(disc)) / A;
+		if (m == 3 || u <= a[m])
+			break;
+	}
+	return u;
+}
+
+/*!
+*	@brief	고정된 대역 샘플로부터 아이코날 방정식을 풀어 나머지 샘플의 부호거리를 채움
+*	@note	8가지 방향의 Gauss-Seidel 스윕(fast sweeping method)으로 거리 크기를 전파하고,
+*			부호는 해를 결정한 풍상 이웃의 부호를 따른다.
+*
+*	@param	frozen[in]	값이 고정된(정확히 계산된) 샘플 표시
+*/
+void DgVolume::fastSweep(const std::vector<char>& frozen)
+{
 	int N_X = mDim[0];
 	int N_Y = mDim[1];
 	int N_Z = mDim[2];
+	int strides[3] = { 1, N_X, N_X * N_Y };
 
-	// 1) mData  ũ 
-	mData.resize(mDim[0] * mDim[1] * mDim[2], std::numeric_limits<float>::max());
+	// 1) 거리 크기와 부호를 분리하여 초기화
+	std::vector<double> dist(mData.size(), DBL_MAX);
+	std::vector<signed char> sign(mData.size(), 0);
+	for (int i = 0; i < (int)mData.size(); ++i)
+	{
+		if (frozen[i])
+		{
+			dist[i] = ABS(mData[i]);
+			sign[i] = (mData[i] < 0.0f) ? -1 : 1;
+		}
+	}
 
-	for (int k = 0; k < N_Z; k++)
+	// 2) 8가지 방향으로 스윕
+	for (int s = 0; s < 8; ++s)
 	{
-		for (int j = 0; j < N_Y; j++)
+		int di = (s & 1) ? -1 : 1;
+		int dj = (s & 2) ? -1 : 1;
+		int dk = (s & 4) ? -1 : 1;
+		for (int k = (dk > 0 ? 0 : N_Z - 1); k >= 0 && k < N_Z; k += dk)
 		{
-			for (int i = 0; i < N_X; i++) 
+			for (int j = (dj > 0 ? 0 : N_Y - 1); j >= 0 && j < N_Y; j += dj)
 			{
-				// 2)    ǥ 
-				glm::vec3 p;
-				p.x = mMin.mPos[0] + i * mSpacing[0];
-				p.y = mMin.mPos[1] + j * mSpacing[1];
-				p.z = mMin.mPos[2] + k * mSpacing[2];
+				for (int i = (di > 0 ? 0 : N_X - 1); i >= 0 && i < N_X; i += di)
+				{
+					int index = i + j * N_X + k * N_X * N_Y;
+					if (frozen[index])
+						continue;
 
-				// 3) ޽ ǥ ȣŸ 
-				auto distance = findClosestDistanceToMesh(mMesh, p);
+					// 각 축의 이웃 중 작은 거리를 구한다.
+					int ijk[3] = { i, j, k };
+					double a[3], h[3];
+					int upwind = -1;
+					for (int ax = 0; ax < 3; ++ax)
+					{
+						a[ax] = DBL_MAX;
+						h[ax] = mSpacing[ax];
+						for (int d = -1; d <= 1; d += 2)
+						{
+							int n = ijk[ax] + d;
+							if (n < 0 || n >= mDim[ax])
+								continue;
+							int nIdx = index + d * strides[ax];
+							if (dist[nIdx] < a[ax])
+							{
+								a[ax] = dist[nIdx];
+								if (upwind < 0 || dist[nIdx] < dist[upwind])
+									upwind = nIdx;
+							}
+						}
+					}
+					if (upwind < 0 || dist[upwind] == DBL_MAX)
+						continue;
 
-				// 4) mData ȣŸ 
-				int index = i + j * N_X + k * N_X * N_Y;
-				mData[index] = distance.second;
+					// 풍상 해가 기존 값보다 작으면 갱신한다.
+					double u = solve_eikonal(a, h);
+					if (u < dist[index])
+					{
+						dist[index] = u;
+						sign[index] = sign[upwind];
+					}
+				}
 			}
 		}
 	}
 
-	//  
-	for (int k = 0; k < N_Z; k++) {
-		for (int j = 0; j < N_Y; j++) {
-			for (int i = 0; i < N_X; i++) {
+	// 3) 부호를 적용하여 mData에 저장
+	for (int i = 0; i < (int)mData.size(); ++i)
+	{
+		if (frozen[i])
+			continue;
+		float d = (dist[i] == DBL_MAX) ? std::numeric_limits<float>::max() : static_cast<float>(dist[i]);
+		mData[i] = (sign[i] < 0) ? -d : d;
+	}
+}
 
-				// 4) mData ȣŸ 
-				int index = i + j * N_X + k * N_X * N_Y;
+/*!
+*	@brief	표면 근처의 브릭만 할당하여 희소 격자에 클램프된 부호거리를 저장
+*	@note	삼각형의 AABB를 대역 폭(mBandWidth, 0이면 2)만큼 확장하여 겹치는 브릭만 할당하고,
+*			부호거리는 +-(대역 폭 * 최소 격자 간격)으로 클램프한다.
+*			할당되지 않은 브릭은 브릭 중심의 부호만 BVH로 판정하여 클램프 값으로 채운다.
+*
+*	@param	bvh[in]		메쉬의 BVH
+*/
+void DgVolume::computeSparseSDF(DgBvh& bvh)
+{
+	int band = (mBandWidth > 0) ? mBandWidth : 2;
+	float clampDist = (float)(band * MIN(mSpacing[0], MIN(mSpacing[1], mSpacing[2])));
+	mSparseData.init(mDim[0], mDim[1], mDim[2], clampDist);
+	const int* NB = mSparseData.mBrickDim;
 
-				std::cout << mData[index] << " ";
+	// 1) 삼각형의 AABB와 겹치는 브릭을 할당
+	for (const DgFace& f : mMesh->mFaces)
+	{
+		int b0[3], b1[3];
+		for (int a = 0; a < 3; ++a)
+		{
+			double fmin = DBL_MAX, fmax = -DBL_MAX;
+			for (int v = 0; v < 3; ++v)
+			{
+				double x = mMesh->mVerts[f.mVertIdxs[v]].mPos[a];
+				fmin = MIN(fmin, x);
+				fmax = MAX(fmax, x);
 			}
-			std::cout << std::endl;
+			int i0 = MAX((int)std::floor((fmin - mMin[a]) / mSpacing[a]) - band, 0);
+			int i1 = MIN((int)std::ceil((fmax - mMin[a]) / mSpacing[a]) + band, mDim[a] - 1);
+			b0[a] = i0 / SDF_BRICK_SIZE;
+			b1[a] = i1 / SDF_BRICK_SIZE;
+		}
+
+		for (int bk = b0[2]; bk <= b1[2]; bk++)
+			for (int bj = b0[1]; bj <= b1[1]; bj++)
+				for (int bi = b0[0]; bi <= b1[0]; bi++)
+					if (mSparseData.mBrickSlots[bi + bj * NB[0] + bk * NB[0] * NB[1]] < 0)
+						mSparseData.allocBrick(bi, bj, bk);
+	}
+
+	// 2) 브릭별로 부호거리를 계산
+	int numBricks = NB[0] * NB[1] * NB[2];
+	int numThreads = (mNumThreads > 0) ? mNumThreads : omp_get_max_threads();
+#pragma omp parallel for schedule(dynamic, 1) num_threads(numThreads)
+	for (int b = 0; b < numBricks; ++b)
+	{
+		int bi = b % NB[0];
+		int bj = (b / NB[0]) % NB[1];
+		int bk = b / (NB[0] * NB[1]);
+		int slot = mSparseData.mBrickSlots[b];
+
+		// 할당되지 않은 브릭은 중심의 부호만 판정한다.
+		if (slot < 0)
+		{
+			int ci = MIN(bi * SDF_BRICK_SIZE + SDF_BRICK_SIZE / 2, mDim[0] - 1);
+			int cj = MIN(bj * SDF_BRICK_SIZE + SDF_BRICK_SIZE / 2, mDim[1] - 1);
+			int ck = MIN(bk * SDF_BRICK_SIZE + SDF_BRICK_SIZE / 2, mDim[2] - 1);
+			float d = computeSampleSDF(bvh, ci, cj, ck);
+			mSparseData.mBrickValues[b] = (d < 0.0f) ? -clampDist : clampDist;
+			continue;
 		}
-		std::cout << std::endl;
+
+		// 할당된 브릭은 모든 샘플을 계산하여 클램프한다.
+		float* pBrick = mSparseData.mPool.get(slot);
+		for (int k = 0; k < SDF_BRICK_SIZE; k++)
+			for (int j = 0; j < SDF_BRICK_SIZE; j++)
+				for (int i = 0; i < SDF_BRICK_SIZE; i++)
+				{
+					int gi = bi * SDF_BRICK_SIZE + i;
+					int gj = bj * SDF_BRICK_SIZE + j;
+					int gk = bk * SDF_BRICK_SIZE + k;
+					if (gi >= mDim[0] || gj >= mDim[1] || gk >= mDim[2])
+						continue;
+					float d = computeSampleSDF(bvh, gi, gj, gk);
+					pBrick[i + j * SDF_BRICK_SIZE + k * SDF_BRICK_SIZE * SDF_BRICK_SIZE] = MAX(-clampDist, MIN(d, clampDist));
+				}
 	}
+
+	printf("Sparse SDF: %d / %d bricks, %.1f MB (dense %.1f MB)\n",
+		mSparseData.getNumAllocated(), numBricks,
+		mSparseData.getMemory() / (1024.0 * 1024.0),
+		(double)mDim[0] * mDim[1] * mDim[2] * sizeof(float) / (1024.0 * 1024.0));
 }
 
 /*!
-*	@brief	޽  p  ִ Ÿ  Ÿ  ﰢ ȯ
+*	@brief	격자 샘플 (i, j, k)의 부호거리를 반환(밀집/희소 저장 공통)
 *
-*	@param	DgMesh* mesh	Է  ޽
-*	@param	vec3& p			Է   ǥ
+*/
+float DgVolume::sample(int i, int j, int k) const
+{
+	int idx = i + j * mDim[0] + k * mDim[0] * mDim[1];
+	if (!mQuantData.empty())
+	{
+		if (mQuantType == QUANT_FLOAT16)
+			return half_to_float(reinterpret_cast<const unsigned short*>(mQuantData.data())[idx]) * mQuantScale;
+		return snorm8_to_float(reinterpret_cast<const signed char*>(mQuantData.data())[idx]) * mQuantScale;
+	}
+	if (mSparse)
+		return mSparseData.sample(i, j, k);
+	return mData[idx];
+}
+
+/*!
+*	@brief	저장된 모든 샘플의 부호거리를 포함하는 범위를 구함
+*	@note	양자화된 볼륨은 ±mQuantScale로 잘려 저장되므로 탐색 없이 대역 거리를 반환하고,
+*			실수 볼륨은 z 단면(희소 저장은 브릭)별 최소/최대를 병렬로 구한 뒤 합친다.
 *
+*	@param	dmin[out]	최소 부호거리
+*	@param	dmax[out]	최대 부호거리
 */
-std::pair<DgFace*, float> DgVolume::findClosestDistanceToMesh(DgMesh* mesh, const glm::vec3& p)
+void DgVolume::getSampleRange(float& dmin, float& dmax) const
 {
-	std::vector<float>	distances;
-	std::vector<int>	faceIndices;
-	std::vector<bool>	isInside;
+	if (!mQuantData.empty())
+	{
+		dmin = -mQuantScale;
+		dmax = mQuantScale;
+		return;
+	}
 
-	for (int i = 0; i < mesh->mFaces.size(); ++i)
+	// 희소 저장은 브릭 단위로, 밀집 저장은 z 단면 단위로 나누어 부분 범위를 구한다.
+	int num = mSparse ? NUM(mSparseData.mBrickSlots) : mDim[2];
+	std::vector<float> partMin(num, FLT_MAX), partMax(num, -FLT_MAX);
+	int numThreads = (mNumThreads > 0) ? mNumThreads : omp_get_max_threads();
+#pragma omp parallel for schedule(static) num_threads(numThreads)
+	for (int n = 0; n < num; ++n)
 	{
-		// ﰢ   ǥ
-		glm::vec3 v0(mesh->mVerts[mesh->mFaces[i].mVertIdxs[0]].mPos[0],	
-					 mesh->mVerts[mesh->mFaces[i].mVertIdxs[0]].mPos[1],
-					 mesh->mVerts[mesh->mFaces[i].mVertIdxs[0]].mPos[2]);
-		glm::vec3 v1(mesh->mVerts[mesh->mFaces[i].mVertIdxs[1]].mPos[0],
-					 mesh->mVerts[mesh->mFaces[i].mVertIdxs[1]].mPos[1],
-					 mesh->mVerts[mesh->mFaces[i].mVertIdxs[1]].mPos[2]);
-		glm::vec3 v2(mesh->mVerts[mesh->mFaces[i].mVertIdxs[2]].mPos[0],
-					 mesh->mVerts[mesh->mFaces[i].mVertIdxs[2]].mPos[1],
-					 mesh->mVerts[mesh->mFaces[i].mVertIdxs[2]].mPos[2]);
-		
-		glm::vec3 n = glm::cross(v1 - v0, v2 - v0);						// ﰢ  
-		n = glm::normalize(n);
+		const float* data = nullptr;
+		int count = 0;
+		if (!mSparse)
+		{
+			data = mData.data() + (size_t)n * mDim[0] * mDim[1];
+			count = mDim[0] * mDim[1];
+		}
+		else if (mSparseData.mBrickSlots[n] >= 0)
+		{
+			data = mSparseData.mPool.get(mSparseData.mBrickSlots[n]);
+			count = DgBrickPool::BRICK_VOXELS;
+		}
+		else
+		{
+			partMin[n] = partMax[n] = mSparseData.mBrickValues[n];
+			continue;
+		}
 
-		double d = glm::dot(n * -1.0f, v0);								//   d  
+		float lo = FLT_MAX, hi = -FLT_MAX;
+		for (int i = 0; i < count; ++i)
+		{
+			lo = MIN(lo, data[i]);
+			hi = MAX(hi, data[i]);
+		}
+		partMin[n] = lo;
+		partMax[n] = hi;
+	}
 
-		double dist = n[0] * (p.x) + n[1] * (p.y) + n[2] * (p.z) + d;	//  p  Ÿ 
+	dmin = FLT_MAX;
+	dmax = -FLT_MAX;
+	for (int n = 0; n < num; ++n)
+	{
+		dmin = MIN(dmin, partMin[n]);
+		dmax = MAX(dmax, partMax[n]);
+	}
+}
 
-		if(dist < 0)
-			isInside.push_back(true);
+/*!
+*	@brief	모든 샘플의 부호거리를 [-band, band]로 자름
+*	@note	잘린 거리는 크기가 줄어들기만 하므로 레이마칭에서 보수적이다. 양자화된 볼륨은 이미 ±mQuantScale로
+*			잘려 있으므로 범위만 갱신한다.
+*
+*	@param	band[in]	대역 거리
+*/
+void DgVolume::clampSamples(float band)
+{
+	if (mQuantData.empty())
+	{
+		// 희소 저장은 할당된 브릭과 상수 브릭 값을, 밀집 저장은 z 단면 단위로 자른다.
+		int num = mSparse ? NUM(mSparseData.mBrickSlots) : mDim[2];
+		int numThreads = (mNumThreads > 0) ? mNumThreads : omp_get_max_threads();
+#pragma omp parallel for schedule(static) num_threads(numThreads)
+		for (int n = 0; n < num; ++n)
+		{
+			float* data = nullptr;
+			int count = 0;
+			if (!mSparse)
+			{
+				data = mData.data() + (size_t)n * mDim[0] * mDim[1];
+				count = mDim[0] * mDim[1];
+			}
+			else if (mSparseData.mBrickSlots[n] >= 0)
+			{
+				data = mSparseData.mPool.get(mSparseData.mBrickSlots[n]);
+				count = DgBrickPool::BRICK_VOXELS;
+			}
+			else
+			{
+				data = &mSparseData.mBrickValues[n];
+				count = 1;
+			}
+			for (int i = 0; i < count; ++i)
+				data[i] = MIN(MAX(data[i], -band), band);
+		}
+		markAllDirty();
+	}
+	else
+		band = MIN(band, mQuantScale);
+	mDistRange[0] = MAX(mDistRange[0], -band);
+	mDistRange[1] = MIN(mDistRange[1], band);
+}
+
+/*!
+*	@brief	부호거리장의 밀집 배열을 반환
+*
+*	@param	buffer[out]		희소 저장인 경우 변환된 밀집 배열이 저장될 버퍼
+*
+*	@return	x 우선 순서의 밀집 배열 포인터를 반환
+*/
+const float* DgVolume::getDenseData(std::vector<float>& buffer) const
+{
+	if (!mQuantData.empty())
+	{
+		// 양자화된 값을 GPU와 같은 방식으로 복원한다.
+		int num = mDim[0] * mDim[1] * mDim[2];
+		int numBlocks = (num + QUANT_BLOCK_SIZE - 1) / QUANT_BLOCK_SIZE;
+		buffer.resize(num);
+		int numThreads = (mNumThreads > 0) ? mNumThreads : omp_get_max_threads();
+#pragma omp parallel for schedule(static) num_threads(numThreads)
+		for (int b = 0; b < numBlocks; ++b)
+		{
+			int st = b * QUANT_BLOCK_SIZE, n = MIN(QUANT_BLOCK_SIZE, num - st);
+			if (mQuantType == QUANT_FLOAT16)
+				decode_half(reinterpret_cast<const unsigned short*>(mQuantData.data()) + st, buffer.data() + st, n, mQuantScale);
+			else
+				decode_snorm8(reinterpret_cast<const signed char*>(mQuantData.data()) + st, buffer.data() + st, n, mQuantScale);
+		}
+		return buffer.data();
+	}
+	if (!mSparse)
+		return mData.data();
+	mSparseData.exportDense(buffer);
+	return buffer.data();
+}
+
+/*!
+*	@brief	부호거리장을 mQuantType 형식으로 양자화
+*	@note	거리는 ±mClampBand 격자 간격으로 잘라 [-1, 1]로 정규화한 뒤 half(R16F) 또는 signed char(R8_SNORM)로 저장하고,
+*			원래의 실수 저장(mData, mSparseData)은 해제한다. 대역 밖의 샘플은 크기가 줄어들기만 하므로 레이마칭에서 보수적이다.
+*
+*	@return	대역 안의 샘플에 대한 실수 부호거리와 복원된 값의 최대 오차를 반환
+*/
+float DgVolume::quantize()
+{
+	if (mQuantType == QUANT_FLOAT32 || !mQuantData.empty())
+		return mQuantError;
+
+	int num = mDim[0] * mDim[1] * mDim[2];
+	std::vector<float> buffer;
+	const float* data = getDenseData(buffer);
+
+	// 대역 거리를 정규화 배율로 사용한다.
+	float band = (float)(mClampBand * MIN(mSpacing[0], MIN(mSpacing[1], mSpacing[2])));
+	mQuantData.resize((size_t)num * getSampleSize());
+
+	// 블록을 스레드에 나누고, 블록 안에서는 SSE2로 4개씩 인코딩한다.
+	int numBlocks = (num + QUANT_BLOCK_SIZE - 1) / QUANT_BLOCK_SIZE;
+	std::vector<float> blockErr(numBlocks, 0.0f);
+	int numThreads = (mNumThreads > 0) ? mNumThreads : omp_get_max_threads();
+#pragma omp parallel for schedule(static) num_threads(numThreads)
+	for (int b = 0; b < numBlocks; ++b)
+	{
+		int st = b * QUANT_BLOCK_SIZE, n = MIN(QUANT_BLOCK_SIZE, num - st);
+		if (mQuantType == QUANT_FLOAT16)
+			blockErr[b] = encode_half(data + st, reinterpret_cast<unsigned short*>(mQuantData.data()) + st, n, band);
 		else
-			isInside.push_back(false);
+			blockErr[b] = encode_snorm8(data + st, reinterpret_cast<signed char*>(mQuantData.data()) + st, n, band);
+	}
+	float maxErr = 0.0f;
+	for (float err : blockErr)
+		maxErr = MAX(maxErr, err);
+
+	printf("SDF quantization (%s, band = %.4f): %.2f MB -> %.2f MB, max error = %e\n",
+		(mQuantType == QUANT_FLOAT16) ? "R16F" : "R8_SNORM", band,
+		(double)num * sizeof(float) / (1024.0 * 1024.0), (double)mQuantData.size() / (1024.0 * 1024.0), maxErr);
 
-		dist = std::abs(dist);
-		double denom = glm::length(n);
-		dist = dist / denom;
-		distances.push_back(static_cast<float>(dist));
-		faceIndices.push_back(i);
+	// 실수 저장을 해제한다.
+	mQuantScale = band;
+	mQuantError = maxErr;
+	mData.clear();
+	mData.shrink_to_fit();
+	mSparseData.init(0, 0, 0, 0.0f);
+	return maxErr;
+}
+
+/*!
+*	@brief	매크로 셀별 최소 부호거리를 계산
+*	@note	셀 (ci, cj, ck)는 샘플 [ci * SDF_MACRO_SIZE, (ci + 1) * SDF_MACRO_SIZE]를 포함하므로, 셀 안의 삼선형 보간 값은 항상 셀의 최솟값 이상이다.
+*/
+void DgVolume::computeMacroGrid()
+{
+	for (int a = 0; a < 3; ++a)
+		mMacroDim[a] = MAX(1, (mDim[a] - 1 + SDF_MACRO_SIZE - 1) / SDF_MACRO_SIZE);
+	mMacroData.assign(mMacroDim[0] * mMacroDim[1] * mMacroDim[2], 0.0f);
+	if (mDim[0] <= 0 || mDim[1] <= 0 || mDim[2] <= 0)
+		return;
+
+	std::vector<float> buffer;
+	const float* data = getDenseData(buffer);
+	int numCells = NUM(mMacroData);
+	int numThreads = (mNumThreads > 0) ? mNumThreads : omp_get_max_threads();
+#pragma omp parallel for schedule(dynamic, 16) num_threads(numThreads)
+	for (int c = 0; c < numCells; ++c)
+	{
+		int ci = c % mMacroDim[0];
+		int cj = (c / mMacroDim[0]) % mMacroDim[1];
+		int ck = c / (mMacroDim[0] * mMacroDim[1]);
+		float minVal = FLT_MAX;
+		for (int k = ck * SDF_MACRO_SIZE; k <= MIN((ck + 1) * SDF_MACRO_SIZE, mDim[2] - 1); ++k)
+			for (int j = cj * SDF_MACRO_SIZE; j <= MIN((cj + 1) * SDF_MACRO_SIZE, mDim[1] - 1); ++j)
+				for (int i = ci * SDF_MACRO_SIZE; i <= MIN((ci + 1) * SDF_MACRO_SIZE, mDim[0] - 1); ++i)
+					minVal = MIN(minVal, data[i + j * mDim[0] + k * mDim[0] * mDim[1]]);
+		mMacroData[c] = minVal;
 	}
+}
 
-	int minIndex = std::min_element(distances.begin(), distances.end()) - distances.begin();
+/*!
+*	@brief	매크로 셀 하나의 최소 부호거리를 계산
+*/
+static float compute_macro_cell(const DgVolume& volume, int ci, int cj, int ck)
+{
+	float minVal = FLT_MAX;
+	for (int k = ck * SDF_MACRO_SIZE; k <= MIN((ck + 1) * SDF_MACRO_SIZE, volume.mDim[2] - 1); ++k)
+		for (int j = cj * SDF_MACRO_SIZE; j <= MIN((cj + 1) * SDF_MACRO_SIZE, volume.mDim[1] - 1); ++j)
+			for (int i = ci * SDF_MACRO_SIZE; i <= MIN((ci + 1) * SDF_MACRO_SIZE, volume.mDim[0] - 1); ++i)
+				minVal = MIN(minVal, volume.sample(i, j, k));
+	return minVal;
+}
 
-	return std::make_pair(&mesh->mFaces[minIndex], isInside[minIndex] ? distances[minIndex] * -1.0 : distances[minIndex]);
-	
-	// () BVH Ȱ
-}
\ No newline at end of file
+/*!
+*	@brief	변경된 브릭과 겹치는 매크로 셀만 다시 계산
+*	@note	브릭 b의 샘플 [b * SDF_BRICK_SIZE, (b + 1) * SDF_BRICK_SIZE)를 포함하는 매크로 셀은 경계 샘플을 공유하는 셀까지 포함한다.
+*/
+void DgVolume::updateMacroGrid()
+{
+	int numCells = mMacroDim[0] * mMacroDim[1] * mMacroDim[2];
+	if (numCells == 0 || NUM(mMacroData) != numCells || mNumDirtyBricks * 2 > NUM(mDirtyBricks))
+	{
+		computeMacroGrid();
+		return;
+	}
+	if (mNumDirtyBricks == 0)
+		return;
+
+	// 변경된 브릭과 겹치는 매크로 셀을 표시한다.
+	int BX = getBrickDim(0), BY = getBrickDim(1), BZ = getBrickDim(2);
+	std::vector<char> cellDirty(numCells, 0);
+	for (int bk = 0; bk < BZ; ++bk)
+		for (int bj = 0; bj < BY; ++bj)
+			for (int bi = 0; bi < BX; ++bi)
+			{
+				if (!mDirtyBricks[bi + bj * BX + bk * BX * BY])
+					continue;
+				int b[3] = { bi, bj, bk }, c0[3], c1[3];
+				for (int a = 0; a < 3; ++a)
+				{
+					c0[a] = MAX(0, (b[a] * SDF_BRICK_SIZE) / SDF_MACRO_SIZE - 1);
+					c1[a] = MIN(mMacroDim[a] - 1, ((b[a] + 1) * SDF_BRICK_SIZE - 1) / SDF_MACRO_SIZE);
+				}
+				for (int ck = c0[2]; ck <= c1[2]; ++ck)
+					for (int cj = c0[1]; cj <= c1[1]; ++cj)
+						for (int ci = c0[0]; ci <= c1[0]; ++ci)
+							cellDirty[ci + cj * mMacroDim[0] + ck * mMacroDim[0] * mMacroDim[1]] = 1;
+			}
+
+	int numThreads = (mNumThreads > 0) ? mNumThreads : omp_get_max_threads();
+#pragma omp parallel for schedule(dynamic, 16) num_threads(numThreads)
+	for (int c = 0; c < numCells; ++c)
+	{
+		if (!cellDirty[c])
+			continue;
+		int ci = c % mMacroDim[0];
+		int cj = (c / mMacroDim[0]) % mMacroDim[1];
+		int ck = c / (mMacroDim[0] * mMacroDim[1]);
+		mMacroData[c] = compute_macro_cell(*this, ci, cj, ck);
+	}
+}
+
+/*!
+*	@brief	변경된 브릭을 모두 포함하는 샘플 박스를 구함
+*
+*	@param	lo[out]		샘플 박스의 최소 인덱스
+*	@param	hi[out]		샘플 박스의 최대 인덱스(포함)
+*
+*	@return	변경된 브릭이 있으면 true, 없으면 false를 반환
+*/
+bool DgVolume::getDirtyBox(int lo[3], int hi[3]) const
+{
+	int BX = getBrickDim(0), BY = getBrickDim(1);
+	for (int a = 0; a < 3; ++a)
+	{
+		lo[a] = INT_MAX;
+		hi[a] = -1;
+	}
+	for (int b = 0; b < NUM(mDirtyBricks); ++b)
+	{
+		if (!mDirtyBricks[b])
+			continue;
+		int bb[3] = { b % BX, (b / BX) % BY, b / (BX * BY) };
+		for (int a = 0; a < 3; ++a)
+		{
+			lo[a] = MIN(lo[a], bb[a] * SDF_BRICK_SIZE);
+			hi[a] = MAX(hi[a], MIN((bb[a] + 1) * SDF_BRICK_SIZE, mDim[a]) - 1);
+		}
+	}
+	return hi[0] >= 0;
+}
+
+/*!
+*	@brief	레벨 0의 샘플 박스의 영향을 받는 밉 레벨의 샘플 박스를 구함
+*	@note	레벨 L의 샘플 j는 레벨 L - 1의 샘플 [2j - 2, 2j + 3]으로부터 계산된다.
+*/
+void DgVolume::getMipRegion(int level, const int lo[3], const int hi[3], int mipLo[3], int mipHi[3]) const
+{
+	for (int a = 0; a < 3; ++a)
+	{
+		mipLo[a] = lo[a];
+		mipHi[a] = hi[a];
+		for (int l = 1; l <= level; ++l)
+		{
+			mipLo[a] = MAX(0, (mipLo[a] - 2) / 2);
+			mipHi[a] = MIN(mMipDim[l - 1][a] - 1, (mipHi[a] + 2) / 2);
+		}
+	}
+}
+
+/*!
+*	@brief	모든 밉 레벨의 보수적 부호거리를 계산
+*/
+void DgVolume::computeMipPyramid()
+{
+	int lo[3] = { 0, 0, 0 }, hi[3] = { mDim[0] - 1, mDim[1] - 1, mDim[2] - 1 };
+	for (int l = 0; l < SDF_MIP_LEVELS; ++l)
+		mMipData[l].clear();
+	updateMipPyramid(lo, hi);
+}
+
+/*!
+*	@brief	레벨 0의 샘플 박스가 바뀌었을 때 영향을 받는 밉 레벨 샘플만 다시 계산
+*	@note	레벨 L의 샘플 j(레벨 L - 1의 좌표로 2j + 0.5)를 이웃 샘플과 삼선형 보간하는 구간은 레벨 L - 1의 좌표로 [2j - 1.5, 2j + 2.5]이고,
+*			이 구간에서 레벨 L - 1의 삼선형 보간 값은 샘플 [2j - 2, 2j + 3]의 최솟값 이상이다. 이 최솟값을 저장하면 레벨 L의 보간 값이
+*			레벨 L - 1의 보간 값을 넘지 않으므로, 모든 레벨에서 부호거리를 과대평가하지 않는다.
+*
+*	@param	lo[in]	바뀐 샘플 박스의 최소 인덱스
+*	@param	hi[in]	바뀐 샘플 박스의 최대 인덱스(포함)
+*/
+void DgVolume::updateMipPyramid(const int lo[3], const int hi[3])
+{
+	// 레벨별 해상도를 구하고, 해상도가 바뀌었으면 전체를 다시 계산한다.
+	bool full = false;
+	for (int l = 0; l < SDF_MIP_LEVELS; ++l)
+	{
+		for (int a = 0; a < 3; ++a)
+			mMipDim[l][a] = ((l == 0 ? mDim[a] : mMipDim[l - 1][a]) + 1) / 2;
+		size_t num = (size_t)mMipDim[l][0] * mMipDim[l][1] * mMipDim[l][2];
+		if (mMipData[l].size() != num)
+		{
+			mMipData[l].assign(num, 0.0f);
+			full = true;
+		}
+	}
+	int boxLo[3] = { lo[0], lo[1], lo[2] }, boxHi[3] = { hi[0], hi[1], hi[2] };
+	if (full)
+	{
+		for (int a = 0; a < 3; ++a)
+		{
+			boxLo[a] = 0;
+			boxHi[a] = mDim[a] - 1;
+		}
+	}
+	if (mDim[0] <= 0 || mDim[1] <= 0 || mDim[2] <= 0)
+		return;
+
+	// 레벨 0은 전체를 다시 계산할 때만 밀집 배열로 읽고, 일부만 갱신할 때는 샘플 단위로 읽는다.
+	std::vector<float> buffer;
+	const float* level0 = full ? getDenseData(buffer) : nullptr;
+	int numThreads = (mNumThreads > 0) ? mNumThreads : omp_get_max_threads();
+	for (int l = 0; l < SDF_MIP_LEVELS; ++l)
+	{
+		const int* srcDim = (l == 0) ? mDim : mMipDim[l - 1];
+		const float* src = (l == 0) ? level0 : mMipData[l - 1].data();
+		const int* dim = mMipDim[l];
+		int mipLo[3], mipHi[3];
+		getMipRegion(l + 1, boxLo, boxHi, mipLo, mipHi);
+
+		int nx = mipHi[0] - mipLo[0] + 1, ny = mipHi[1] - mipLo[1] + 1, nz = mipHi[2] - mipLo[2] + 1;
+#pragma omp parallel for schedule(dynamic, 1) num_threads(numThreads)
+		for (int n = 0; n < nz * ny; ++n)
+		{
+			int k = mipLo[2] + n / ny, j = mipLo[1] + n % ny;
+			for (int i = mipLo[0]; i < mipLo[0] + nx; ++i)
+			{
+				float minVal = FLT_MAX;
+				for (int z = MAX(0, 2 * k - 2); z <= MIN(srcDim[2] - 1, 2 * k + 3); ++z)
+					for (int y = MAX(0, 2 * j - 2); y <= MIN(srcDim[1] - 1, 2 * j + 3); ++y)
+						for (int x = MAX(0, 2 * i - 2); x <= MIN(srcDim[0] - 1, 2 * i + 3); ++x)
+							minVal = MIN(minVal, src ? src[x + y * srcDim[0] + z * srcDim[0] * srcDim[1]] : sample(x, y, z));
+				mMipData[l][i + j * dim[0] + k * dim[0] * dim[1]] = minVal;
+			}
+		}
+	}
+}
+
+/*!
+*	@brief	샘플 박스를 포함하는 브릭을 변경된 브릭으로 표시
+*
+*	@param	i0, j0, k0[in]	샘플 박스의 최소 인덱스
+*	@param	i1, j1, k1[in]	샘플 박스의 최대 인덱스(포함)
+*/
+void DgVolume::markDirty(int i0, int j0, int k0, int i1, int j1, int k1)
+{
+	int BX = getBrickDim(0), BY = getBrickDim(1), BZ = getBrickDim(2);
+	if (NUM(mDirtyBricks) != BX * BY * BZ)
+	{
+		markAllDirty();
+		return;
+	}
+
+	int bi0 = MAX(0, i0 / SDF_BRICK_SIZE), bi1 = MIN(BX - 1, i1 / SDF_BRICK_SIZE);
+	int bj0 = MAX(0, j0 / SDF_BRICK_SIZE), bj1 = MIN(BY - 1, j1 / SDF_BRICK_SIZE);
+	int bk0 = MAX(0, k0 / SDF_BRICK_SIZE), bk1 = MIN(BZ - 1, k1 / SDF_BRICK_SIZE);
+	for (int bk = bk0; bk <= bk1; ++bk)
+		for (int bj = bj0; bj <= bj1; ++bj)
+			for (int bi = bi0; bi <= bi1; ++bi)
+			{
+				char& dirty = mDirtyBricks[bi + bj * BX + bk * BX * BY];
+				mNumDirtyBricks += (dirty == 0) ? 1 : 0;
+				dirty = 1;
+			}
+}
+
+/*!
+*	@brief	모든 브릭을 변경된 브릭으로 표시
+*/
+void DgVolume::markAllDirty()
+{
+	mDirtyBricks.assign(getBrickDim(0) * getBrickDim(1) * getBrickDim(2), 1);
+	mNumDirtyBricks = NUM(mDirtyBricks);
+}
+
+/*!
+*	@brief	변경 표시를 모두 지움
+*/
+void DgVolume::clearDirty()
+{
+	mDirtyBricks.assign(getBrickDim(0) * getBrickDim(1) * getBrickDim(2), 0);
+	mNumDirtyBricks = 0;
+}
+
+/*!
+*	@brief	격자 샘플 (i, j, k)의 부호거리를 현재 저장 형식으로 기록
+*
+*	@param	i, j, k[in]		샘플 인덱스
+*	@param	d[in]			기록할 부호거리
+*/
+void DgVolume::setSample(int i, int j, int k, float d)
+{
+	int idx = i + j * mDim[0] + k * mDim[0] * mDim[1];
+	if (!mQuantData.empty())
+	{
+		float x = MIN(MAX(d / mQuantScale, -1.0f), 1.0f);
+		if (mQuantType == QUANT_FLOAT16)
+			reinterpret_cast<unsigned short*>(mQuantData.data())[idx] = float_to_half(x);
+		else
+			reinterpret_cast<signed char*>(mQuantData.data())[idx] = (signed char)lrintf(x * 127.0f);
+	}
+	else if (mSparse)
+	{
+		int bi = i / SDF_BRICK_SIZE, bj = j / SDF_BRICK_SIZE, bk = k / SDF_BRICK_SIZE;
+		int li = i - bi * SDF_BRICK_SIZE, lj = j - bj * SDF_BRICK_SIZE, lk = k - bk * SDF_BRICK_SIZE;
+		mSparseData.allocBrick(bi, bj, bk)[li + lj * SDF_BRICK_SIZE + lk * SDF_BRICK_SIZE * SDF_BRICK_SIZE] = d;
+	}
+	else
+		mData[idx] = d;
+	if (!mQuantData.empty())
+		d = MIN(MAX(d, -mQuantScale), mQuantScale);
+	mDistRange[0] = MIN(mDistRange[0], d);
+	mDistRange[1] = MAX(mDistRange[1], d);
+	markDirty(i, j, k, i, j, k);
+}
+
+/*!
+*	@brief	격자 공간의 구를 더하거나 빼서 부호거리장을 수정
+*	@note	합집합은 min(d, ds), 차집합은 max(d, -ds)로 갱신하므로 값이 바뀌는 샘플은 각각 |x - c| < r + max(d),
+*			|x - c| < r - min(d)를 만족한다. 저장된 거리를 ±mClampBand 격자 간격의 대역으로 잘라 두면 이 영역은
+*			반지름 r + 대역 안으로 제한되므로, 잘리지 않은 실수 볼륨은 처음 스컬프팅할 때 한 번 잘라(clampSamples)
+*			이후의 스트로크는 캐시된 거리 범위(mDistRange)만으로 구 주변만 갱신한다.
+*
+*	@param	c[in]		구의 중심(격자 공간)
+*	@param	r[in]		구의 반지름
+*	@param	add[in]		true: 합집합, false: 차집합
+*/
+void DgVolume::sculptSphere(const DgPos& c, double r, bool add)
+{
+	// 저장된 거리가 대역 밖에 있다면 먼저 대역으로 자른다.
+	float band = (float)(mClampBand * MIN(mSpacing[0], MIN(mSpacing[1], mSpacing[2])));
+	if (!mQuantData.empty())
+		band = mQuantScale;
+	if (mDistRange[0] < -band || mDistRange[1] > band)
+		clampSamples(band);
+
+	// 값이 바뀔 수 있는 샘플을 모두 포함하는 구의 반지름을 구한다(r + 대역 이하).
+	double ext = r + MAX(0.0, add ? (double)mDistRange[1] : -(double)mDistRange[0]);
+
+	int lo[3], hi[3];
+	for (int a = 0; a < 3; ++a)
+	{
+		lo[a] = MAX(0, (int)floor((c[a] - ext - mMin[a]) / mSpacing[a]));
+		hi[a] = MIN(mDim[a] - 1, (int)ceil((c[a] + ext - mMin[a]) / mSpacing[a]));
+		if (lo[a] > hi[a])
+			return;
+	}
+
+	// 희소 격자는 브릭 할당이 공유 풀을 수정하므로 직렬로 갱신한다.
+	bool serial = mSparse && mQuantData.empty();
+	int numThreads = serial ? 1 : ((mNumThreads > 0) ? mNumThreads : omp_get_max_threads());
+#pragma omp parallel for schedule(dynamic, 1) num_threads(numThreads)
+	for (int k = lo[2]; k <= hi[2]; ++k)
+	{
+		for (int j = lo[1]; j <= hi[1]; ++j)
+		{
+			for (int i = lo[0]; i <= hi[0]; ++i)
+			{
+				double dx = mMin[0] + i * mSpacing[0] - c[0];
+				double dy = mMin[1] + j * mSpacing[1] - c[1];
+				double dz = mMin[2] + k * mSpacing[2] - c[2];
+				float ds = (float)(SQRT(dx * dx + dy * dy + dz * dz) - r);
+				float d = sample(i, j, k);
+				float nd = add ? MIN(d, ds) : MAX(d, -ds);
+				nd = MIN(MAX(nd, -band), band);
+				if (nd == d)
+					continue;
+
+				int idx = i + j * mDim[0] + k * mDim[0] * mDim[1];
+				if (serial)
+				{
+					int bi = i / SDF_BRICK_SIZE, bj = j / SDF_BRICK_SIZE, bk = k / SDF_BRICK_SIZE;
+					int li = i - bi * SDF_BRICK_SIZE, lj = j - bj * SDF_BRICK_SIZE, lk = k - bk * SDF_BRICK_SIZE;
+					mSparseData.allocBrick(bi, bj, bk)[li + lj * SDF_BRICK_SIZE + lk * SDF_BRICK_SIZE * SDF_BRICK_SIZE] = nd;
+				}
+				else if (mQuantData.empty())
+					mData[idx] = nd;
+				else
+				{
+					float x = MIN(MAX(nd / mQuantScale, -1.0f), 1.0f);
+					if (mQuantType == QUANT_FLOAT16)
+						reinterpret_cast<unsigned short*>(mQuantData.data())[idx] = float_to_half(x);
+					else
+						reinterpret_cast<signed char*>(mQuantData.data())[idx] = (signed char)lrintf(x * 127.0f);
+				}
+			}
+		}
+	}
+
+	// 새로 기록된 값은 [-min(r, 대역), max(d)] 또는 [min(d), min(r, 대역)] 안에 있다.
+	if (add)
+		mDistRange[0] = MIN(mDistRange[0], -(float)MIN(r, (double)band));
+	else
+		mDistRange[1] = MAX(mDistRange[1], (float)MIN(r, (double)band));
+	markDirty(lo[0], lo[1], lo[2], hi[0], hi[1], hi[2]);
+}
+
+/*!
+*	@brief	브릭의 샘플을 저장 형식 그대로 복사
+*
+*	@param	bi, bj, bk[in]	브릭 인덱스
+*	@param	dst[out]		x 우선 순서로 빈틈없이 채워질 버퍼(격자 경계의 브릭은 잘린 크기)
+*
+*	@return	복사한 바이트 수를 반환
+*/
+int DgVolume::copyBrick(int bi, int bj, int bk, unsigned char* dst) const
+{
+	int i0 = bi * SDF_BRICK_SIZE, j0 = bj * SDF_BRICK_SIZE, k0 = bk * SDF_BRICK_SIZE;
+	int sx = MIN(SDF_BRICK_SIZE, mDim[0] - i0);
+	int sy = MIN(SDF_BRICK_SIZE, mDim[1] - j0);
+	int sz = MIN(SDF_BRICK_SIZE, mDim[2] - k0);
+	int sampleSize = getSampleSize();
+	int rowBytes = sx * sampleSize;
+
+	for (int k = 0; k < sz; ++k)
+	{
+		for (int j = 0; j < sy; ++j)
+		{
+			unsigned char* row = dst + ((size_t)(k * sy + j)) * rowBytes;
+			size_t idx = (size_t)i0 + (size_t)(j0 + j) * mDim[0] + (size_t)(k0 + k) * mDim[0] * mDim[1];
+			if (!mQuantData.empty())
+				memcpy(row, mQuantData.data() + idx * sampleSize, rowBytes);
+			else if (!mSparse)
+				memcpy(row, mData.data() + idx, rowBytes);
+			else
+				for (int i = 0; i < sx; ++i)
+				{
+					float d = mSparseData.sample(i0 + i, j0 + j, k0 + k);
+					memcpy(row + i * sizeof(float), &d, sizeof(float));
+				}
+		}
+	}
+	return sx * sy * sz * sampleSize;
+}
+
+/*!
+*	@brief	전수 탐색과 BVH 방식의 계산 시간 및 부호거리 오차를 비교
+*	@note	부호는 두 방식의 판정 기준(평면/의사 법선)이 달라 크기만 비교하고, 부호 불일치 개수는 따로 출력
+*			BVH 결과는 밀집 격자 복사본에 계산하므로 현재 볼륨의 데이터와 설정은 바뀌지 않는다.
+*
+*	@param	tol[in]		허용 오차 (기본값: 1.0e-4)
+*
+*	@return	모든 샘플의 거리 오차가 허용 오차 이내면 true, 아니면 false를 반환
+*/
+bool DgVolume::compareSDF(double tol)
+{
+	int N_X = mDim[0];
+	int N_Y = mDim[1];
+	int N_Z = mDim[2];
+
+	// 비교는 모든 샘플을 정확히 계산하는 밀집 격자에서 수행하며, 현재 볼륨의 저장 데이터를 바꾸지 않도록 복사본에 굽는다.
+	DgVolume ref(*this);
+	ref.mSparse = false;
+	ref.mBandWidth = 0;
+	ref.mQuantType = QUANT_FLOAT32;
+
+	// 1) 전수 탐색으로 부호거리 계산
+	std::vector<float> bruteData(N_X * N_Y * N_Z, 0.0f);
+	clock_t st = clock();
+	for (int k = 0; k < N_Z; k++)
+	{
+		for (int j = 0; j < N_Y; j++)
+		{
+			for (int i = 0; i < N_X; i++)
+			{
+				glm::vec3 p;
+				p.x = (float)(mMin.mPos[0] + i * mSpacing[0]);
+				p.y = (float)(mMin.mPos[1] + j * mSpacing[1]);
+				p.z = (float)(mMin.mPos[2] + k * mSpacing[2]);
+
+				int index = i + j * N_X + k * N_X * N_Y;
+				bruteData[index] = findClosestDistanceToMesh(mMesh, p).second;
+			}
+		}
+	}
+	clock_t ed = clock();
+	long bruteTime = (long)(ed - st);
+
+	// 2) BVH로 부호거리 계산
+	st = clock();
+	ref.computeSDF();
+	ed = clock();
+	long bvhTime = (long)(ed - st);
+	ref.mMesh = nullptr;	// 메쉬는 현재 볼륨이 소유하므로 복사본의 소멸자에서 해제하지 않는다.
+
+	// 3) 두 결과의 오차 비교
+	double maxErr = 0.0;
+	int numSignDiff = 0;
+	for (int i = 0; i < (int)ref.mData.size(); ++i)
+	{
+		double err = ABS(ABS(ref.mData[i]) - ABS(bruteData[i]));
+		maxErr = MAX(maxErr, err);
+		if ((ref.mData[i] < 0.0f) != (bruteData[i] < 0.0f))
+			numSignDiff++;
+	}
+
+	printf("SDF bake (%d x %d x %d, %d faces)\n", N_X, N_Y, N_Z, NUM(mMesh->mFaces));
+	printf("\tbrute-force = %ld ms, BVH = %ld ms (x%.1f)\n", bruteTime, bvhTime, (double)bruteTime / MAX(bvhTime, 1L));
+	printf("\tmax error = %e (tol = %e), sign mismatch = %d / %d\n", maxErr, tol, numSignDiff, NUM(ref.mData));
+
+	return (maxErr <= tol);
+}
+
+/*!
+*	@brief	메쉬와 점 p 간의 최단 거리와 그 거리를 갖는 삼각형을 반환
+*	@note	모든 삼각형을 검사하는 전수 탐색 방식(BVH 결과 검증용)
+*
+*	@param	DgMesh* mesh	입력 받은 메쉬
+*	@param	vec3& p			입력 받은 점의 좌표
+*
+*/
+std::pair<DgFace*, float> DgVolume::findClosestDistanceToMesh(DgMesh* mesh, const glm::vec3& p)
+{
+	glm::dvec3 q(p);
+	double minDist = DBL_MAX;
+	int minIndex = -1;
+	bool isInside = false;
+
+	for (int i = 0; i < (int)mesh->mFaces.size(); ++i)
+	{
+		// 삼각형의 세 정점 좌표
+		const int* vidx = mesh->mFaces[i].mVertIdxs;
+		glm::dvec3 a = glm::make_vec3(mesh->mVerts[vidx[0]].mPos);
+		glm::dvec3 b = glm::make_vec3(mesh->mVerts[vidx[1]].mPos);
+		glm::dvec3 c = glm::make_vec3(mesh->mVerts[vidx[2]].mPos);
+
+		// 면적이 없는 삼각형은 건너뜀
+		glm::dvec3 n = glm::cross(b - a, c - a);						// 삼각형 법선 벡터
+		if (EQ_ZERO(glm::length(n) * 0.5, 1.0e-7))
+			continue;
+
+		// 삼각형 위의 최근접점과 거리 계산(BVH 질의와 같은 dist_sq 함수를 사용)
+		DgPos closest;
+		double dist = SQRT(dist_sq(DgPos(q.x, q.y, q.z), DgPos(a.x, a.y, a.z), DgPos(b.x, b.y, b.z), DgPos(c.x, c.y, c.z), closest));
+		if (dist < minDist)
+		{
+			minDist = dist;
+			minIndex = i;
+			isInside = (glm::dot(n, q - glm::dvec3(closest[0], closest[1], closest[2])) < 0.0);	// 최근접 삼각형의 평면 기준 안/밖 판정
+		}
+	}
+
+	if (minIndex < 0)
+		return std::make_pair((DgFace*)NULL, std::numeric_limits<float>::max());
+
+	float dist = static_cast<float>(minDist);
+	return std::make_pair(&mesh->mFaces[minIndex], isInside ? -dist : dist);
+}
+
+/****************************/
+/* DgBrickPool 클래스 구현 */
+/****************************/
+int DgBrickPool::alloc()
+{
+	// 반환된 슬롯이 있으면 재사용한다.
+	if (!mFreeSlots.empty())
+	{
+		int slot = mFreeSlots.back();
+		mFreeSlots.pop_back();
+		return slot;
+	}
+
+	// 현재 청크가 가득 찼다면 새로운 청크를 할당한다.
+	if (mNumSlots == (int)mChunks.size() * CHUNK_BRICKS)
+		mChunks.emplace_back(new float[CHUNK_BRICKS * BRICK_VOXELS]);
+	return mNumSlots++;
+}
+
+void DgBrickPool::free(int slot)
+{
+	mFreeSlots.push_back(slot);
+}
+
+void DgBrickPool::clear()
+{
+	mChunks.clear();
+	mFreeSlots.clear();
+	mNumSlots = 0;
+}
+
+/*****************************/
+/* DgSparseGrid 클래스 구현 */
+/*****************************/
+void DgSparseGrid::init(int dimX, int dimY, int dimZ, float value)
+{
+	mDim[0] = dimX;
+	mDim[1] = dimY;
+	mDim[2] = dimZ;
+	for (int a = 0; a < 3; ++a)
+		mBrickDim[a] = (mDim[a] + SDF_BRICK_SIZE - 1) / SDF_BRICK_SIZE;
+
+	int numBricks = mBrickDim[0] * mBrickDim[1] * mBrickDim[2];
+	mBrickSlots.assign(numBricks, -1);
+	mBrickValues.assign(numBricks, value);
+	mPool.clear();
+}
+
+float* DgSparseGrid::allocBrick(int bi, int bj, int bk)
+{
+	int b = bi + bj * mBrickDim[0] + bk * mBrickDim[0] * mBrickDim[1];
+	if (mBrickSlots[b] < 0)
+	{
+		mBrickSlots[b] = mPool.alloc();
+		float* pBrick = mPool.get(mBrickSlots[b]);
+		std::fill(pBrick, pBrick + DgBrickPool::BRICK_VOXELS, mBrickValues[b]);
+	}
+	return mPool.get(mBrickSlots[b]);
+}
+
+float DgSparseGrid::sample(int i, int j, int k) const
+{
+	int bi = i / SDF_BRICK_SIZE, bj = j / SDF_BRICK_SIZE, bk = k / SDF_BRICK_SIZE;
+	int b = bi + bj * mBrickDim[0] + bk * mBrickDim[0] * mBrickDim[1];
+	int slot = mBrickSlots[b];
+	if (slot < 0)
+		return mBrickValues[b];
+
+	int li = i - bi * SDF_BRICK_SIZE, lj = j - bj * SDF_BRICK_SIZE, lk = k - bk * SDF_BRICK_SIZE;
+	return mPool.get(slot)[li + lj * SDF_BRICK_SIZE + lk * SDF_BRICK_SIZE * SDF_BRICK_SIZE];
+}
+
+void DgSparseGrid::exportDense(std::vector<float>& data) const
+{
+	data.resize((size_t)mDim[0] * mDim[1] * mDim[2]);
+#pragma omp parallel for
+	for (int k = 0; k < mDim[2]; k++)
+		for (int j = 0; j < mDim[1]; j++)
+			for (int i = 0; i < mDim[0]; i++)
+				data[i + j * mDim[0] + (size_t)k * mDim[0] * mDim[1]] = sample(i, j, k);
+}
+
+int DgSparseGrid::getNumAllocated() const
+{
+	return mPool.mNumSlots - (int)mPool.mFreeSlots.size();
+}
+
+size_t DgSparseGrid::getMemory() const
+{
+	return mPool.getMemory() + mBrickSlots.size() * sizeof(int) + mBrickValues.size() * sizeof(float);
+}
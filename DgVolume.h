@@ -1,32 +1,231 @@
 #pragma once
 #include "DgMesh.h"
 #include <vector>
+#include <memory>
+
+// SDF 브릭의 한 변의 샘플 개수
+#define SDF_BRICK_SIZE 8
+
+// 빈 공간 건너뛰기용 매크로 셀의 한 변의 샘플 간격 개수
+#define SDF_MACRO_SIZE 4
+
+// 보수적 부호거리 피라미드의 밉 레벨 개수(레벨 0 제외)
+#define SDF_MIP_LEVELS 3
+
+class DgBvh;
+
+/*!
+ *	\class	DgBrickPool
+ *	\brief	SDF_BRICK_SIZE^3 크기의 브릭을 청크 단위로 할당하고 재사용하는 풀 할당자
+ */
+class DgBrickPool
+{
+public:
+	/*! \brief 청크 하나에 포함되는 브릭 개수 */
+	static const int CHUNK_BRICKS = 64;
+
+	/*! \brief 브릭 하나에 포함되는 샘플 개수 */
+	static const int BRICK_VOXELS = SDF_BRICK_SIZE * SDF_BRICK_SIZE * SDF_BRICK_SIZE;
+
+	/*! \brief 할당된 청크 배열 */
+	std::vector<std::unique_ptr<float[]>> mChunks;
+
+	/*! \brief 반환되어 재사용 가능한 브릭 슬롯 */
+	std::vector<int> mFreeSlots;
+
+	/*! \brief 지금까지 사용된 브릭 슬롯 개수 */
+	int mNumSlots = 0;
+
+public:
+	/*!
+	 *	\brief	브릭 하나를 할당한다.
+	 *
+	 *	\return 할당된 브릭의 슬롯 번호를 반환한다.
+	 */
+	int alloc();
+
+	/*!
+	 *	\brief	브릭을 풀에 반환한다.
+	 *
+	 *	\param[in]	slot	반환할 브릭의 슬롯 번호
+	 */
+	void free(int slot);
+
+	/*!
+	 *	\brief	브릭의 데이터 포인터를 반환한다.
+	 *
+	 *	\param[in]	slot	브릭의 슬롯 번호
+	 *
+	 *	\return 브릭 샘플 배열(x 우선 순서)의 포인터를 반환한다.
+	 */
+	float* get(int slot) const { return mChunks[slot / CHUNK_BRICKS].get() + (slot % CHUNK_BRICKS) * BRICK_VOXELS; }
+
+	/*!
+	 *	\brief	모든 청크를 해제한다.
+	 */
+	void clear();
+
+	/*!
+	 *	\brief	풀이 차지하는 메모리 크기(byte)를 반환한다.
+	 */
+	size_t getMemory() const { return mChunks.size() * CHUNK_BRICKS * BRICK_VOXELS * sizeof(float); }
+};
+
+/*!
+ *	\class	DgSparseGrid
+ *	\brief	표면 근처의 브릭만 할당하는 희소 격자
+ *	\note	할당되지 않은 브릭은 브릭 전체에 하나의 상수 값(클램프된 원거리 부호거리)을 가진다.
+ */
+class DgSparseGrid
+{
+public:
+	/*! \brief 격자 해상도 */
+	int mDim[3] = { 0, 0, 0 };
+
+	/*! \brief 축별 브릭 개수 */
+	int mBrickDim[3] = { 0, 0, 0 };
+
+	/*! \brief 최상위 격자: 브릭별 슬롯 번호(-1: 할당되지 않은 브릭) */
+	std::vector<int> mBrickSlots;
+
+	/*! \brief 할당되지 않은 브릭의 상수 값 */
+	std::vector<float> mBrickValues;
+
+	/*! \brief 브릭 데이터 풀 */
+	DgBrickPool mPool;
+
+public:
+	/*!
+	 *	\brief	격자 해상도를 설정하고 모든 브릭을 해제한다.
+	 *
+	 *	\param[in]	dimX, dimY, dimZ	격자 해상도
+	 *	\param[in]	value				초기 상수 값
+	 */
+	void init(int dimX, int dimY, int dimZ, float value);
+
+	/*!
+	 *	\brief	브릭을 할당하고, 브릭의 모든 샘플을 기존 상수 값으로 초기화한다.
+	 *
+	 *	\param[in]	bi, bj, bk	브릭 인덱스
+	 *
+	 *	\return 할당된 브릭의 데이터 포인터를 반환한다.
+	 */
+	float* allocBrick(int bi, int bj, int bk);
+
+	/*!
+	 *	\brief	격자 샘플 (i, j, k)의 값을 반환한다.
+	 */
+	float sample(int i, int j, int k) const;
+
+	/*!
+	 *	\brief	격자 전체를 밀집(dense) 배열로 변환한다.
+	 *
+	 *	\param[out]	data	x 우선 순서의 밀집 배열이 저장된다.
+	 */
+	void exportDense(std::vector<float>& data) const;
+
+	/*!
+	 *	\brief	할당된 브릭의 개수를 반환한다.
+	 */
+	int getNumAllocated() const;
+
+	/*!
+	 *	\brief	희소 격자가 차지하는 메모리 크기(byte)를 반환한다.
+	 */
+	size_t getMemory() const;
+};
 
 /*!
  *	\class	DgVolume
- *	\brief	޽ ȣŸ ǥϴ Ŭ
+ *	\brief	메쉬의 부호거리장을 표현하는 클래스
  */
 class DgVolume
 {
 public:
-	/*! \brief SDF ⺻ ޽ */
+	/*! \brief SDF의 기본 메쉬 */
 	DgMesh* mMesh = nullptr;
 
-	/*! \brief  ػ */
+	/*! \brief 격자 해상도 */
 	int mDim[3] = { 0, 0, 0 };
 
-	/*! \brief   ּ */
+	/*! \brief 격자 공간 최소점 */
 	DgPos mMin;
 
-	/*! \brief   ִ */
+	/*! \brief 격자 공간 최대점 */
 	DgPos mMax;
 
-	/*! \brief  (ػ) */
+	/*! \brief 격자 간격(해상도) */
 	double mSpacing[3] = { 0.0, 0.0, 0.0};
 
-	/* !\brief ȣŸ ( ú ȣŸ ) */
+	/*! \brief 볼륨의 모델링 변환(격자 공간 → 월드 공간, 강체 변환과 균등 스케일을 가정) */
+	glm::mat4 mModelMat = glm::mat4(1.0f);
+
+	/* !\brief 부호거리장 데이터(격자 샘플별 부호거리 값) */
 	std::vector<float> mData;
 
+	/*! \brief SDF 계산에 사용할 스레드 개수(0: 모든 코어, 1: 직렬 계산) */
+	int mNumThreads = 0;
+
+	/*! \brief 정확한 거리를 계산할 좁은 대역의 폭(격자 단위, 0: 모든 샘플을 정확히 계산) */
+	int mBandWidth = 0;
+
+	/*! \brief 부호 판정 방식: 최근접점의 의사 법선, 일반화 와인딩 넘버 또는 광선 패리티 투표 */
+	enum TypeSign {
+		SIGN_PSEUDO_NORMAL = 0,
+		SIGN_WINDING_NUMBER = 1,
+		SIGN_RAY_PARITY = 2,
+	};
+
+	TypeSign mSignType = SIGN_PSEUDO_NORMAL;
+
+	/*! \brief 희소 브릭 격자 사용 여부(true: mSparseData에 저장, false: mData에 저장) */
+	bool mSparse = false;
+
+	/*! \brief 희소 브릭 격자에 저장된 부호거리장 데이터 */
+	DgSparseGrid mSparseData;
+
+	/*! \brief 부호거리 저장 형식: 32비트 실수, 16비트 반정밀도 실수(R16F) 또는 8비트 부호 정규화 정수(R8_SNORM) */
+	enum TypeQuant {
+		QUANT_FLOAT32 = 0,
+		QUANT_FLOAT16 = 1,
+		QUANT_SNORM8 = 2,
+	};
+
+	TypeQuant mQuantType = QUANT_FLOAT32;
+
+	/*! \brief 양자화할 때 부호거리를 자르는 대역의 폭(격자 단위, 대역 밖의 거리는 ±대역 거리로 저장) */
+	float mClampBand = 4.0f;
+
+	/*! \brief 양자화된 부호거리 데이터(x 우선 순서, [-1, 1]로 정규화된 값의 half 또는 signed char 배열) */
+	std::vector<unsigned char> mQuantData;
+
+	/*! \brief 정규화된 값을 부호거리로 복원하는 배율(대역 거리) */
+	float mQuantScale = 1.0f;
+
+	/*! \brief 대역 안의 샘플에 대한 양자화 최대 오차 */
+	float mQuantError = 0.0f;
+
+	/*! \brief 저장된 샘플의 부호거리를 포함하는 범위 [min, max](굽거나 샘플을 기록할 때 갱신, 스컬프팅 영역 계산에 사용) */
+	float mDistRange[2] = { -FLT_MAX, FLT_MAX };
+
+	/*! \brief 브릭(SDF_BRICK_SIZE^3 샘플)별 변경 여부(GPU 텍스처에 다시 올려야 하는 브릭) */
+	std::vector<char> mDirtyBricks;
+
+	/*! \brief 변경된 브릭의 개수 */
+	int mNumDirtyBricks = 0;
+
+	/*! \brief 밉 레벨 L(1 ~ SDF_MIP_LEVELS)의 해상도(mMipDim[L - 1], 레벨마다 절반으로 올림) */
+	int mMipDim[SDF_MIP_LEVELS][3] = {};
+
+	/*! \brief 밉 레벨 L의 부호거리(mMipData[L - 1], 바로 아래 레벨의 삼선형 보간 값을 넘지 않는 보수적인 값) */
+	std::vector<float> mMipData[SDF_MIP_LEVELS];
+
+	/*! \brief 매크로 셀 격자 해상도 */
+	int mMacroDim[3] = { 0, 0, 0 };
+
+	/*! \brief 매크로 셀별 최소 부호거리(셀 안의 보간 값의 하한, 레이마칭의 빈 공간 건너뛰기에 사용) */
+	std::vector<float> mMacroData;
+
 public:
 
 	DgVolume();
@@ -36,16 +235,97 @@ public:
 	
 	void setDimensions(int dimX, int dimY, int dimZ);
 	
-	/*! #brief Է ޽   (AABB) */
+	/*! #brief 입력 메쉬의 격자 공간을 정의(AABB) */
 	void setGridSpace(const DgMesh& mesh, float padding = 0.1f);
 
-	/*! #brief  ÿ Ͽ ȣŸ  mData  */
+	/*! #brief 격자 샘플에 대하여 부호거리 값을 mData에 저장(BVH 사용) */
 	void computeSDF();
 
-	/*! #brief ޽  p  ִ Ÿ  Ÿ  ﰢ ȯ */
+	/*! #brief 전수 탐색과 BVH 방식의 계산 시간 및 부호거리 오차를 비교 */
+	bool compareSDF(double tol = 1.0e-4);
+
+	/*! #brief 메쉬와 점 p 간의 최단 거리와 그 거리를 갖는 삼각형을 반환 */
 	std::pair<DgFace*, float> findClosestDistanceToMesh(DgMesh* mesh, const glm::vec3& p);
 
+	/*! #brief 격자 샘플 (i, j, k)의 부호거리를 반환(밀집/희소 저장 공통) */
+	float sample(int i, int j, int k) const;
+
+	/*! #brief 저장된 모든 샘플의 부호거리를 포함하는 범위 [dmin, dmax]를 구함(양자화된 경우 ±mQuantScale) */
+	void getSampleRange(float& dmin, float& dmax) const;
+
+	/*! #brief 모든 샘플의 부호거리를 [-band, band]로 자르고 mDistRange를 갱신(실수 볼륨을 처음 스컬프팅할 때 한 번 호출) */
+	void clampSamples(float band);
+
+	/*! #brief 부호거리장의 밀집 배열을 반환(희소 저장인 경우 buffer에 변환하여 반환) */
+	const float* getDenseData(std::vector<float>& buffer) const;
+
+	/*! #brief 부호거리장을 mQuantType 형식으로 양자화하여 mQuantData에 저장하고 최대 오차를 반환 */
+	float quantize();
+
+	/*! #brief 실제 저장 형식을 반환(양자화 전에는 QUANT_FLOAT32) */
+	TypeQuant getStorageType() const { return mQuantData.empty() ? QUANT_FLOAT32 : mQuantType; }
+
+	/*! #brief 양자화된 형식의 샘플 하나의 바이트 크기를 반환 */
+	int getSampleSize() const { return (getStorageType() == QUANT_FLOAT16) ? 2 : (getStorageType() == QUANT_SNORM8) ? 1 : 4; }
+
+	/*! #brief 축 a 방향의 브릭 개수를 반환 */
+	int getBrickDim(int a) const { return (mDim[a] + SDF_BRICK_SIZE - 1) / SDF_BRICK_SIZE; }
+
+	/*! #brief 샘플 박스 [i0, i1] x [j0, j1] x [k0, k1]를 포함하는 브릭을 변경된 브릭으로 표시 */
+	void markDirty(int i0, int j0, int k0, int i1, int j1, int k1);
+
+	/*! #brief 모든 브릭을 변경된 브릭으로 표시 */
+	void markAllDirty();
+
+	/*! #brief 변경 표시를 모두 지움(GPU 업로드 후 호출) */
+	void clearDirty();
+
+	/*! #brief 격자 샘플 (i, j, k)의 부호거리를 현재 저장 형식으로 기록하고 브릭을 변경된 브릭으로 표시 */
+	void setSample(int i, int j, int k, float d);
+
+	/*! #brief 격자 공간의 구를 더하거나(합집합) 빼고(차집합) 변경된 브릭을 표시 */
+	void sculptSphere(const DgPos& c, double r, bool add);
+
+	/*! #brief 브릭 (bi, bj, bk)의 샘플을 저장 형식 그대로 dst에 복사하고 복사한 바이트 수를 반환 */
+	int copyBrick(int bi, int bj, int bk, unsigned char* dst) const;
+
+	/*! #brief SDF_MACRO_SIZE 간격의 매크로 셀마다 최소 부호거리를 mMacroData에 저장 */
+	void computeMacroGrid();
+
+	/*! #brief 변경된 브릭과 겹치는 매크로 셀의 최소 부호거리만 다시 계산 */
+	void updateMacroGrid();
+
+	/*! #brief 변경된 브릭을 모두 포함하는 샘플 박스 [lo, hi]를 구함(변경된 브릭이 없으면 false) */
+	bool getDirtyBox(int lo[3], int hi[3]) const;
+
+	/*! #brief 모든 밉 레벨의 보수적 부호거리를 계산 */
+	void computeMipPyramid();
+
+	/*! #brief 레벨 0의 샘플 박스 [lo, hi]가 바뀌었을 때 영향을 받는 밉 레벨 샘플만 다시 계산 */
+	void updateMipPyramid(const int lo[3], const int hi[3]);
+
+	/*! #brief 레벨 0의 샘플 박스 [lo, hi]의 영향을 받는 밉 레벨 level의 샘플 박스 [mipLo, mipHi]를 구함 */
+	void getMipRegion(int level, const int lo[3], const int hi[3], int mipLo[3], int mipHi[3]) const;
+
 private:
+	/*! #brief 격자 샘플 (i, j, k)의 부호거리를 BVH로 계산 */
+	float computeSampleSDF(DgBvh& bvh, int i, int j, int k);
+
+	/*! #brief 와인딩 넘버 또는 광선 패리티 투표로 점 p가 메쉬 내부인지 판정 */
+	bool isInside(DgBvh& bvh, const DgPos& p);
+
+	/*! #brief 브릭 (bi, bj, bk)에 포함된 격자 샘플의 부호거리를 계산 */
+	void computeBrickSDF(DgBvh& bvh, int bi, int bj, int bk);
+
+	/*! #brief 삼각형 근처 대역의 샘플만 정확히 계산하고 나머지는 fast sweeping으로 채움 */
+	void computeNarrowBandSDF(DgBvh& bvh);
+
+	/*! #brief 고정된 대역 샘플로부터 아이코날 방정식을 풀어 나머지 샘플의 부호거리를 채움 */
+	void fastSweep(const std::vector<char>& frozen);
+
+	/*! #brief 표면 근처의 브릭만 할당하여 희소 격자에 클램프된 부호거리를 저장 */
+	void computeSparseSDF(DgBvh& bvh);
+
 	//float findClosestDistanceToMesh(const glm::vec3& p);
 	//float getSign(const glm::vec3& p);
 };
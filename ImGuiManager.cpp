@@ -20,13 +20,13 @@ bool ImGuiManager::init(int winWidth, int winHeight)
 	if (!glfwInit())
 		return false;
 
-	// OpenGL, GLSL  
+	// OpenGL, GLSL 버전 선택
 	const char* glsl_version = "#version 130";
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
 	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);  // GLFW_OPENGL_COMPAT_PROFILE
 
-	//  
+	// 윈도우 생성
 	mWindow = glfwCreateWindow(winWidth, winHeight, "DgViewer", nullptr, nullptr);
 	if (!mWindow)
 	{
@@ -36,20 +36,20 @@ bool ImGuiManager::init(int winWidth, int winHeight)
 
 	//glfwMaximizeWindow(mWindow);	
 	glfwMakeContextCurrent(mWindow);
-	glfwSwapInterval(1); //   ֱ⿡ ȭ
+	glfwSwapInterval(1); // 모니터 리프레시 주기에 동기화
 
-	// ImGui context 
+	// ImGui context 설정
 	IMGUI_CHECKVERSION();
 	ImGui::CreateContext();
 	ImGuiIO& io = ImGui::GetIO(); (void)io;
-	io.ConfigWindowsMoveFromTitleBarOnly = true;			// Title Bar  ġ ̵ 
+	io.ConfigWindowsMoveFromTitleBarOnly = true;			// Title Bar만 윈도우 위치 이동 가능
 	io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;	// Enable Keyboard Controls
 	io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;	// Enable Gamepad Controls
 	io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;		// Enable Docking
 	io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;		// Enable Multi-Viewport / Platform Windows
 
-	// ImGui style 
-	ImGui::StyleColorsClassic(); // ImGui::StyleColorsDark();  Ǵ ImGui::StyleColorsLight();  
+	// ImGui style 설정
+	ImGui::StyleColorsClassic(); // ImGui::StyleColorsDark();  또는 ImGui::StyleColorsLight(); 중 선택
 	ImGuiStyle& style = ImGui::GetStyle();
 	if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
 	{
@@ -61,15 +61,15 @@ bool ImGuiManager::init(int winWidth, int winHeight)
 		style.DockingSeparatorSize = 1.0f;
 	}
 
-	// ÷(GLFW)/(OpenGL) 
+	// 플랫폼(GLFW)/렌더러(OpenGL) 설정
 	ImGui_ImplGlfw_InitForOpenGL(mWindow, true);
 	ImGui_ImplOpenGL3_Init(glsl_version);
 
-	// ϴ Ʈ ε
+	// 원하는 폰트를 로딩
 	//io.Fonts->AddFontFromFileTTF("C:\\Windows\\Fonts\\cour.ttf", 20.0f);
 	io.Fonts->AddFontFromFileTTF("C:\\Windows\\Fonts\\malgun.ttf", 20.0f, NULL, io.Fonts->GetGlyphRangesKorean());
 		
-	//  ȭڸ   Լ
+	// 파일 대화상자를 위한 람다 함수
 	ifd::FileDialog::Instance().CreateTexture = [](uint8_t* data, int w, int h, char fmt) -> void *{
 		GLuint tex;
 		glGenTextures(1, &tex);
@@ -94,18 +94,18 @@ bool ImGuiManager::init(int winWidth, int winHeight)
 
 void ImGuiManager::begin()
 {
-	// ImGui  Ѵ.
+	// ImGui 프레임을 시작한다.
 	ImGui_ImplOpenGL3_NewFrame();
 	ImGui_ImplGlfw_NewFrame();
 	ImGui::NewFrame();
 
-	//   Ʈ ŷ Ѵ.
+	// 윈도우 메인 뷰포트에 도킹을 허용한다.
 	ImGui::DockSpaceOverViewport(ImGui::GetMainViewport());
 }
 
 void ImGuiManager::end()
 {
-	// 
+	// 렌더링
 	ImGuiIO& io = ImGui::GetIO(); (void)io;
 	ImGui::Render();
 	//int display_w, display_h;
@@ -6,7 +6,7 @@ static inline ImTextureID ToImTex(GLuint tex) {
 	return (ImTextureID)(uintptr_t)tex;
 }
 
-// ؽó δ
+// 텍스처 로더
 static GLuint LoadTexture2D(const char* file) {
 	int w, h, ch;
 	stbi_set_flip_vertically_on_load(true);
@@ -34,7 +34,7 @@ void OpenProperty();
 
 void ShowWindowModelProperty(bool* p_open)
 {
-	//  ÷(window flag) Ѵ.
+	// 윈도우 플래그(window flag)를 설정한다.
 	static bool no_titlebar = false;
 	static bool no_scrollbar = false;
 	static bool no_menu = true;
@@ -62,7 +62,7 @@ void ShowWindowModelProperty(bool* p_open)
 	if (unsaved_document)   window_flags |= ImGuiWindowFlags_UnsavedDocument;
 	if (no_close)           p_open = NULL; // Don't pass our bool* to Begin
 
-	// Ӽ 츦 ϰ, collapsed ¶ ٷ Ѵ.
+	// 속성 윈도우를 생성하고, collapsed된 상태라면 바로 리턴한다.
 	if (!ImGui::Begin("Property", p_open, window_flags))
 	{
 		ImGui::End();
@@ -90,7 +90,7 @@ void OpenProperty() {
 			icon_tex_id[i] = LoadTexture2D(icon_files[i]);
 	}
 
-	// ⺻   Ѵ.
+	// 기본 모델 정보를 출력한다.
 	if (ImGui::CollapsingHeader("Boolean"))
 	{
 		if (ImGui::ImageButton("Union", ToImTex(icon_tex_id[0]), ImVec2(64, 64), ImVec2(0, 1), ImVec2(1, 0)))
@@ -109,16 +109,59 @@ void OpenProperty() {
 		}
 	}
 
+	// 마지막으로 추가된 SDF 볼륨의 설정을 표시한다.
+	DgVolume* volume = DgScene::instance().getActiveSDFVolume();
+	if (volume != nullptr && ImGui::CollapsingHeader("Volume"))
+	{
+		ImGui::Text("%d x %d x %d samples", volume->mDim[0], volume->mDim[1], volume->mDim[2]);
+
+		// 굽기 설정: 부호 판정 방식, 좁은 대역 폭, 희소 저장 여부, 저장 형식(다시 구워야 적용됨)
+		const char* signTypes[] = { "Pseudo normal", "Winding number", "Ray parity" };
+		const char* quantTypes[] = { "Float32", "Float16 (R16F)", "SNorm8 (R8_SNORM)" };
+		int signType = (int)volume->mSignType;
+		if (ImGui::Combo("Sign", &signType, signTypes, IM_ARRAYSIZE(signTypes)))
+			volume->mSignType = (DgVolume::TypeSign)signType;
+		ImGui::SliderInt("Band width", &volume->mBandWidth, 0, 16);
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("Narrow band width in grid cells (0: exact distance for every sample)");
+		ImGui::Checkbox("Sparse bricks", &volume->mSparse);
+		int quantType = (int)volume->mQuantType;
+		if (ImGui::Combo("Storage", &quantType, quantTypes, IM_ARRAYSIZE(quantTypes)))
+			volume->mQuantType = (DgVolume::TypeQuant)quantType;
+
+		if (ImGui::Button("Rebake") && volume->mMesh != nullptr)
+		{
+			volume->computeSDF();
+			DgScene::instance().createSDF(*volume);
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Validate BVH bake") && volume->mMesh != nullptr)
+			printf("BVH bake validation %s\n", volume->compareSDF() ? "passed" : "failed");
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("Compare the BVH bake against brute force (dense grid, printed to the console)");
+	}
+
+	// 볼륨의 격자 공간에 지정한 구를 더하거나 뺀다(변경된 브릭만 다음 프레임에 업로드).
 	if (ImGui::CollapsingHeader("Sculpt"))
 	{
-		if (ImGui::ImageButton("sculpt_add", ToImTex(icon_tex_id[3]), ImVec2(84, 84), ImVec2(0, 1), ImVec2(1, 0)))
+		static float center[3] = { 0.0f, 0.0f, 0.0f };
+		static float radius = 0.5f;
+		if (volume != nullptr)
 		{
+			float lo = (float)MIN(volume->mMin[0], MIN(volume->mMin[1], volume->mMin[2]));
+			float hi = (float)MAX(volume->mMax[0], MAX(volume->mMax[1], volume->mMax[2]));
+			ImGui::SliderFloat3("Center", center, lo, hi);
+			ImGui::SliderFloat("Radius", &radius, 0.0f, 0.5f * (hi - lo));
+		}
 
+		if (ImGui::ImageButton("sculpt_add", ToImTex(icon_tex_id[3]), ImVec2(84, 84), ImVec2(0, 1), ImVec2(1, 0)) && volume != nullptr)
+		{
+			volume->sculptSphere(DgPos(center[0], center[1], center[2]), radius, true);
 		}
 		ImGui::SameLine();
-		if (ImGui::ImageButton("sculpt_remove", ToImTex(icon_tex_id[4]), ImVec2(84, 84), ImVec2(0, 1), ImVec2(1, 0)))
+		if (ImGui::ImageButton("sculpt_remove", ToImTex(icon_tex_id[4]), ImVec2(84, 84), ImVec2(0, 1), ImVec2(1, 0)) && volume != nullptr)
 		{
-
+			volume->sculptSphere(DgPos(center[0], center[1], center[2]), radius, false);
 		}
 	}
 
@@ -6,7 +6,7 @@ bool show_window_scene_layer = true;
 
 void ShowWindowSceneLayer(bool* p_open)
 {
-	//  ÷(window flag) Ѵ.
+	// 윈도우 플래그(window flag)를 설정한다.
 	static bool no_titlebar = false;
 	static bool no_scrollbar = false;
 	static bool no_menu = true;
@@ -34,7 +34,7 @@ void ShowWindowSceneLayer(bool* p_open)
 	if (unsaved_document)   window_flags |= ImGuiWindowFlags_UnsavedDocument;
 	if (no_close)           p_open = NULL; // Don't pass our bool* to Begin
 
-	// SceneLayer 츦 ϰ, collapsed ¶ ٷ Ѵ.
+	// SceneLayer 윈도우를 생성하고, collapsed된 상태라면 바로 리턴한다.
 	if (!ImGui::Begin("SceneLayer", p_open, window_flags))
 	{
 		ImGui::End();
@@ -46,20 +46,20 @@ void ShowWindowSceneLayer(bool* p_open)
 	//{
 	//	int node_clicked = -1;
 
-	//	// ޽ Ѵ.
+	//	// 메쉬를 선택한다.
 	//	if (node_clicked != -1)	{
 	//		
 	//	}
 	//	ImGui::TreePop();
 
-	//	//Context ˾ ޴ Ѵ.
+	//	//Context 팝업 메뉴를 생성한다.
 	//	if () {
 	//		if (ImGui::BeginPopupContextWindow())
 	//		{
 	//			//MenuFile();
 	//			if (ImGui::MenuItem("Delete"))
 	//			{
-	//				//
+	//				//삭제
 	//			}
 	//			ImGui::EndPopup();
 	//		}
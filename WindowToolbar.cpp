@@ -6,7 +6,7 @@ static inline ImTextureID ToImTex(GLuint tex) {
 	return (ImTextureID)(uintptr_t)tex;
 }
 
-// ؽó δ
+// 텍스처 로더
 static GLuint LoadTexture2D(const char* file) {
 	int w, h, ch;
 	stbi_set_flip_vertically_on_load(true);
@@ -32,8 +32,28 @@ static GLuint LoadTexture2D(const char* file) {
 bool show_window_tool_bar = true;
 void CreateMesh();
 
+// Shift를 누른 채 도구 버튼을 클릭하면 프리미티브 메쉬의 인스턴스를 바닥 격자에 배치한다.
+static bool PlaceInstance(const char* fname) {
+	if (!ImGui::GetIO().KeyShift)
+		return false;
+
+	static int numPlaced = 0;
+	float x = (float)(numPlaced % 8) * 2.5f - 8.75f;
+	float z = (float)(numPlaced / 8 % 8) * 2.5f - 8.75f;
+	glm::mat4 mat = glm::translate(glm::mat4(1.0f), glm::vec3(x, 1.0f, z));
+	if (DgScene::instance().addMeshInstance(fname, mat) != nullptr)
+		numPlaced++;
+	return true;
+}
+
+// 인스턴스를 배치할 수 있는 도구 버튼(직전 항목)에 Shift 클릭 동작을 알려주는 툴팁을 표시한다.
+static void InstanceTooltip(const char* name) {
+	if (ImGui::IsItemHovered())
+		ImGui::SetTooltip("%s: click to bake an SDF volume\nShift+click to place a mesh instance on the ground grid", name);
+}
+
 void ShowWindowToolBar(bool* p_open) {
-	//  ÷(window flag) Ѵ.
+	// 윈도우 플래그(window flag)를 설정한다.
 	static bool no_titlebar = false;
 	static bool no_scrollbar = false;
 	static bool no_menu = true;
@@ -61,7 +81,7 @@ void ShowWindowToolBar(bool* p_open) {
 	if (unsaved_document)   window_flags |= ImGuiWindowFlags_UnsavedDocument;
 	if (no_close)           p_open = NULL; // Don't pass our bool* to Begin
 
-	// Ӽ 츦 ϰ, collapsed ¶ ٷ Ѵ.
+	// 속성 윈도우를 생성하고, collapsed된 상태라면 바로 리턴한다.
 	if (!ImGui::Begin("ToolBar", p_open, window_flags))
 	{
 		ImGui::End();
@@ -101,7 +121,7 @@ void CreateMesh() {
 	}
 	ImGui::SameLine();
 
-	if (ImGui::ImageButton("Sphere", ToImTex(icon_tex_id[1]), ImVec2(30, 30), ImVec2(0, 1), ImVec2(1, 0)))
+	if (ImGui::ImageButton("Sphere", ToImTex(icon_tex_id[1]), ImVec2(30, 30), ImVec2(0, 1), ImVec2(1, 0)) && !PlaceInstance(".\\res\\object\\sphere.obj"))
 	{
 		DgVolume* volume = new DgVolume();
 		volume->mMesh = import_mesh_obj(".\\res\\object\\sphere.obj");
@@ -112,9 +132,10 @@ void CreateMesh() {
 		DgScene::instance().addSDFVolume(volume);
 		DgScene::instance().createSDF(*volume);
 	}
+	InstanceTooltip("Sphere");
 	ImGui::SameLine();
 
-	if (ImGui::ImageButton("Box", ToImTex(icon_tex_id[2]), ImVec2(30, 30), ImVec2(0, 1), ImVec2(1, 0)))
+	if (ImGui::ImageButton("Box", ToImTex(icon_tex_id[2]), ImVec2(30, 30), ImVec2(0, 1), ImVec2(1, 0)) && !PlaceInstance(".\\res\\object\\box.obj"))
 	{
 		DgVolume* volume = new DgVolume();
 		volume->mMesh = import_mesh_obj(".\\res\\object\\box.obj");
@@ -122,6 +143,7 @@ void CreateMesh() {
 		volume->setGridSpace(*volume->mMesh, 0.5);
 		volume->computeSDF();
 	}
+	InstanceTooltip("Box");
 	ImGui::SameLine();
 
 	if (ImGui::ImageButton("Torus", ToImTex(icon_tex_id[3]), ImVec2(30, 30), ImVec2(0, 1), ImVec2(1, 0)))
@@ -166,7 +188,7 @@ void CreateMesh() {
 	}
 	ImGui::SameLine();
 
-	if (ImGui::ImageButton("bunny", ToImTex(icon_tex_id[10]), ImVec2(30, 30), ImVec2(0, 1), ImVec2(1, 0)))
+	if (ImGui::ImageButton("bunny", ToImTex(icon_tex_id[10]), ImVec2(30, 30), ImVec2(0, 1), ImVec2(1, 0)) && !PlaceInstance(".\\res\\object\\bunny.obj"))
 	{
 		DgVolume* volume = new DgVolume();
 		volume->mMesh = import_mesh_obj(".\\res\\object\\bunny.obj");
@@ -174,5 +196,6 @@ void CreateMesh() {
 		volume->setGridSpace(*volume->mMesh, 0.5);
 		volume->computeSDF();
 	}
+	InstanceTooltip("Bunny");
 	ImGui::SameLine();
 }
@@ -3,8 +3,18 @@
 layout(location = 0) in vec3 aPos;
 
 uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
+layout(std140) uniform CameraBlock
+{
+    mat4 uView;         // 관측 변환 행렬
+    mat4 uProjection;   // 투영 변환 행렬
+    mat4 uInvView;      // 관측 변환의 역행렬
+    mat4 uInvProj;      // 투영 변환의 역행렬
+    vec3 uViewPos;      // 카메라 위치 (월드 공간)
+    float uTime;        // 시간
+    vec3 uLightPos;     // 광원 위치 (월드 공간)
+    vec3 uLightColor;   // 광원 색
+    vec2 uResolution;   // 화면 해상도
+};
 
 void main()
 {
@@ -3,9 +3,18 @@
 in vec3 FragPos;
 in vec3 Normal;
 
-uniform vec3 uViewPos;
-uniform vec3 uLightPos;
-uniform vec3 uLightColor;
+layout(std140) uniform CameraBlock
+{
+    mat4 uView;         // 관측 변환 행렬
+    mat4 uProjection;   // 투영 변환 행렬
+    mat4 uInvView;      // 관측 변환의 역행렬
+    mat4 uInvProj;      // 투영 변환의 역행렬
+    vec3 uViewPos;      // 카메라 위치 (월드 공간)
+    float uTime;        // 시간
+    vec3 uLightPos;     // 광원 위치 (월드 공간)
+    vec3 uLightColor;   // 광원 색
+    vec2 uResolution;   // 화면 해상도
+};
 
 uniform vec3 uKa;
 uniform vec3 uKd;
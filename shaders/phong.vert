@@ -2,17 +2,30 @@
 
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aNormal;
+layout(location = 3) in mat4 aInstModel;   // 인스턴스별 모델링 변환(location 3~6)
+layout(location = 7) in mat3 aInstNormal;  // 인스턴스별 법선 변환(CPU에서 계산한 역전치, location 7~9)
 
 uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
+layout(std140) uniform CameraBlock
+{
+    mat4 uView;         // 관측 변환 행렬
+    mat4 uProjection;   // 투영 변환 행렬
+    mat4 uInvView;      // 관측 변환의 역행렬
+    mat4 uInvProj;      // 투영 변환의 역행렬
+    vec3 uViewPos;      // 카메라 위치 (월드 공간)
+    float uTime;        // 시간
+    vec3 uLightPos;     // 광원 위치 (월드 공간)
+    vec3 uLightColor;   // 광원 색
+    vec2 uResolution;   // 화면 해상도
+};
 
 out vec3 FragPos;
 out vec3 Normal;
 
 void main()
 {
-    FragPos = vec3(uModel * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(uModel))) * aNormal;
+    mat4 model = uModel * aInstModel;
+    FragPos = vec3(model * vec4(aPos, 1.0));
+    Normal = mat3(uModel) * (aInstNormal * aNormal);   // uModel은 강체 변환
     gl_Position = uProjection * uView * vec4(FragPos, 1.0);
 }
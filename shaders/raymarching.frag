@@ -1,126 +1,242 @@
 #version 330 core
 
-out vec4 outColor; // ׸Ʈ 
+out vec4 outColor; //최종 프래그먼트 색상
+
+//=========================================== SDF 아틀라스 유니폼 ===============================================
+uniform sampler3D uSDFAtlas;        // 모든 볼륨을 z 방향으로 쌓은 SDF 아틀라스
+uniform sampler3D uMacroAtlas;      // 매크로 셀별 최소 부호거리 아틀라스
+uniform float uMacroSize;           // 매크로 셀 한 변의 샘플 간격 개수
+uniform usampler2D uTileMask;       // 화면 타일별로 겹치는 볼륨 비트 마스크
+uniform int uTileSize;              // 타일 한 변의 픽셀 수
+uniform int uSDFMaxLod;             // 보수적 부호거리 피라미드의 최대 밉 레벨
+uniform int uDebugSteps;            // 1: 레이마칭 스텝 수를 색으로 출력
+
+const int MAX_SDF_VOLUMES = 32;
+
+struct SDFVolume
+{
+    mat4 invModel;      // 월드 좌표 → 볼륨 격자 공간 변환
+    vec4 boundsMin;     // xyz: 격자 공간 최소점, w: 격자 공간 거리 → 월드 거리 배율
+    vec4 boundsMax;     // xyz: 격자 공간 최대점
+    vec4 atlasOffset;   // xyz: 아틀라스 안의 시작 텍셀
+    vec4 dim;           // xyz: 볼륨 해상도, w: 텍스처 값 → 부호거리 배율(양자화된 볼륨의 대역 거리)
+    vec4 macroOffset;   // xyz: 매크로 아틀라스 안의 시작 셀
+};
 
-//=========================================== SDF   ===============================================
-uniform sampler3D uSDFVolume;
-uniform vec3 uVolumeMin;
-uniform vec3 uVolumeMax;
+layout(std140) uniform SDFVolumeBlock
+{
+    SDFVolume uVolumes[MAX_SDF_VOLUMES];
+    int uNumVolumes;
+};
 
 
-//===========================================ī޶ ==============================================
+//===========================================카메라 조작==============================================
 
-uniform mat4 uView, uProj, uInvView, uInvProj; //ī޶ /   
-uniform vec2 uResolution; //ȭ ػ
+layout(std140) uniform CameraBlock
+{
+    mat4 uView;         // 관측 변환 행렬
+    mat4 uProjection;   // 투영 변환 행렬
+    mat4 uInvView;      // 관측 변환의 역행렬
+    mat4 uInvProj;      // 투영 변환의 역행렬
+    vec3 uViewPos;      // 카메라 위치 (월드 공간)
+    float uTime;        // 시간
+    vec3 uLightPos;     // 광원 위치 (월드 공간)
+    vec3 uLightColor;   // 광원 색
+    vec2 uResolution;   // 화면 해상도
+};
 
-float mapSDFd(vec3 p) {
-    vec3 volumeRange = uVolumeMax - uVolumeMin;
-    vec3 uvw = (p - uVolumeMin) / volumeRange;
-    
-    if (any(lessThan(uvw, vec3(0.0))) || any(greaterThan(uvw, vec3(1.0)))) {
-        return 500.0;
-    }
-    return texture(uSDFVolume, uvw).r; 
+// 볼륨 v의 격자 공간 점 p의 밉 레벨 lod에서의 부호거리(격자 공간 단위, 높은 레벨일수록 작거나 같은 보수적인 값)
+float mapSDFd(int v, vec3 p, float lod) {
+    vec3 bmin = uVolumes[v].boundsMin.xyz;
+    vec3 bmax = uVolumes[v].boundsMax.xyz;
+    vec3 dim = uVolumes[v].dim.xyz;
+    vec3 uvw = (clamp(p, bmin, bmax) - bmin) / (bmax - bmin);
+
+    // 이웃 볼륨의 텍셀과 보간되지 않도록 볼륨의 레벨 lod 텍셀 중심 범위로 제한한다(레벨 0 텍셀 단위).
+    float texelScale = exp2(lod);
+    vec3 dimLod = ceil(dim / texelScale);
+    vec3 x = clamp(uvw * dim, vec3(0.5 * texelScale), (dimLod - 0.5) * texelScale) + uVolumes[v].atlasOffset.xyz;
+    return textureLod(uSDFAtlas, x / vec3(textureSize(uSDFAtlas, 0)), lod).r * uVolumes[v].dim.w;
 }
 
 vec3 mapColor(vec3 p) {
     return vec3(0.1, 0.4, 0.8);
 }
 
-// ȭ ǥ     
+// 화면 좌표에서 월드 공간의 광선 방향 얻기
 vec3 getRayDir(vec2 fragCoord){
-    // ȭ ǥ (fragCoord) NDC (Normalized Device Coordinates) [-1, 1] ȯ
+    // 화면 좌표 (fragCoord)를 NDC (Normalized Device Coordinates) [-1, 1]로 변환
     vec2 ndc = (fragCoord / uResolution) * 2.0 - 1.0; 
     
-    // NDC Ŭ  ǥ ȯ (z=-1, w=1)
+    // NDC를 클립 공간 좌표로 변환 (z=-1, w=1)
     vec4 clip = vec4(ndc, -1.0, 1.0);
     
-    // Ŭ ǥ Eye(View)  ǥ ȯ (  )
+    // 클립 좌표를 Eye(View) 공간 좌표로 변환 (역투영 행렬 사용)
     vec4 eye = uInvProj * clip;
     
-    // Ray Direction ϱ  z=-1, w=0 (Ѵ ) 
+    // Ray Direction을 계산하기 위해 z=-1, w=0 (무한대의 점)으로 설정
     eye = vec4(eye.xy, -1.0, 0.0);
     
-    // Eye  World  ȯϰ ȭ
+    // Eye 공간에서 World 공간으로 변환하고 정규화
     return normalize((uInvView * eye).xyz);
 }
 
-// ī޶ ġ 
+// 카메라 위치 얻기
 vec3 getCamPos(){ return (uInvView * vec4(0,0,0,1)).xyz; }
 
-//  
-vec3 calcNormal(vec3 p){
+// 법선 계산(격자 공간)
+vec3 calcNormal(int v, vec3 p, float lod){
     const float e = 1.5e-3;
     vec2 k = vec2(1,-1);
     return normalize(
-         k.xyy * mapSDFd(p + k.xyy*e) +
-        k.yyx * mapSDFd(p + k.yyx*e) +
-        k.yxy * mapSDFd(p + k.yxy*e) +
-        k.xxx * mapSDFd(p + k.xxx*e)
+         k.xyy * mapSDFd(v, p + k.xyy*e, lod) +
+        k.yyx * mapSDFd(v, p + k.yyx*e, lod) +
+        k.yxy * mapSDFd(v, p + k.yxy*e, lod) +
+        k.xxx * mapSDFd(v, p + k.xxx*e, lod)
     );
 }
 
+//=========================================빈 공간 건너뛰기=============================================
 
+// 광선과 AABB의 교차 구간 [t0, t1]을 구한다 (교차하지 않으면 t0 > t1)
+vec2 intersectBox(vec3 rayOrigin, vec3 rayDir, vec3 bmin, vec3 bmax){
+    vec3 invDir = 1.0 / rayDir;
+    vec3 tA = (bmin - rayOrigin) * invDir;
+    vec3 tB = (bmax - rayOrigin) * invDir;
+    vec3 tMin = min(tA, tB);
+    vec3 tMax = max(tA, tB);
+    return vec2(max(max(tMin.x, tMin.y), tMin.z), min(min(tMax.x, tMax.y), tMax.z));
+}
 
+// 점 p가 속한 매크로 셀이 비어 있으면(셀의 최소 거리 > eps) 광선이 셀을 빠져나가는 거리를 반환, 아니면 t를 반환
+float skipEmptyCell(int v, vec3 p, vec3 rayDir, float t, float eps){
+    vec3 bmin = uVolumes[v].boundsMin.xyz;
+    vec3 bmax = uVolumes[v].boundsMax.xyz;
+    vec3 dim = uVolumes[v].dim.xyz;
+    vec3 x = (p - bmin) / (bmax - bmin) * dim - 0.5;               // 텍셀 중심 기준 샘플 좌표
+    if (any(lessThan(x, vec3(0.0))) || any(greaterThan(x, dim - 1.0)))
+        return t;                                                   // 보간 경계 밖은 건너뛰지 않음
+
+    vec3 macroDim = max(vec3(1.0), ceil((dim - 1.0) / uMacroSize));
+    ivec3 cell = ivec3(min(floor(x / uMacroSize), macroDim - 1.0));
+    if (texelFetch(uMacroAtlas, cell + ivec3(uVolumes[v].macroOffset.xyz), 0).r * uVolumes[v].boundsMin.w <= eps)
+        return t;                                                   // 표면이 있을 수 있는 셀
+
+    // 셀 경계 [cell * B, (cell + 1) * B]를 격자 공간 좌표로 변환하여 광선의 출구 거리를 계산
+    vec3 texelSize = (bmax - bmin) / dim;
+    vec3 cellMin = bmin + (vec3(cell) * uMacroSize + 0.5) * texelSize;
+    vec3 cellMax = cellMin + uMacroSize * texelSize;
+    vec3 tExit = max((cellMin - p) / rayDir, (cellMax - p) / rayDir);
+    return t + max(min(min(tExit.x, tExit.y), tExit.z), 0.0) + 1e-4;
+}
 
-
-//===========================================≠Ī================================================
+//============================================레이마칭================================================
 
 struct Hit{ 
-    bool hit;                                           // Ʈ 
-    vec3 hitPoint;                                      // Ʈ ġ 
-    vec3 n;                                             // Ʈ ġ 
-    vec3 color;                                         // Ʈ ġ 
+    bool hit;                                           // 히트 여부
+    float t;                                            // 히트 거리
+    vec3 hitPoint;                                      // 히트 위치 
+    vec3 n;                                             // 히트 위치의 법선
+    vec3 color;                                         // 히트 위치의 색상
 };
 
-Hit raymarch(vec3 rayOrigin, vec3 rayDir){                // rayOrigin:  , rd:  
-    float t= 0.0;                                         // t:  Ÿ  
-    const float EPS = 1e-3;                               // Ʈ  
-    const float MIN_STEP = 1e-4;                          // ּ  ũ
-
-    for(int i = 0; i < 256; i++) {
-        vec3 p = rayOrigin + rayDir * t;
-        float d = mapSDFd(p);
-
-        if (d < EPS) {                                    // Ʈ ߻
-            vec3 n = calcNormal(p);
-            vec3 c = mapColor(p);
-            return Hit(true, p, n, c);
+const int MAX_STEPS = 256;                                // 최대 스텝 수
+
+// 볼륨 v를 [0, tMax] 구간에서 레이마칭하여 더 가까운 히트가 있으면 hit를 갱신하고 사용한 스텝 수를 반환
+// pixelAngle: 거리 1에서 픽셀 하나가 차지하는 월드 크기
+int raymarch(int v, vec3 rayOrigin, vec3 rayDir, float tMax, float pixelAngle, inout Hit hit){
+    const float EPS = 1e-3;                               // 히트 허용 오차
+    const float MIN_STEP = 1e-4;                          // 최소 스텝 크기
+
+    // 광선을 볼륨의 격자 공간으로 변환한다(방향을 정규화하지 않으므로 t는 월드 거리와 같음).
+    vec3 ro = (uVolumes[v].invModel * vec4(rayOrigin, 1.0)).xyz;
+    vec3 rd = (uVolumes[v].invModel * vec4(rayDir, 0.0)).xyz;
+    float scale = uVolumes[v].boundsMin.w;
+    float voxel = min(min((uVolumes[v].boundsMax.x - uVolumes[v].boundsMin.x) / uVolumes[v].dim.x,
+                          (uVolumes[v].boundsMax.y - uVolumes[v].boundsMin.y) / uVolumes[v].dim.y),
+                          (uVolumes[v].boundsMax.z - uVolumes[v].boundsMin.z) / uVolumes[v].dim.z) * scale;   // 월드 공간 복셀 크기
+
+    vec2 tBox = intersectBox(ro, rd, uVolumes[v].boundsMin.xyz, uVolumes[v].boundsMax.xyz);
+    tBox.y = min(tBox.y, tMax);                           // 이미 찾은 히트보다 먼 구간은 행진하지 않음
+    if (tBox.x > tBox.y || tBox.y < 0.0)
+        return 0;
+
+    float t = max(tBox.x, 0.0);                           // t: 광선 거리 누적 변수
+    float dPrev = 0.0;                                    // 이전 스텝의 거리
+    for(int i = 0; i < MAX_STEPS; i++) {
+        vec3 p = ro + rd * t;
+
+        // 밉 레벨 선택: 픽셀 크기가 복셀보다 크거나, 표면에서 충분히 멀어 큰 스텝을 밟는 동안은 거친 레벨을 사용
+        // (모든 레벨이 거리를 과대평가하지 않으므로 스텝은 항상 안전하고, 히트 위치의 오차는 픽셀 크기 이내)
+        float lodPixel = log2(max(t * pixelAngle, 1e-8) / voxel);
+        float lodStep = log2(max(dPrev, 1e-8) / (4.0 * voxel));
+        float lod = clamp(floor(max(lodPixel, lodStep)), 0.0, float(uSDFMaxLod));
+
+        float d = mapSDFd(v, p, lod) * scale;
+
+        if (d < EPS) {                                    // 히트 발생
+            vec3 n = calcNormal(v, p, lod);
+            hit = Hit(true, t, rayOrigin + rayDir * t,
+                      normalize(transpose(mat3(uVolumes[v].invModel)) * n), mapColor(p));
+            return i + 1;
         }
 
-        t += max(d, MIN_STEP);
+        dPrev = d;
+        t = max(t + max(d, MIN_STEP), skipEmptyCell(v, p, rd, t, EPS));
 
-        if(t > 500.0) break;                              // ִ Ÿ ʰ  
+        if(t > tBox.y) return i + 1;                      // 볼륨을 빠져나가면 종료
     }
-    return Hit(false, vec3(0.0), vec3(0.0), vec3(0.0));
+    return MAX_STEPS;
+}
+
+// 스텝 수 비율 [0, 1]을 파랑-초록-빨강 색으로 변환
+vec3 heatColor(float x){
+    return clamp(vec3(2.0 * x - 0.5, 1.5 - abs(4.0 * x - 2.0), 1.5 - 2.0 * x), 0.0, 1.0);
 }
+
 float depthFromWorld(vec3 worldPos) {
-    //  ǥ Ŭ  ǥ ȯ: ClipPos = uProj * uView * WorldPos
-    //    (uView, uProj  DgScene.cpp ޵˴ϴ.)
-    vec4 clipPos = uProj * uView * vec4(worldPos, 1.0);
+    // 월드 좌표를 클립 공간 좌표로 변환: ClipPos = uProjection * uView * WorldPos
+    //    (uView, uProjection 유니폼은 DgScene.cpp에서 전달됩니다.)
+    vec4 clipPos = uProjection * uView * vec4(worldPos, 1.0);
     
-    // Ŭ ǥ NDC (Normalized Device Coordinates) ȯ: z/w
-    //    NDC z  [-1, 1] Դϴ.
+    // 클립 좌표를 NDC (Normalized Device Coordinates)로 변환: z/w
+    //    NDC z 값은 [-1, 1] 범위입니다.
     float ndcZ = clipPos.z / clipPos.w;
     
-    // NDC z  [0, 1]     ȯϿ ȯ
+    // NDC z 값을 [0, 1] 범위의 최종 깊이 값으로 변환하여 반환
     return (ndcZ * 0.5) + 0.5;
 }
 
-//========================================= Լ====================================================
+//=========================================메인 함수====================================================
 
 void main(){
     vec3 rayOrigin = getCamPos();
     vec3 rayDir = getRayDir(gl_FragCoord.xy);
     
-    Hit hit = raymarch(rayOrigin, rayDir);                          // ̸Ī Ʈ ˻
+    // 현재 타일과 겹치는 볼륨만 레이마칭한다.
+    uint mask = texelFetch(uTileMask, ivec2(gl_FragCoord.xy) / uTileSize, 0).r;
+    if (mask == 0u) { discard; }                                    // 볼륨이 없는 타일
+
+    float pixelAngle = 2.0 / (uProjection[1][1] * uResolution.y);  // 거리 1에서의 픽셀 크기
+    Hit hit = Hit(false, 500.0, vec3(0.0), vec3(0.0), vec3(0.0));   // 최대 거리 500
+    int steps = 0;
+    for (int v = 0; v < uNumVolumes; v++) {
+        if ((mask & (1u << uint(v))) != 0u)
+            steps += raymarch(v, rayOrigin, rayDir, hit.t, pixelAngle, hit);    // 가장 가까운 히트를 유지
+    }
+
+    if (uDebugSteps != 0) {                                         // 스텝 수 히트맵 출력
+        gl_FragDepth = hit.hit ? depthFromWorld(hit.hitPoint) : 0.0;
+        outColor = vec4(heatColor(float(steps) / float(MAX_STEPS)), 1.0);
+        return;
+    }
 
-    if(!hit.hit) { discard; }                                       // Ʈ  ׸Ʈ 
+    if(!hit.hit) { discard; }                                       // 히트 없으면 프래그먼트 버림
 
-    gl_FragDepth = depthFromWorld(hit.hitPoint);                    //  ۿ ǥ  
+    gl_FragDepth = depthFromWorld(hit.hitPoint);                    // 깊이 버퍼에 표면 깊이 기록
     
-    vec3 V = normalize(rayOrigin - hit.hitPoint);                   //  ̵( surf.color )
-    vec3 L = V;                                                     //   (  )
+    vec3 V = normalize(rayOrigin - hit.hitPoint);                   // 간단 셰이딩(색은 surf.color 사용)
+    vec3 L = V;                                                     // 광원 방향 (뷰어 방향과 동일)
     vec3 H = normalize(L+V);  
 
     float diff = max(dot(hit.n, L), 0.0);
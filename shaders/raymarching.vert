@@ -0,0 +1,8 @@
+#version 330 core
+
+// 정점 버퍼 없이 gl_VertexID로 화면 전체를 덮는 삼각형을 만든다.
+void main()
+{
+    vec2 pos = vec2((gl_VertexID == 1) ? 3.0 : -1.0, (gl_VertexID == 2) ? 3.0 : -1.0);
+    gl_Position = vec4(pos, 0.0, 1.0);             // 깊이는 프래그먼트 쉐이더에서 기록
+}